@@ -0,0 +1,97 @@
+/* bench/bench_lru.c
+ * LRU Victim 선정 비용 비교: 기존 선형 탐색 vs lru_list (swap.c / tlb.c 에서 사용)
+ * 프레임 수를 늘려가며 eviction 1회당 평균 시간(ns)을 출력
+ * 두 방식이 매번 같은 Victim 을 고르는지도 함께 검증함
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "lru_list.h"
+
+static uint64_t rng_state = 0x9E3779B97F4A7C15ULL;
+
+static inline uint64_t xorshift64() {
+    uint64_t x = rng_state;
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    return rng_state = x;
+}
+
+static double now_sec() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// 기존 swap_out() 의 LRU 탐색과 동일
+static int scan_victim(const uint64_t *last_access, int n) {
+    uint64_t min_time = UINT64_MAX;
+    int victim = -1;
+    for (int i = 0; i < n; i++) {
+        if (last_access[i] < min_time) {
+            min_time = last_access[i];
+            victim = i;
+        }
+    }
+    return victim;
+}
+
+// 접근 accesses_per_evict 회마다 eviction 1회 (재할당 후 바로 접근)
+static double run(int n, int evictions, int accesses_per_evict, bool use_list, int *checksum) {
+    uint64_t *last_access = calloc(n, sizeof(uint64_t));
+    LRUList list;
+    lru_init(&list, n);
+
+    uint64_t t = 0;
+    for (int i = 0; i < n; i++) {
+        last_access[i] = ++t;
+        lru_push_tail(&list, i);
+    }
+
+    rng_state = 0x9E3779B97F4A7C15ULL;
+    int sum = 0;
+    double start = now_sec();
+    for (int e = 0; e < evictions; e++) {
+        for (int a = 0; a < accesses_per_evict; a++) {
+            int pfn = (int)(xorshift64() % n);
+            last_access[pfn] = ++t;
+            if (use_list) lru_insert_sorted(&list, pfn, last_access);
+        }
+
+        int victim = use_list ? lru_head(&list) : scan_victim(last_access, n);
+        sum = sum * 31 + victim;
+
+        // 재할당: 이전 시간을 가진 채 리스트에 남아 있다가 곧바로 접근됨
+        last_access[victim] = ++t;
+        if (use_list) lru_insert_sorted(&list, victim, last_access);
+    }
+    double elapsed = now_sec() - start;
+
+    *checksum = sum;
+    lru_destroy(&list);
+    free(last_access);
+    return elapsed / evictions * 1e9;
+}
+
+int main(int argc, char *argv[]) {
+    int evictions = argc > 1 ? atoi(argv[1]) : 20000;
+    const int sizes[] = { 128, 1024, 8192, 65536, 524288 };
+    const int n_sizes = sizeof(sizes) / sizeof(sizes[0]);
+
+    printf("%10s %16s %16s %8s\n", "frames", "scan ns/evict", "list ns/evict", "match");
+    for (int i = 0; i < n_sizes; i++) {
+        int sum_scan, sum_list;
+        // 선형 탐색은 큰 N 에서 너무 느리므로 횟수를 줄임 (평균값은 그대로 비교 가능)
+        int scan_evictions = evictions;
+        if ((long)sizes[i] * evictions > 400000000L) scan_evictions = 400000000 / sizes[i];
+
+        double scan = run(sizes[i], scan_evictions, 4, false, &sum_scan);
+        double list = run(sizes[i], scan_evictions, 4, true, &sum_list);
+        printf("%10d %16.1f %16.1f %8s\n", sizes[i], scan, list,
+               sum_scan == sum_list ? "yes" : "NO");
+    }
+    return 0;
+}
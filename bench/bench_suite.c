@@ -0,0 +1,561 @@
+/* bench/bench_suite.c
+ * make bench 의 본체: 핵심 연산 마이크로벤치마크 + 트레이스 전체 실행 (end-to-end)
+ *   search_tlb / update_tlb           TLB 정책 (RR, LRU) x 구성 (L1 만, L1 + L2)
+ *   walk_page_table                   x86-64 4단계, PWC 없음 / 있음
+ *   update_page_table                 흩어진 VA 에 새 매핑 (테이블 프레임 할당 포함)
+ *   allocate_free_frame / swap_out    프레임 교체 정책 전부
+ *   e2e                               input_* (12bit, golden 과 같은 구성) + 큰 합성 트레이스 (x86-64)
+ * 각 항목은 워밍업 1회 뒤 -r 회 반복해서 연산 1회당 ns 의 중앙값 / 최소 / 최대 / MAD 를 냄
+ * 준비 (매핑 채우기, 메모리 채우기 등) 는 시간에서 뺌. 로그는 끔
+ * -o 로 JSON 을 쓰고, -b 로 준 기준 JSON 과 중앙값을 비교해 -t % 보다 느려진 항목이 있으면 종료 코드 2
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <unistd.h> // getopt
+#include <time.h>
+
+#include "sim.h"
+
+#define MAX_RESULTS 256
+#define NAME_LEN 96
+
+static uint64_t rng_state = 0x9E3779B97F4A7C15ULL;
+
+static inline uint64_t xorshift64() {
+    uint64_t x = rng_state;
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    return rng_state = x;
+}
+
+static double now_sec() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// 벤치마크 한 항목 (run 은 1회 실행: 준비 후 잰 시간(초)을 돌려주고 *ops 에 연산 수)
+typedef struct BenchCase BenchCase;
+struct BenchCase {
+    char name[NAME_LEN];
+    double (*run)(const BenchCase *c, uint64_t *ops);
+    Policy policy;
+    const char *geometry;
+    const char *trace;    // [e2e] 파일 또는 gen:<spec>
+    int variant;          // 항목별 선택 (hit / miss 등)
+};
+
+typedef struct {
+    char name[NAME_LEN];
+    uint64_t ops;
+    double median, min, max, mad; // ns / 연산
+} BenchResult;
+
+static double scale = 1.0;       // -s: 반복 횟수 / 트레이스 길이 배율
+static double timer_cost;        // now_sec() 두 번의 비용 (호출 하나씩 재는 항목에서 뺌)
+static volatile uint64_t sink;   // 결과를 버리지 않도록
+
+static uint64_t scaled(uint64_t n) {
+    uint64_t v = (uint64_t)(n * scale);
+    return v ? v : 1;
+}
+
+static SimContext *make_ctx(const char *spec, Policy policy) {
+    Geometry geo;
+    if (geometry_parse(&geo, spec) != 0) exit(EXIT_FAILURE);
+    SimContext *ctx = sim_create(&geo, policy);
+    if (!ctx) {
+        perror("sim_create");
+        exit(EXIT_FAILURE);
+    }
+    // 물리 메모리 (calloc) 를 미리 건드려 측정 중에 호스트 Page Fault 가 섞이지 않게
+    memset(ctx->mem.physical_memory, 0, (size_t)ctx->geo.num_frames * ctx->geo.page_size);
+    return ctx;
+}
+
+// --- search_tlb: 키 0 ~ size-1 을 채운 뒤 Hit (variant 0) 또는 Miss (variant 1) 만 조회 ---
+static double run_search_tlb(const BenchCase *c, uint64_t *ops) {
+    SimContext *ctx = make_ctx(c->geometry, c->policy);
+    int entries = ctx->geo.tlb_size + ctx->geo.l2_tlb_size;
+    for (int i = 0; i < entries; i++) update_tlb(ctx, (uint64_t)i, i);
+
+    uint64_t n = scaled(4000000);
+    uint64_t *q = malloc(sizeof(uint64_t) * 65536);
+    rng_state = 0x9E3779B97F4A7C15ULL;
+    for (int i = 0; i < 65536; i++) {
+        uint64_t r = xorshift64() % entries;
+        q[i] = c->variant ? r + entries : r;
+    }
+
+    uint64_t hits = 0;
+    double start = now_sec();
+    for (uint64_t i = 0; i < n; i++) hits += search_tlb(ctx, q[i & 65535]) != -1;
+    double elapsed = now_sec() - start;
+
+    sink += hits;
+    free(q);
+    sim_free(ctx);
+    *ops = n;
+    return elapsed;
+}
+
+// --- update_tlb: 가득 찬 TLB 에 새 키 삽입 (매번 Victim 교체) ---
+static double run_update_tlb(const BenchCase *c, uint64_t *ops) {
+    SimContext *ctx = make_ctx(c->geometry, c->policy);
+    int entries = ctx->geo.tlb_size + ctx->geo.l2_tlb_size;
+    for (int i = 0; i < entries; i++) update_tlb(ctx, (uint64_t)i, i);
+
+    uint64_t n = scaled(2000000);
+    double start = now_sec();
+    for (uint64_t i = 0; i < n; i++) {
+        ctx->time++; // LRU 시간이 흘러야 Victim 순서가 바뀜
+        ctx->tlb->clock++;
+        update_tlb(ctx, entries + i, (int)(i & 0xFFFF));
+    }
+    double elapsed = now_sec() - start;
+
+    sim_free(ctx);
+    *ops = n;
+    return elapsed;
+}
+
+// 4GB 안에 흩어진 서로 다른 페이지 n 개의 VA
+static uint64_t *scattered_vas(const Geometry *geo, uint64_t n) {
+    uint64_t *va = malloc(sizeof(uint64_t) * n);
+    uint64_t pages = (4ULL << 30) / geo->page_size;
+    uint8_t *used = calloc(pages / 8, 1);
+    rng_state = 0x9E3779B97F4A7C15ULL;
+    for (uint64_t i = 0; i < n; i++) {
+        uint64_t vpn;
+        do {
+            vpn = xorshift64() % pages;
+        } while (used[vpn / 8] & (1u << (vpn % 8)));
+        used[vpn / 8] |= (uint8_t)(1u << (vpn % 8));
+        va[i] = vpn * geo->page_size;
+    }
+    free(used);
+    return va;
+}
+
+// 데이터 프레임을 먼저 받아 두고 va 를 차례로 매핑 (timed 면 매핑 시간만 잼)
+static double map_pages(SimContext *ctx, const uint64_t *va, uint64_t n) {
+    int *pfn = malloc(sizeof(int) * n);
+    for (uint64_t i = 0; i < n; i++) {
+        pfn[i] = allocate_free_frame(ctx, ctx->proc.key_base | GET_FULL_VPN(&ctx->geo, va[i]), true);
+        if (pfn[i] < 0) {
+            fprintf(stderr, "bench: out of frames while mapping\n");
+            exit(EXIT_FAILURE);
+        }
+    }
+    double start = now_sec();
+    for (uint64_t i = 0; i < n; i++) update_page_table(ctx, va[i], pfn[i]);
+    double elapsed = now_sec() - start;
+    free(pfn);
+    return elapsed;
+}
+
+// --- update_page_table: 흩어진 새 페이지 매핑 (중간 테이블 할당 포함) ---
+static double run_update_page_table(const BenchCase *c, uint64_t *ops) {
+    SimContext *ctx = make_ctx(c->geometry, c->policy);
+    uint64_t n = scaled(32768);
+    uint64_t *va = scattered_vas(&ctx->geo, n);
+    double elapsed = map_pages(ctx, va, n);
+    free(va);
+    sim_free(ctx);
+    *ops = n;
+    return elapsed;
+}
+
+// --- walk_page_table: 매핑된 페이지를 무작위 순서로 Walk (모두 Hit) ---
+static double run_walk_page_table(const BenchCase *c, uint64_t *ops) {
+    SimContext *ctx = make_ctx(c->geometry, c->policy);
+    uint64_t mapped = 32768;
+    uint64_t *va = scattered_vas(&ctx->geo, mapped);
+    map_pages(ctx, va, mapped);
+
+    uint64_t n = scaled(2000000);
+    uint64_t *q = malloc(sizeof(uint64_t) * 65536);
+    for (int i = 0; i < 65536; i++) q[i] = va[xorshift64() % mapped];
+
+    uint64_t found = 0;
+    double start = now_sec();
+    for (uint64_t i = 0; i < n; i++) found += walk_page_table(ctx, q[i & 65535]).pfn != -1;
+    double elapsed = now_sec() - start;
+
+    sink += found;
+    free(q);
+    free(va);
+    sim_free(ctx);
+    *ops = n;
+    return elapsed;
+}
+
+// --- allocate_free_frame: 모두 채운 뒤 무작위 절반을 비우고 (시간 제외) 다시 할당 ---
+static double run_allocate_free_frame(const BenchCase *c, uint64_t *ops) {
+    SimContext *ctx = make_ctx(c->geometry, c->policy);
+    int frames = ctx->geo.num_frames;
+    int *pfn = malloc(sizeof(int) * frames);
+    int held = 0;
+    uint64_t key = 0;
+    for (int f; (f = allocate_free_frame(ctx, key, true)) != -1; key++) pfn[held++] = f;
+
+    uint64_t rounds = scaled(40), n = 0;
+    double elapsed = 0;
+    rng_state = 0x9E3779B97F4A7C15ULL;
+    for (uint64_t r = 0; r < rounds; r++) {
+        int half = held / 2;
+        for (int i = 0; i < half; i++) {
+            int j = i + (int)(xorshift64() % (uint64_t)(held - i));
+            int tmp = pfn[i];
+            pfn[i] = pfn[j];
+            pfn[j] = tmp;
+            free_frame(ctx, pfn[i]);
+        }
+        double start = now_sec();
+        for (int i = 0; i < half; i++) pfn[i] = allocate_free_frame(ctx, key++, true);
+        elapsed += now_sec() - start;
+        n += half;
+    }
+
+    free(pfn);
+    sim_free(ctx);
+    *ops = n;
+    return elapsed;
+}
+
+// [OPT] trace 의 next-use 인덱스 연결 (호출자가 free)
+static uint32_t *attach_future(SimContext *ctx, const Trace *t) {
+    if (!sim_uses_opt(&ctx->geo, ctx->policy)) return NULL;
+    uint32_t *next_use = build_next_use(&ctx->geo, t);
+    if (!next_use) exit(EXIT_FAILURE);
+    sim_set_future(ctx, next_use, t->count);
+    return next_use;
+}
+
+// --- swap_out: zipf 워크로드로 메모리를 채운 뒤, Victim 하나를 내보내고 (시간 측정)
+//     워크로드를 이어 실행해 그 빈 프레임이 다시 채워질 때까지 (시간 제외) 를 반복
+//     교체 정책 상태는 실제 실행과 같음 (reclaim_batch 1 의 Victim 은 재할당 전까지 정책에 남으므로 연달아 부르지 않음)
+static double run_swap_out(const BenchCase *c, uint64_t *ops) {
+    Trace t;
+    char spec[128];
+    snprintf(spec, sizeof(spec), "gen:zipf:s=0.9:pages=32K:page=4096:n=%llu", (unsigned long long)scaled(4000000));
+    if (trace_load(&t, spec) != 0) exit(EXIT_FAILURE);
+    SimContext *ctx = make_ctx(c->geometry, c->policy);
+    uint32_t *next_use = attach_future(ctx, &t);
+    const uint64_t *va = (const uint64_t *)t.records;
+
+    uint64_t rounds = scaled(100000), pos = 0, n = 0;
+    double elapsed = 0;
+    // 메모리가 찰 때까지 (첫 swap out) 실행
+    while (pos < t.count && ctx->stats.swap_outs == 0) translate_batch(ctx, va + pos++, NULL, 1);
+    while (pos < t.count && n < rounds) {
+        double start = now_sec();
+        swap_out(ctx);
+        elapsed += now_sec() - start - timer_cost;
+        n++;
+        // 다음 Page Fault 가 빈 프레임을 받을 때까지 이어 실행
+        uint64_t faults = ctx->stats.pt_misses + 1;
+        while (pos < t.count && ctx->stats.pt_misses < faults) translate_batch(ctx, va + pos++, NULL, 1);
+    }
+
+    free(next_use);
+    sim_free(ctx);
+    trace_close(&t);
+    *ops = n;
+    return elapsed;
+}
+
+// --- e2e: 트레이스 전체를 translate (준비 / OPT 인덱스는 제외) ---
+// 짧은 트레이스는 합쳐서 최소 scaled(200000) 접근이 될 때까지 새 인스턴스로 되풀이
+static double run_e2e(const BenchCase *c, uint64_t *ops) {
+    Trace t;
+    if (trace_load(&t, c->trace) != 0) exit(EXIT_FAILURE);
+    uint64_t want = scaled(200000), n = 0;
+    double elapsed = 0;
+    while (n < want) {
+        SimContext *ctx = make_ctx(c->geometry, c->policy);
+        uint32_t *next_use = attach_future(ctx, &t);
+        double start = now_sec();
+        int ret = sim_run_trace(ctx, &t);
+        elapsed += now_sec() - start;
+        n += ctx->stats.accesses;
+        free(next_use);
+        sim_free(ctx);
+        if (ret != 0 || t.count == 0) {
+            fprintf(stderr, "bench: %s stopped early\n", c->name);
+            break;
+        }
+    }
+    trace_close(&t);
+    *ops = n;
+    return elapsed;
+}
+
+// --- 항목 목록 ---
+static BenchCase cases[MAX_RESULTS];
+static int num_cases;
+
+__attribute__((format(printf, 5, 6)))
+static BenchCase *add_case(double (*run)(const BenchCase *, uint64_t *), Policy policy,
+                           const char *geometry, int variant, const char *fmt, ...) {
+    if (num_cases == MAX_RESULTS) {
+        fprintf(stderr, "bench: too many cases\n");
+        exit(EXIT_FAILURE);
+    }
+    BenchCase *c = &cases[num_cases++];
+    va_list ap;
+    va_start(ap, fmt);
+    vsnprintf(c->name, sizeof(c->name), fmt, ap);
+    va_end(ap);
+    c->run = run;
+    c->policy = policy;
+    c->geometry = geometry;
+    c->variant = variant;
+    return c;
+}
+
+static const char *input_traces[] = {
+    "input_1", "input_2", "input_uniform", "input_zipf_0.5", "input_zipf_1.0", "input_zipf_1.5"
+};
+
+// 큰 합성 트레이스: 128MB 메모리에 footprint 512MB (zipf) / 1GB (작업 집합이 옮겨 가는 phase)
+static const struct { const char *label; const char *spec; } synth_traces[] = {
+    { "zipf",  "gen:zipf:s=0.99:pages=128K:page=4096:n=1M" },
+    { "phase", "gen:phase:s=0.9:pages=256K:ws=16K:page=4096:n=1M" },
+};
+#define SYNTH_GEOMETRY "x86-64,mem=128M"
+
+static void build_cases(void) {
+    // TLB: 정책은 RR / LRU / OPT 중 TLB 가 쓰는 것 (CLOCK ~ ARC 는 TLB 에서 LRU)
+    static const char *tlb_geos[2][2] = {
+        { "l1=64",         "x86-64,tlb=64" },
+        { "l1=64+l2=1536", "x86-64,tlb=64,tlb_ways=4,l2tlb=1536,l2tlb_ways=12" },
+    };
+    const Policy tlb_policies[] = { POLICY_RR, POLICY_LRU };
+    for (int p = 0; p < 2; p++) {
+        for (int g = 0; g < 2; g++) {
+            const char *pn = policy_name(tlb_policies[p]);
+            add_case(run_search_tlb, tlb_policies[p], tlb_geos[g][1], 0, "search_tlb/%s/%s/hit", pn, tlb_geos[g][0]);
+            add_case(run_search_tlb, tlb_policies[p], tlb_geos[g][1], 1, "search_tlb/%s/%s/miss", pn, tlb_geos[g][0]);
+            add_case(run_update_tlb, tlb_policies[p], tlb_geos[g][1], 0, "update_tlb/%s/%s", pn, tlb_geos[g][0]);
+        }
+    }
+
+    add_case(run_walk_page_table, POLICY_LRU, "x86-64,mem=256M", 0, "walk_page_table/x86-64");
+    add_case(run_walk_page_table, POLICY_LRU, "x86-64,mem=256M,pwc=16", 0, "walk_page_table/x86-64,pwc=16");
+    add_case(run_update_page_table, POLICY_LRU, "x86-64,mem=256M", 0, "update_page_table/x86-64");
+
+    for (int p = 0; p < POLICY_COUNT; p++) {
+        add_case(run_allocate_free_frame, (Policy)p, "x86-64,mem=64M", 0, "allocate_free_frame/%s", policy_name(p));
+    }
+    for (int p = 0; p < POLICY_COUNT; p++) {
+        add_case(run_swap_out, (Policy)p, "x86-64,mem=32M", 0, "swap_out/%s", policy_name(p));
+    }
+
+    for (size_t t = 0; t < sizeof(input_traces) / sizeof(input_traces[0]); t++) {
+        if (access(input_traces[t], R_OK) != 0) {
+            fprintf(stderr, "bench: %s not found, skipped (run from the repository root)\n", input_traces[t]);
+            continue;
+        }
+        for (int p = 0; p < POLICY_COUNT; p++) {
+            BenchCase *c = add_case(run_e2e, (Policy)p, "12bit", 0, "e2e/%s/%s", input_traces[t], policy_name(p));
+            c->trace = input_traces[t];
+        }
+    }
+    for (size_t t = 0; t < sizeof(synth_traces) / sizeof(synth_traces[0]); t++) {
+        for (int p = 0; p < POLICY_COUNT; p++) {
+            BenchCase *c = add_case(run_e2e, (Policy)p, SYNTH_GEOMETRY, 0, "e2e/%s/%s", synth_traces[t].label,
+                                    policy_name(p));
+            c->trace = synth_traces[t].spec;
+        }
+    }
+}
+
+// --- 반복 측정 ---
+static int cmp_double(const void *a, const void *b) {
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+static double median_of(double *v, int n) {
+    qsort(v, n, sizeof(double), cmp_double);
+    return n % 2 ? v[n / 2] : (v[n / 2 - 1] + v[n / 2]) / 2;
+}
+
+static void measure(const BenchCase *c, int repeats, BenchResult *r) {
+    double ns[repeats], dev[repeats];
+    uint64_t ops = 0;
+    c->run(c, &ops); // 워밍업 (캐시 / 페이지 / 주파수)
+    for (int i = 0; i < repeats; i++) {
+        double elapsed = c->run(c, &ops);
+        ns[i] = ops ? elapsed * 1e9 / ops : 0.0;
+    }
+    memcpy(r->name, c->name, sizeof(r->name));
+    r->ops = ops;
+    r->median = median_of(ns, repeats);
+    r->min = ns[0];
+    r->max = ns[repeats - 1];
+    for (int i = 0; i < repeats; i++) dev[i] = ns[i] > r->median ? ns[i] - r->median : r->median - ns[i];
+    r->mad = median_of(dev, repeats);
+}
+
+// --- JSON: 항목마다 한 줄 (기준 파일을 줄 단위로 다시 읽음) ---
+static int write_json(const BenchResult *res, int n, int repeats, const char *path) {
+    FILE *fp = fopen(path, "w");
+    if (!fp) {
+        perror("fopen bench results");
+        return -1;
+    }
+    fprintf(fp, "{\n");
+    fprintf(fp, "  \"suite\": \"mmusim\",\n");
+    fprintf(fp, "  \"repeats\": %d,\n", repeats);
+    fprintf(fp, "  \"scale\": %.3f,\n", scale);
+    fprintf(fp, "  \"unit\": \"ns/op\",\n");
+    fprintf(fp, "  \"results\": [\n");
+    for (int i = 0; i < n; i++) {
+        fprintf(fp, "    { \"name\": \"%s\", \"ops\": %llu, \"median_ns\": %.3f, \"min_ns\": %.3f, "
+                "\"max_ns\": %.3f, \"mad_ns\": %.3f, \"ops_per_s\": %.0f }%s\n",
+                res[i].name, (unsigned long long)res[i].ops, res[i].median, res[i].min, res[i].max,
+                res[i].mad, res[i].median > 0 ? 1e9 / res[i].median : 0.0, i + 1 < n ? "," : "");
+    }
+    fprintf(fp, "  ]\n");
+    fprintf(fp, "}\n");
+    return fclose(fp) == 0 ? 0 : -1;
+}
+
+typedef struct {
+    char name[NAME_LEN];
+    double median;
+} BaselineEntry;
+
+// write_json 이 쓴 파일에서 (name, median_ns) 만 읽음. 실패 시 -1
+static int read_baseline(const char *path, BaselineEntry *out, int cap) {
+    FILE *fp = fopen(path, "r");
+    if (!fp) {
+        perror("fopen baseline");
+        return -1;
+    }
+    char line[512];
+    int n = 0;
+    while (n < cap && fgets(line, sizeof(line), fp)) {
+        const char *name = strstr(line, "\"name\": \"");
+        const char *median = strstr(line, "\"median_ns\": ");
+        if (!name || !median) continue;
+        name += strlen("\"name\": \"");
+        const char *end = strchr(name, '"');
+        if (!end || end - name >= NAME_LEN) continue;
+        memcpy(out[n].name, name, end - name);
+        out[n].name[end - name] = '\0';
+        out[n].median = strtod(median + strlen("\"median_ns\": "), NULL);
+        n++;
+    }
+    fclose(fp);
+    return n;
+}
+
+// 기준보다 threshold % 넘게 느려진 항목 수
+static int compare_baseline(const BenchResult *res, int n, const BaselineEntry *base, int nb, double threshold) {
+    int regressions = 0, matched = 0;
+    printf("\n%-44s %12s %12s %9s\n", "vs baseline", "base ns/op", "now ns/op", "change");
+    for (int i = 0; i < n; i++) {
+        const BaselineEntry *b = NULL;
+        for (int j = 0; j < nb && !b; j++) {
+            if (strcmp(base[j].name, res[i].name) == 0) b = &base[j];
+        }
+        if (!b || b->median <= 0) continue;
+        matched++;
+        double change = (res[i].median - b->median) / b->median * 100.0;
+        // 임계값을 넘어도 이번 측정의 흔들림 (MAD 의 3배) 안이면 판정하지 않음
+        double noise = 3.0 * res[i].mad / res[i].median * 100.0;
+        double limit = threshold > noise ? threshold : noise;
+        const char *verdict = "";
+        if (change > limit) {
+            verdict = "  REGRESSION";
+            regressions++;
+        } else if (change < -limit) {
+            verdict = "  faster";
+        } else if (change > threshold || change < -threshold) {
+            verdict = "  (noisy)";
+        }
+        printf("%-44s %12.2f %12.2f %+8.1f%%%s\n", res[i].name, b->median, res[i].median, change, verdict);
+    }
+    printf("%d of %d benchmarks matched the baseline, %d regressed by more than %.1f%%\n",
+           matched, n, regressions, threshold);
+    return regressions;
+}
+
+static void print_usage(const char *prog_name) {
+    fprintf(stderr, "Usage: %s [-r <repeats>] [-s <scale>] [-k <filter>] [-o <results.json>]\n"
+                    "          [-b <baseline.json> [-t <threshold_pct>]]\n", prog_name);
+    fprintf(stderr, "  -r: measured runs per benchmark after one warm-up run (default 5)\n");
+    fprintf(stderr, "  -s: multiply iteration counts and trace lengths (default 1.0, e.g. 0.1 for a quick check)\n");
+    fprintf(stderr, "  -k: only run benchmarks whose name contains <filter>\n");
+    fprintf(stderr, "  -o: write results as JSON (ns per operation)\n");
+    fprintf(stderr, "  -b: compare medians with a previous -o file; exit status 2 on a regression\n");
+    fprintf(stderr, "  -t: regression threshold in percent (default 10)\n");
+}
+
+int main(int argc, char *argv[]) {
+    int opt;
+    int repeats = 5;
+    double threshold = 10.0;
+    const char *out_path = NULL, *baseline_path = NULL, *filter = NULL;
+
+    while ((opt = getopt(argc, argv, "r:s:k:o:b:t:")) != -1) {
+        switch (opt) {
+            case 'r': repeats = atoi(optarg); break;
+            case 's': scale = atof(optarg); break;
+            case 'k': filter = optarg; break;
+            case 'o': out_path = optarg; break;
+            case 'b': baseline_path = optarg; break;
+            case 't': threshold = atof(optarg); break;
+            default:
+                print_usage(argv[0]);
+                exit(EXIT_FAILURE);
+        }
+    }
+    if (optind != argc || repeats < 1 || scale <= 0 || threshold <= 0) {
+        print_usage(argv[0]);
+        exit(EXIT_FAILURE);
+    }
+
+    // 타이머 비용: 빈 구간 측정의 중앙값
+    double empty[101];
+    for (int i = 0; i < 101; i++) {
+        double start = now_sec();
+        empty[i] = now_sec() - start;
+    }
+    timer_cost = median_of(empty, 101);
+
+    build_cases();
+    BenchResult *res = calloc(num_cases, sizeof(BenchResult));
+    int n = 0;
+
+    printf("%-44s %10s %10s %10s %8s %14s\n", "benchmark", "median ns", "min", "max", "mad %", "ops/s");
+    for (int i = 0; i < num_cases; i++) {
+        if (filter && !strstr(cases[i].name, filter)) continue;
+        BenchResult *r = &res[n++];
+        measure(&cases[i], repeats, r);
+        printf("%-44s %10.2f %10.2f %10.2f %8.2f %14.0f\n", r->name, r->median, r->min, r->max,
+               r->median > 0 ? r->mad / r->median * 100.0 : 0.0, r->median > 0 ? 1e9 / r->median : 0.0);
+        fflush(stdout);
+    }
+
+    int status = EXIT_SUCCESS;
+    if (out_path) {
+        if (write_json(res, n, repeats, out_path) != 0) status = EXIT_FAILURE;
+        else fprintf(stderr, "[Bench] %d results written to %s\n", n, out_path);
+    }
+    if (baseline_path) {
+        BaselineEntry *base = calloc(MAX_RESULTS, sizeof(BaselineEntry));
+        int nb = read_baseline(baseline_path, base, MAX_RESULTS);
+        if (nb < 0) status = EXIT_FAILURE;
+        else if (compare_baseline(res, n, base, nb, threshold) > 0 && status == EXIT_SUCCESS) status = 2;
+        free(base);
+    }
+    free(res);
+    return status;
+}
@@ -0,0 +1,113 @@
+/* bench/bench_tlb.c
+ * TLB 조회 비용 비교: 기존 TLB_Entry 배열 선형 탐색 vs tlb.c 의 SoA 태그 + SIMD 비교
+ * 엔트리 수 / 연관도를 바꿔가며 조회 1회당 평균 시간(ns)을 출력
+ * 같은 VPN 집합을 채운 뒤 Hit 와 Miss 를 반반 섞어 조회하고, 두 방식의 Hit 수가 같은지 검증함
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "sim.h"
+#include "tlb.h"
+
+static uint64_t rng_state = 0x9E3779B97F4A7C15ULL;
+
+static inline uint64_t xorshift64() {
+    uint64_t x = rng_state;
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    return rng_state = x;
+}
+
+static double now_sec() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// 기존 tlb.c 의 엔트리 구조체와 search_tlb 탐색
+typedef struct {
+    uint64_t vpn;
+    uint32_t pfn;
+    bool valid;
+    uint64_t last_access_time;
+} OldEntry;
+
+static int old_search(const OldEntry *tlb, int n, uint64_t vpn) {
+    for (int i = 0; i < n; i++) {
+        if (tlb[i].valid && tlb[i].vpn == vpn) return tlb[i].pfn;
+    }
+    return -1;
+}
+
+// 조회할 VPN 목록: 절반은 TLB 안 (0 .. n-1), 절반은 밖
+static uint64_t* make_queries(int n, int lookups) {
+    uint64_t *q = malloc(sizeof(uint64_t) * lookups);
+    rng_state = 0x9E3779B97F4A7C15ULL;
+    for (int i = 0; i < lookups; i++) {
+        uint64_t r = xorshift64();
+        q[i] = (r & 1) ? (r >> 1) % n : n + (r >> 1) % n;
+    }
+    return q;
+}
+
+static double run_old(int n, const uint64_t *q, int lookups, int *hits) {
+    OldEntry *tlb = calloc(n, sizeof(OldEntry));
+    for (int i = 0; i < n; i++) tlb[i] = (OldEntry){ (uint64_t)i, (uint32_t)i, true, 0 };
+
+    int h = 0;
+    double start = now_sec();
+    for (int i = 0; i < lookups; i++) h += old_search(tlb, n, q[i]) != -1;
+    double elapsed = now_sec() - start;
+
+    *hits = h;
+    free(tlb);
+    return elapsed / lookups * 1e9;
+}
+
+static double run_new(int n, int ways, const uint64_t *q, int lookups, int *hits) {
+    Geometry geo;
+    char spec[128];
+    snprintf(spec, sizeof(spec), "x86-64,tlb=%d,tlb_ways=%d", n, ways);
+    if (geometry_parse(&geo, spec) != 0) exit(1);
+
+    // RR: 조회 비용만 비교 (LRU 리스트 갱신 제외)
+    SimContext *ctx = sim_create(&geo, POLICY_RR);
+    for (int i = 0; i < n; i++) update_tlb(ctx, (uint64_t)i, i);
+
+    int h = 0;
+    double start = now_sec();
+    for (int i = 0; i < lookups; i++) h += search_tlb(ctx, q[i]) != -1;
+    double elapsed = now_sec() - start;
+
+    *hits = h;
+    sim_free(ctx);
+    return elapsed / lookups * 1e9;
+}
+
+int main(int argc, char *argv[]) {
+    int lookups = argc > 1 ? atoi(argv[1]) : 200000;
+    const int sizes[] = { 16, 64, 512, 1536, 4096 };
+    const int n_sizes = sizeof(sizes) / sizeof(sizes[0]);
+
+    printf("%8s %14s %14s %14s %8s\n", "entries", "old ns/lookup", "full ns/lookup",
+           "8-way ns/look", "match");
+    for (int i = 0; i < n_sizes; i++) {
+        int n = sizes[i];
+        uint64_t *q = make_queries(n, lookups);
+        int hits_old, hits_full, hits_8way;
+
+        double t_old = run_old(n, q, lookups, &hits_old);
+        double t_full = run_new(n, 0, q, lookups, &hits_full);
+        // 1536 처럼 set 수가 2의 거듭제곱이 아니면 12-way (x86 STLB 구성)
+        int ways = (n / 8) & (n / 8 - 1) ? 12 : 8;
+        double t_ways = n >= 8 ? run_new(n, ways, q, lookups, &hits_8way) : 0;
+
+        printf("%8d %14.1f %14.1f %14.1f %8s\n", n, t_old, t_full, t_ways,
+               hits_old == hits_full && hits_old == hits_8way ? "yes" : "NO");
+        free(q);
+    }
+    return 0;
+}
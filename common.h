@@ -4,40 +4,126 @@
 #include <stdint.h>
 #include <stdbool.h>
 
-// --- 시스템 상수 ---
-#define MEM_SIZE 1024
-#define PAGE_SIZE 8
-#define FRAME_SIZE 8
-#define NUM_FRAMES (MEM_SIZE / FRAME_SIZE) // 128
-#define TLB_SIZE 16
-
-// --- 주소 비트 구조 (12-bit) ---
+// --- 메모리 구조 (Geometry) ---
+// 실행 시 -g 옵션으로 설정 (geometry.c). 기본값은 아래의 12-bit 프리셋
+//
+// [Preset "12bit"] 기존 컴파일 타임 상수와 동일
+// MEM_SIZE 1024, PAGE_SIZE 8, NUM_FRAMES 128, TLB_SIZE 16
 // | VPN1 (3) | VPN2 (3) | VPN3 (3) | Offset (3) |
-#define MASK_3BIT 0x07
+// PTE 1 Byte: | Present (1) | PFN (7) |  (Dirty 비트를 둘 자리가 없음)
+#define MAX_LEVELS 5
+#define TLB_LEVELS 2  // L1 / L2 TLB
+#define MAX_CORES 64  // 코어 집합을 uint64_t 비트마스크로 표현
+#define PWC_MAX_ENTRIES 1024 // Page Walk Cache 단계별 최대 엔트리 (조회가 선형 탐색)
 
-#define GET_VPN1(va)    (((va) >> 9) & MASK_3BIT)
-#define GET_VPN2(va)    (((va) >> 6) & MASK_3BIT)
-#define GET_VPN3(va)    (((va) >> 3) & MASK_3BIT)
-#define GET_OFFSET(va)  ((va) & MASK_3BIT)
-#define GET_FULL_VPN(va) ((va) >> 3)
+// TLB shootdown 방식 (Geometry.shootdown)
+#define SHOOTDOWN_SYNC 0  // Victim 마다 다른 모든 코어에 IPI (broadcast)
+#define SHOOTDOWN_LAZY 1  // 그 프로세스를 실행 중인 코어에만 IPI, 나머지는 다음 문맥 교환 때 flush
 
-// --- PTE 구조 (1 Byte) ---
-// | Present (1) | PFN (7) |
-#define PTE_PRESENT_MASK 0x80
-#define PTE_PFN_MASK     0x7F
+// Page Fault prefetch 예측기 (Geometry.prefetch, prefetch.h)
+#define PREFETCH_NONE   0
+#define PREFETCH_SEQ    1  // 다음 페이지들
+#define PREFETCH_STRIDE 2  // 같은 간격이 반복되면 그 간격으로
+#define PREFETCH_MARKOV 3  // Miss 키 -> 다음 Miss 키 상관 테이블
 
-#define IS_PTE_PRESENT(pte) ((pte) & PTE_PRESENT_MASK)
-#define GET_PTE_PFN(pte)    ((pte) & PTE_PFN_MASK)
-#define CREATE_PTE(pfn)     ((uint8_t)(0x80 | ((pfn) & 0x7F))) // Present=1 설정
+typedef struct {
+    // 설정값
+    int va_bits;                  // 가상 주소 폭
+    int offset_bits;              // log2(PAGE_SIZE)
+    int levels;                   // 페이지 테이블 단계 수 (2~5)
+    int level_bits[MAX_LEVELS];   // 단계별 인덱스 비트 수 ([0] = Root)
+    int pte_bytes;                // PTE 크기 (1, 2, 4, 8)
+    uint64_t mem_size;            // 물리 메모리 크기 (Bytes)
+    int tlb_size;                 // (L1) TLB 엔트리 수
+    int tlb_ways;                 // L1 TLB 연관도 (0 = fully associative)
+    int l2_tlb_size;              // L2 TLB 엔트리 수 (0 = L2 없음)
+    int l2_tlb_ways;              // L2 TLB 연관도 (0 = fully associative)
+    int tlb_policy[TLB_LEVELS];   // 단계별 TLB 교체 정책 (-1 = -p 로 지정한 정책)
+    int tlb_asid;                 // 1 = TLB 엔트리에 ASID 태그 (기본), 0 = 문맥 교환마다 전체 flush
+    int cores;                    // 코어 수 (코어마다 private TLB, 페이지 테이블 / 메모리는 공유)
+    int shootdown;                // SHOOTDOWN_*
+    int reclaim_batch;            // 메모리가 찼을 때 한 번에 회수하는 프레임 수 (shootdown 1회로 묶음)
+    int pwc_entries;              // Page Walk Cache 단계별 엔트리 수 (0 = 없음, 매 Walk 가 Root 부터)
+    int superpage;                // Leaf 몇 단계 위의 PTE 가 큰 페이지를 직접 매핑하는지 (0 = 없음, 1 = Leaf 바로 위)
+    int sp_promote;               // 영역의 몇 % 가 적재되면 Superpage 로 승격하는지
+    int prefetch;                 // PREFETCH_*
+    int prefetch_depth;           // Miss 하나에 미리 적재하는 최대 페이지 수
+    int prefetch_table;           // [markov] 상관 테이블 엔트리 수
+    int pt_reclaim;               // 1 = 유효 엔트리가 모두 사라진 PD2 / PT 프레임을 해제 (기본 0 = 한 번 만든 테이블은 유지)
+    uint64_t slow_mem_size;       // [Tier] DRAM 뒤의 느린 계층 (CXL / NVM) 크기 (0 = 단일 계층)
+    int tier_epoch;               // [Tier] 이 접근 수마다 승격 / 강등 (tier.h)
+    int tier_batch;               // [Tier] 한 번에 승격하는 최대 페이지 수
+    int tier_hot;                 // [Tier] 승격 후보가 되는 최소 접근 빈도 (heat)
+
+    // 지연 시간 모델 (cycle). 총 cycle / AMAT 계산에만 쓰이고 동작에는 영향 없음
+    int lat_tlb[TLB_LEVELS];      // 단계별 TLB 조회 (L2 는 L1 Miss 일 때만)
+    int lat_pwc;                  // Page Walk Cache 조회 (Walk 마다 1회)
+    int lat_mem;                  // 메모리 접근 1회 (Walk 의 단계별 PTE 읽기, Dirty 비트 기록, 데이터 접근)
+    int lat_fault;                // Page Fault 처리 1회 (스왑 I/O 제외)
+    int lat_swap;                 // 스왑 장치 페이지 I/O 1회 (Swap-in 읽기, Dirty Victim 쓰기)
+    int lat_slow;                 // [Tier] 느린 계층 프레임 접근 1회 (DRAM 은 lat_mem)
+
+    // 파생값 (geometry_finalize 에서 계산)
+    uint64_t page_size;           // = FRAME_SIZE
+    int num_frames;               // 두 계층 합 (PFN 0 ~ fast_frames-1 이 DRAM, 나머지가 느린 계층)
+    int fast_frames;              // = mem_size / page_size
+    int level_shift[MAX_LEVELS];  // 단계별 인덱스의 시작 비트 위치
+    uint64_t va_mask;
+    uint64_t offset_mask;
+    int mask_frames;              // Swappable 비트마스크가 차지하는 프레임 수 (Frame 0 ~)
+    int root_pfn;                 // Root Page Directory (= mask_frames)
+    uint64_t pte_present_mask;    // PTE 최상위 비트
+    uint64_t pte_huge_mask;       // 큰 페이지 표시(PS) 비트, Present 바로 아래 (superpage 0 이면 0)
+    uint64_t pte_dirty_mask;      // 플래그 다음 비트 (PFN 이 그 비트까지 필요하면 0 = Dirty 비트 없음)
+    uint64_t pte_pfn_mask;        // PTE 하위 PFN 비트
+    int vpn_bits;                 // = va_bits - offset_bits
+    int asid_bits;                // 페이지 키에서 pid 가 차지하는 비트 수 (최대 프로세스 수 = 2^asid_bits)
+    int sp_level;                 // 큰 페이지를 매핑하는 단계 (superpage 0 이면 -1)
+    int sp_bits;                  // Superpage 하나가 덮는 VPN 비트 수 (= sp_level 아래 단계 비트의 합)
+} Geometry;
+
+// --- 주소 분해 (geo: const Geometry *) ---
+#define GET_LEVEL_INDEX(geo, va, l) (((va) >> (geo)->level_shift[l]) & ((1ULL << (geo)->level_bits[l]) - 1))
+#define GET_OFFSET(geo, va)         ((va) & (geo)->offset_mask)
+#define GET_FULL_VPN(geo, va)       ((va) >> (geo)->offset_bits)
+
+// --- 페이지 키 (pid, vpn) ---
+// | pid (asid_bits) | VPN (vpn_bits) |
+// TLB 태그, Reverse Mapping, 교체 정책의 ghost 기록은 모두 이 키를 사용 (pid 0 이면 키 = VPN)
+#define PAGE_KEY(geo, pid, vpn) (((uint64_t)(pid) << (geo)->vpn_bits) | (vpn))
+#define KEY_PID(geo, key)       ((int)((key) >> (geo)->vpn_bits))
+#define KEY_VPN(geo, key)       ((key) & ((1ULL << (geo)->vpn_bits) - 1))
+
+// --- PTE 구조 (pte_bytes) ---
+// | Present (1) | [Huge (1)] | Dirty (1) | ... | PFN |
+// Dirty 는 쓰기 접근 때 설정, 스왑 아웃 때 Victim 을 스왑 장치에 다시 써야 하는지 판단
+// Dirty 비트가 없는 Geometry 는 프레임별 Dirty 로 대신함 (memory.h 의 frame_dirty_mask)
+// Huge 는 superpage 를 켰을 때만: sp_level 단계 PTE 가 다음 테이블 대신 정렬된 연속 프레임을 가리킴
+#define IS_PTE_PRESENT(geo, pte) ((pte) & (geo)->pte_present_mask)
+#define IS_PTE_DIRTY(geo, pte)   ((pte) & (geo)->pte_dirty_mask)
+#define IS_PTE_HUGE(geo, pte)    ((pte) & (geo)->pte_huge_mask)
+#define GET_PTE_PFN(geo, pte)    ((int)((pte) & (geo)->pte_pfn_mask))
+#define CREATE_PTE(geo, pfn)     ((geo)->pte_present_mask | ((uint64_t)(pfn) & (geo)->pte_pfn_mask)) // Present=1 설정
 
 // --- 교체 정책 정의 ---
+// RR / LRU / OPT 외에는 프레임 교체에만 적용 (TLB 는 RR, LRU, OPT)
 typedef enum {
     POLICY_RR,
-    POLICY_LRU
+    POLICY_LRU,
+    POLICY_CLOCK,     // 참조 비트 + second chance
+    POLICY_CLOCK_PRO, // hot / cold + 비상주 test 페이지
+    POLICY_2Q,        // A1in FIFO / A1out ghost / Am LRU
+    POLICY_ARC,       // T1 / T2 + ghost B1 / B2, 적응형 분할
+    POLICY_OPT,       // Belady: 다음 사용이 가장 늦은 페이지 (트레이스 전체를 미리 알아야 함)
+    POLICY_COUNT // 정책 개수 (통계 배열 크기)
 } Policy;
 
-// 전역 변수 선언 (main.c에 정의)
-extern Policy g_policy;
-extern uint64_t g_time; // LRU용 시뮬레이션 시간 (메모리 액세스 횟수)
+const char* policy_name(Policy policy);
+
+// 문자열 -> 정책. 성공 0, 실패 -1
+int policy_parse(const char *str, Policy *policy);
+
+// 시뮬레이터 인스턴스 (sim.h). 모든 상태는 여기에 담기므로 한 프로세스에서 여러 개 실행 가능
+typedef struct SimContext SimContext;
 
-#endif
\ No newline at end of file
+#endif
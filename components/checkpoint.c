@@ -0,0 +1,355 @@
+/* checkpoint.c */
+#include "checkpoint.h"
+#include "sim.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// 저장과 복원이 같은 함수로 같은 순서를 따라가도록 (필드를 하나 빼먹어도 양쪽이 어긋나지 않음)
+// load 이면 파일에서 읽어 채우고, 아니면 파일에 씀
+typedef struct {
+    FILE *fp;
+    bool load;
+    bool err;
+} CkFile;
+
+static void ck_raw(CkFile *ck, void *p, size_t n) {
+    if (ck->err || n == 0) return;
+    size_t done = ck->load ? fread(p, 1, n, ck->fp) : fwrite(p, 1, n, ck->fp);
+    if (done != n) ck->err = true;
+}
+
+#define CK_VAL(ck, v)    ck_raw(ck, &(v), sizeof(v))
+#define CK_ARR(ck, p, n) ck_raw(ck, (p), sizeof(*(p)) * (size_t)(n))
+
+// 크기처럼 geometry 로 정해지는 값: 저장하고, 복원 때는 같은지만 확인
+static void ck_check(CkFile *ck, uint64_t v) {
+    uint64_t saved = v;
+    CK_VAL(ck, saved);
+    if (ck->load && saved != v) ck->err = true;
+}
+
+// 개수가 실행 중에 늘어나는 배열 (프로세스 테이블, pid 별 prefetch 흐름)
+// 복원 때는 저장된 개수만큼 다시 할당
+static void ck_grow(CkFile *ck, void **p, int count, size_t elem) {
+    if (ck->load && !ck->err) {
+        void *q = realloc(*p, elem * (size_t)(count ? count : 1));
+        if (!q) {
+            ck->err = true;
+            return;
+        }
+        *p = q;
+    }
+    ck_raw(ck, *p, elem * (size_t)count);
+}
+
+static void ck_lru(CkFile *ck, LRUList *l) {
+    ck_check(ck, (uint64_t)l->capacity);
+    CK_ARR(ck, l->prev, l->capacity);
+    CK_ARR(ck, l->next, l->capacity);
+    CK_ARR(ck, l->linked, l->capacity);
+    CK_VAL(ck, l->head);
+    CK_VAL(ck, l->tail);
+    CK_VAL(ck, l->size);
+}
+
+static void ck_heap(CkFile *ck, IndexHeap *h) {
+    ck_check(ck, (uint64_t)h->capacity);
+    CK_ARR(ck, h->heap, h->capacity);
+    CK_ARR(ck, h->pos, h->capacity);
+    CK_ARR(ck, h->key, h->capacity);
+    CK_VAL(ck, h->size);
+}
+
+// 해시맵은 (키, 값) 쌍으로: 복원된 맵의 내부 배치는 달라도 조회 결과는 같음
+static void ck_vmap(CkFile *ck, VpnMap *m) {
+    uint64_t size = m->size;
+    CK_VAL(ck, size);
+    if (!ck->load) {
+        for (uint64_t i = 0; i < m->capacity; i++) {
+            if (!m->used[i]) continue;
+            CK_VAL(ck, m->keys[i]);
+            CK_VAL(ck, m->values[i]);
+        }
+        return;
+    }
+    vmap_clear(m);
+    for (uint64_t i = 0; i < size && !ck->err; i++) {
+        uint64_t key, value;
+        CK_VAL(ck, key);
+        CK_VAL(ck, value);
+        if (!ck->err) vmap_put(m, key, value);
+    }
+}
+
+static void ck_ghost(CkFile *ck, GhostList *g) {
+    ck_check(ck, (uint64_t)g->capacity);
+    CK_ARR(ck, g->vpn, g->capacity);
+    CK_ARR(ck, g->free_slots, g->capacity);
+    CK_VAL(ck, g->free_count);
+    ck_lru(ck, &g->order);
+    ck_vmap(ck, &g->index);
+}
+
+// 물리 메모리: 0 이 아닌 프레임의 비트맵 + 그 프레임들만 (테이블 / 아직 안 쓴 프레임이 대부분 0)
+static void ck_memory(CkFile *ck, SimContext *ctx) {
+    MemoryState *m = &ctx->mem;
+    const Geometry *geo = &ctx->geo;
+    int words = (geo->num_frames + 63) / 64;
+    uint64_t *nonzero = calloc(words, sizeof(uint64_t));
+    if (!nonzero) {
+        ck->err = true;
+        return;
+    }
+    if (!ck->load) {
+        for (int f = 0; f < geo->num_frames; f++) {
+            const uint8_t *page = get_frame_ptr(ctx, f);
+            for (uint64_t i = 0; i < geo->page_size; i++) {
+                if (page[i]) {
+                    nonzero[f / 64] |= 1ULL << (f % 64);
+                    break;
+                }
+            }
+        }
+    }
+    CK_ARR(ck, nonzero, words);
+    for (int f = 0; f < geo->num_frames && !ck->err; f++) {
+        uint8_t *page = get_frame_ptr(ctx, f);
+        if ((nonzero[f / 64] >> (f % 64)) & 1) ck_raw(ck, page, geo->page_size);
+        else if (ck->load) memset(page, 0, geo->page_size);
+    }
+    free(nonzero);
+
+    CK_ARR(ck, m->frame_owner_vpn, geo->num_frames);
+    ck_check(ck, (uint64_t)m->free_mask_words);
+    CK_ARR(ck, m->frame_free_mask, m->free_mask_words);
+    CK_VAL(ck, m->free_hint_word);
+    if (m->frame_reserved_mask) CK_ARR(ck, m->frame_reserved_mask, m->free_mask_words);
+    if (m->frame_dirty_mask) CK_ARR(ck, m->frame_dirty_mask, m->free_mask_words);
+}
+
+// 스왑 장치: 사본이 있는 페이지 키와 내용 (복원하면 ctx 의 장치에 새 slot 으로 다시 기록)
+static void ck_swap_device(CkFile *ck, SwapDevice *dev) {
+    uint8_t *page = malloc(dev->page_size);
+    if (!page) {
+        ck->err = true;
+        return;
+    }
+    uint64_t count = dev->slot.size;
+    CK_VAL(ck, count);
+    if (!ck->load) {
+        for (uint64_t i = 0; i < dev->slot.capacity && !ck->err; i++) {
+            if (!dev->slot.used[i]) continue;
+            uint64_t key = dev->slot.keys[i];
+            swapdev_read(dev, key, page);
+            CK_VAL(ck, key);
+            ck_raw(ck, page, dev->page_size);
+        }
+    } else {
+        // 이전 slot 은 버리고 파일 앞에서부터 다시 씀
+        vmap_clear(&dev->slot);
+        dev->slots = 0;
+        for (uint64_t i = 0; i < count && !ck->err; i++) {
+            uint64_t key;
+            CK_VAL(ck, key);
+            ck_raw(ck, page, dev->page_size);
+            if (!ck->err) swapdev_write(dev, key, page);
+        }
+    }
+    free(page);
+}
+
+static void ck_swap(CkFile *ck, SimContext *ctx) {
+    SwapState *s = &ctx->swap;
+    int n = ctx->geo.num_frames;
+    CK_VAL(ck, s->rr_idx);
+    CK_ARR(ck, s->frame_last_access, n);
+    ck_lru(ck, &s->frame_lru);
+    CK_ARR(ck, s->frame_flags, n);
+    ck_check(ck, (uint64_t)s->capacity);
+    for (int i = 0; i < 2; i++) {
+        if (s->queue[i].capacity) ck_lru(ck, &s->queue[i]);
+        if (s->ghost[i].capacity) ck_ghost(ck, &s->ghost[i]);
+    }
+    CK_VAL(ck, s->target);
+    CK_VAL(ck, s->fault_ghost);
+    CK_VAL(ck, s->load_prefetch);
+    if (s->opt_heap.capacity) ck_heap(ck, &s->opt_heap);
+    ck_swap_device(ck, &s->device);
+}
+
+static void ck_tlb(CkFile *ck, TLBState *t) {
+    ck_check(ck, (uint64_t)t->levels);
+    for (int l = 0; l < t->levels; l++) {
+        TLBLevel *lv = &t->level[l];
+        size_t slots = (size_t)lv->sets * lv->stride;
+        ck_check(ck, slots);
+        CK_ARR(ck, lv->tag, slots);
+        CK_ARR(ck, lv->pfn, slots);
+        CK_ARR(ck, lv->time, slots);
+        CK_ARR(ck, lv->rr_idx, lv->sets);
+        for (int s = 0; s < lv->sets; s++) {
+            ck_lru(ck, &lv->lru[s]);
+            if (lv->heap) ck_heap(ck, &lv->heap[s]);
+        }
+    }
+    CK_VAL(ck, t->last_hit_level);
+    CK_VAL(ck, t->last_hit_huge);
+    CK_VAL(ck, t->clock);
+}
+
+static void ck_core(CkFile *ck, Core *c) {
+    ck_tlb(ck, &c->tlb);
+    PWCState *pwc = &c->pwc;
+    size_t n = (size_t)pwc->levels * pwc->entries;
+    CK_ARR(ck, pwc->tag, n);
+    CK_ARR(ck, pwc->pfn, n);
+    CK_ARR(ck, pwc->stamp, n);
+    CK_VAL(ck, pwc->clock);
+    CK_VAL(ck, c->pid);
+    CK_VAL(ck, c->key_base);
+    CK_VAL(ck, c->tlb_evictions);
+    CK_VAL(ck, c->stats);
+}
+
+static void ck_processes(CkFile *ck, ProcessTable *pt) {
+    CK_VAL(ck, pt->count);
+    if (pt->count < 1) ck->err = true;
+    ck_grow(ck, (void **)&pt->root_pfn, pt->count, sizeof(*pt->root_pfn));
+    ck_grow(ck, (void **)&pt->stats, pt->count, sizeof(*pt->stats));
+    ck_grow(ck, (void **)&pt->cpumask, pt->count, sizeof(*pt->cpumask));
+    ck_grow(ck, (void **)&pt->stale_mask, pt->count, sizeof(*pt->stale_mask));
+    CK_VAL(ck, pt->current);
+    CK_VAL(ck, pt->key_base);
+}
+
+static void ck_page_tables(CkFile *ck, SimContext *ctx) {
+    if (ctx->pt.valid) CK_ARR(ck, ctx->pt.valid, ctx->geo.num_frames);
+}
+
+static void ck_tiers(CkFile *ck, SimContext *ctx) {
+    TierState *t = &ctx->tier;
+    if (!t->heat) return;
+    CK_ARR(ck, t->heat, ctx->geo.num_frames);
+    CK_VAL(ck, t->next_epoch);
+}
+
+static void ck_superpages(CkFile *ck, SuperpageState *sp) {
+    if (!sp->pages) return;
+    ck_check(ck, (uint64_t)sp->blocks);
+    CK_ARR(ck, sp->block, sp->blocks);
+    ck_vmap(ck, &sp->region_block);
+}
+
+static void ck_prefetch(CkFile *ck, SimContext *ctx) {
+    PrefetchState *pf = &ctx->pf;
+    if (!pf->unused) return;
+    CK_ARR(ck, pf->unused, ctx->geo.num_frames);
+    CK_VAL(ck, pf->streams);
+    ck_grow(ck, (void **)&pf->stream, pf->streams, sizeof(*pf->stream));
+    if (pf->key) {
+        ck_check(ck, (uint64_t)pf->slots);
+        CK_ARR(ck, pf->key, pf->slots);
+        CK_ARR(ck, pf->next, (size_t)pf->slots * PF_MARKOV_WAYS);
+        CK_VAL(ck, pf->used);
+        CK_VAL(ck, pf->clock);
+        ck_vmap(ck, &pf->index);
+    }
+    CK_VAL(ck, pf->pending);
+    CK_VAL(ck, pf->pending_key);
+}
+
+// 파일 머리: 형식 확인용 값과 실행 설정 (지연 시간은 동작에 영향이 없으므로 비교에서 뺌)
+typedef struct {
+    char magic[4];
+    uint32_t version;
+    uint32_t geometry_size;
+    uint32_t stats_size;
+    Geometry geo;
+    int32_t policy;
+    int32_t core;
+    uint64_t trace_pos;
+    uint64_t time;
+} CheckpointHeader;
+
+static void header_of(CheckpointHeader *h, const SimContext *ctx) {
+    memset(h, 0, sizeof(*h));
+    memcpy(h->magic, CHECKPOINT_MAGIC, 4);
+    h->version = CHECKPOINT_VERSION;
+    h->geometry_size = sizeof(Geometry);
+    h->stats_size = sizeof(Stats);
+    h->geo = ctx->geo;
+    memset(h->geo.lat_tlb, 0, sizeof(h->geo.lat_tlb));
+    h->geo.lat_pwc = h->geo.lat_mem = h->geo.lat_fault = h->geo.lat_swap = h->geo.lat_slow = 0;
+    h->policy = ctx->policy;
+    h->core = ctx->core;
+    h->time = ctx->time;
+}
+
+static void ck_state(CkFile *ck, SimContext *ctx) {
+    ck_memory(ck, ctx);
+    ck_page_tables(ck, ctx);
+    ck_tiers(ck, ctx);
+    ck_swap(ck, ctx);
+    ck_check(ck, (uint64_t)ctx->num_cores);
+    for (int c = 0; c < ctx->num_cores; c++) ck_core(ck, &ctx->cores[c]);
+    ck_processes(ck, &ctx->proc);
+    ck_superpages(ck, &ctx->sp);
+    ck_prefetch(ck, ctx);
+    CK_VAL(ck, ctx->stats);
+}
+
+int sim_save_checkpoint(SimContext *ctx, const char *path, uint64_t trace_pos) {
+    CkFile ck = { .fp = fopen(path, "wb"), .load = false };
+    if (!ck.fp) {
+        perror("open checkpoint");
+        return -1;
+    }
+    CheckpointHeader h;
+    header_of(&h, ctx);
+    h.trace_pos = trace_pos;
+    CK_VAL(&ck, h);
+    ck_state(&ck, ctx);
+    if (fclose(ck.fp) != 0) ck.err = true;
+    if (ck.err) {
+        fprintf(stderr, "Error: failed to write checkpoint %s\n", path);
+        return -1;
+    }
+    return 0;
+}
+
+int sim_load_checkpoint(SimContext *ctx, const char *path, uint64_t *trace_pos) {
+    CkFile ck = { .fp = fopen(path, "rb"), .load = true };
+    if (!ck.fp) {
+        perror("open checkpoint");
+        return -1;
+    }
+    CheckpointHeader want, h;
+    header_of(&want, ctx);
+    CK_VAL(&ck, h);
+    if (ck.err || memcmp(h.magic, want.magic, 4) != 0 || h.version != want.version ||
+        h.geometry_size != want.geometry_size || h.stats_size != want.stats_size) {
+        fprintf(stderr, "Error: %s is not a checkpoint of this simulator build.\n", path);
+        fclose(ck.fp);
+        return -1;
+    }
+    if (memcmp(&h.geo, &want.geo, sizeof(Geometry)) != 0 || h.policy != want.policy) {
+        fprintf(stderr, "Error: checkpoint %s was taken with a different geometry or policy.\n", path);
+        fclose(ck.fp);
+        return -1;
+    }
+    if (h.core < 0 || h.core >= ctx->num_cores) ck.err = true;
+
+    ck_state(&ck, ctx);
+    fclose(ck.fp);
+    if (ck.err) {
+        fprintf(stderr, "Error: checkpoint %s is truncated or corrupt.\n", path);
+        return -1;
+    }
+    ctx->time = h.time;
+    sim_select_core(ctx, h.core);
+    // 시계열은 복원 시점부터 새로 (첫 window 가 워밍업 구간을 포함하지 않도록)
+    ctx->series.prev = ctx->stats;
+    *trace_pos = h.trace_pos;
+    return 0;
+}
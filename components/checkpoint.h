@@ -0,0 +1,29 @@
+/* checkpoint.h */
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+
+#include <stdint.h>
+#include "../common.h"
+
+// --- 시뮬레이터 상태 체크포인트 ---
+// 긴 트레이스의 워밍업 구간을 한 번만 돌리고, 그 상태에서 여러 실험을 이어가기 위한 스냅샷
+// 저장하는 것: 물리 메모리 (0 이 아닌 프레임만), Reverse Mapping / Free Bitmap / 예약 상태 / 프레임별 Dirty,
+//   테이블별 유효 엔트리 수 (pt_reclaim), 프레임별 heat (2계층), 교체 정책 상태 (LRU 시간 / 리스트, RR 포인터, CLOCK 계열 플래그, 큐 / ghost, OPT 힙),
+//   스왑 장치의 페이지 사본, 코어별 TLB / PWC, 프로세스 테이블, Superpage 블록, prefetch 예측기,
+//   시뮬레이션 시간 / 카운터, 그리고 호출자가 넘긴 트레이스 위치
+// 저장하지 않는 것: 로그, 시계열 출력, OPT 의 next-use 인덱스 (복원 후 같은 트레이스로 다시 연결)
+// 파일은 같은 빌드의 시뮬레이터만 읽음 (호스트 byte order 그대로, 구조체 크기로 확인)
+#define CHECKPOINT_MAGIC "MMCK"
+#define CHECKPOINT_VERSION 2
+
+// ctx 의 현재 상태를 path 에 저장. trace_pos = 이 상태까지 처리한 트레이스 레코드 수
+// 성공 0, 실패 -1
+int sim_save_checkpoint(SimContext *ctx, const char *path, uint64_t trace_pos);
+
+// path 의 상태로 ctx 를 덮어씀 (ctx 는 같은 geometry / 정책으로 sim_init 한 인스턴스,
+// 지연 시간 값은 달라도 됨). 스왑 장치 사본은 ctx 의 스왑 장치 (sim_set_swap_file 이후면 그 파일) 에 다시 기록
+// 성공 0 (*trace_pos 에 저장 당시 위치), 실패 -1 (geometry / 정책 불일치는 ctx 를 건드리지 않음,
+// 그 밖의 실패는 ctx 가 일부만 복원된 상태이므로 버려야 함)
+int sim_load_checkpoint(SimContext *ctx, const char *path, uint64_t *trace_pos);
+
+#endif
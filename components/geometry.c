@@ -0,0 +1,423 @@
+/* geometry.c */
+#include "geometry.h"
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+
+typedef struct {
+    const char *name;
+    int va_bits;
+    uint64_t page_size;
+    int levels;
+    int pte_bytes;
+    uint64_t mem_size;
+    int tlb_size;
+} GeometryPreset;
+
+static const GeometryPreset presets[] = {
+    // name            va  page  lv pte  mem                 tlb
+    { "12bit",         12, 8,    3, 1,   1024,               16 },
+    { "x86-32",        32, 4096, 2, 4,   256ULL << 20,       64 },
+    { "x86-64",        48, 4096, 4, 8,   1ULL << 30,         64 },
+    { "x86-64-5level", 57, 4096, 5, 8,   1ULL << 30,         64 },
+};
+#define NUM_PRESETS (int)(sizeof(presets) / sizeof(presets[0]))
+
+// PREFETCH_* 순서
+static const char *prefetch_names[] = { "none", "seq", "stride", "markov" };
+#define PREFETCH_COUNT (int)(sizeof(prefetch_names) / sizeof(prefetch_names[0]))
+
+static void apply_preset(Geometry *geo, const GeometryPreset *p) {
+    memset(geo, 0, sizeof(*geo));
+    geo->va_bits = p->va_bits;
+    geo->page_size = p->page_size;
+    geo->levels = p->levels;
+    geo->pte_bytes = p->pte_bytes;
+    geo->mem_size = p->mem_size;
+    geo->tlb_size = p->tlb_size;
+    for (int l = 0; l < TLB_LEVELS; l++) geo->tlb_policy[l] = -1;
+    geo->tlb_asid = 1;
+    geo->cores = 1;
+    geo->shootdown = SHOOTDOWN_SYNC;
+    geo->reclaim_batch = 1;
+    geo->sp_promote = 50;
+    geo->prefetch = PREFETCH_NONE;
+    geo->prefetch_depth = 4;
+    geo->prefetch_table = 4096;
+    geo->lat_tlb[0] = 1;
+    geo->lat_tlb[1] = 7;
+    geo->lat_pwc = 2;
+    geo->lat_mem = 100;
+    geo->lat_fault = 2000;   // 커널 Fault 처리 (수백 ns ~ 1 us)
+    geo->lat_swap = 200000;  // SSD 페이지 I/O 수십 us
+    geo->lat_slow = 300;     // CXL 메모리: DRAM 의 2~3 배
+    geo->tier_epoch = 10000;
+    geo->tier_batch = 32;
+    geo->tier_hot = 2;
+    // level_bits 는 finalize 에서 균등 분할
+}
+
+void geometry_default(Geometry *geo) {
+    apply_preset(geo, &presets[0]);
+    geometry_finalize(geo);
+}
+
+// "4096", "4K", "256M", "1G" 형태의 크기
+static bool parse_size(const char *s, uint64_t *out) {
+    char *end;
+    uint64_t v = strtoull(s, &end, 0);
+    if (end == s) return false;
+    switch (*end) {
+        case 'k': case 'K': v <<= 10; end++; break;
+        case 'm': case 'M': v <<= 20; end++; break;
+        case 'g': case 'G': v <<= 30; end++; break;
+        case 't': case 'T': v <<= 40; end++; break;
+        default: break;
+    }
+    if (*end == 'i' || *end == 'B') end++; // "4KiB", "4KB" 허용
+    if (*end == 'B') end++;
+    if (*end != '\0') return false;
+    *out = v;
+    return true;
+}
+
+// "10/10" 또는 "9/9/9/9" 형태 (Root 부터)
+static bool parse_split(Geometry *geo, const char *s) {
+    int n = 0;
+    const char *p = s;
+    while (*p && n < MAX_LEVELS) {
+        char *end;
+        long bits = strtol(p, &end, 10);
+        if (end == p || bits <= 0) return false;
+        geo->level_bits[n++] = (int)bits;
+        if (*end == '\0') break;
+        if (*end != '/') return false;
+        p = end + 1;
+    }
+    geo->levels = n;
+    return true;
+}
+
+int geometry_parse(Geometry *geo, const char *spec) {
+    apply_preset(geo, &presets[0]);
+
+    char *buf = strdup(spec);
+    bool split_given = false;
+    int ret = 0;
+
+    for (char *tok = strtok(buf, ","); tok && ret == 0; tok = strtok(NULL, ",")) {
+        char *eq = strchr(tok, '=');
+        if (!eq) {
+            // 프리셋 이름
+            int i;
+            for (i = 0; i < NUM_PRESETS; i++) {
+                if (strcasecmp(tok, presets[i].name) == 0) break;
+            }
+            if (i == NUM_PRESETS) {
+                fprintf(stderr, "Unknown geometry preset '%s'\n", tok);
+                ret = -1;
+            } else {
+                apply_preset(geo, &presets[i]);
+                split_given = false;
+            }
+            continue;
+        }
+
+        *eq = '\0';
+        const char *key = tok, *val = eq + 1;
+        uint64_t v = 0;
+        bool ok = true;
+
+        if (strcmp(key, "va") == 0) {
+            ok = parse_size(val, &v); geo->va_bits = (int)v;
+        } else if (strcmp(key, "page") == 0) {
+            ok = parse_size(val, &geo->page_size);
+        } else if (strcmp(key, "levels") == 0) {
+            ok = parse_size(val, &v); geo->levels = (int)v;
+            split_given = false;
+        } else if (strcmp(key, "split") == 0) {
+            ok = parse_split(geo, val);
+            split_given = true;
+        } else if (strcmp(key, "pte") == 0) {
+            ok = parse_size(val, &v); geo->pte_bytes = (int)v;
+        } else if (strcmp(key, "mem") == 0) {
+            ok = parse_size(val, &geo->mem_size);
+        } else if (strcmp(key, "tlb") == 0) {
+            ok = parse_size(val, &v); geo->tlb_size = (int)v;
+        } else if (strcmp(key, "tlb_ways") == 0) {
+            ok = parse_size(val, &v); geo->tlb_ways = (int)v;
+        } else if (strcmp(key, "l2tlb") == 0) {
+            ok = parse_size(val, &v); geo->l2_tlb_size = (int)v;
+        } else if (strcmp(key, "l2tlb_ways") == 0) {
+            ok = parse_size(val, &v); geo->l2_tlb_ways = (int)v;
+        } else if (strcmp(key, "tlb_policy") == 0 || strcmp(key, "l2tlb_policy") == 0) {
+            Policy pol;
+            ok = policy_parse(val, &pol) == 0 &&
+                 (pol == POLICY_RR || pol == POLICY_LRU || pol == POLICY_OPT);
+            geo->tlb_policy[key[0] == 'l' ? 1 : 0] = (int)pol;
+        } else if (strcmp(key, "tlb_asid") == 0) {
+            ok = parse_size(val, &v) && v <= 1; geo->tlb_asid = (int)v;
+        } else if (strcmp(key, "cores") == 0) {
+            ok = parse_size(val, &v); geo->cores = (int)v;
+        } else if (strcmp(key, "shootdown") == 0) {
+            ok = strcasecmp(val, "sync") == 0 || strcasecmp(val, "lazy") == 0;
+            geo->shootdown = strcasecmp(val, "lazy") == 0 ? SHOOTDOWN_LAZY : SHOOTDOWN_SYNC;
+        } else if (strcmp(key, "reclaim_batch") == 0) {
+            ok = parse_size(val, &v); geo->reclaim_batch = (int)v;
+        } else if (strcmp(key, "pwc") == 0) {
+            ok = parse_size(val, &v) && v <= PWC_MAX_ENTRIES; geo->pwc_entries = (int)v;
+        } else if (strcmp(key, "superpage") == 0) {
+            ok = parse_size(val, &v) && v < MAX_LEVELS; geo->superpage = (int)v;
+        } else if (strcmp(key, "sp_promote") == 0) {
+            ok = parse_size(val, &v) && v >= 1 && v <= 100; geo->sp_promote = (int)v;
+        } else if (strcmp(key, "prefetch") == 0) {
+            int i;
+            for (i = 0; i < PREFETCH_COUNT && strcasecmp(val, prefetch_names[i]) != 0; i++);
+            ok = i < PREFETCH_COUNT; geo->prefetch = i;
+        } else if (strcmp(key, "prefetch_depth") == 0) {
+            ok = parse_size(val, &v) && v >= 1 && v <= 64; geo->prefetch_depth = (int)v;
+        } else if (strcmp(key, "slow_mem") == 0) {
+            ok = parse_size(val, &geo->slow_mem_size);
+        } else if (strcmp(key, "tier_epoch") == 0) {
+            ok = parse_size(val, &v) && v >= 1 && v <= INT32_MAX; geo->tier_epoch = (int)v;
+        } else if (strcmp(key, "tier_batch") == 0) {
+            ok = parse_size(val, &v) && v >= 1 && v <= INT32_MAX; geo->tier_batch = (int)v;
+        } else if (strcmp(key, "tier_hot") == 0) {
+            ok = parse_size(val, &v) && v >= 1 && v <= INT32_MAX; geo->tier_hot = (int)v;
+        } else if (strcmp(key, "pt_reclaim") == 0) {
+            ok = parse_size(val, &v) && v <= 1; geo->pt_reclaim = (int)v;
+        } else if (strcmp(key, "prefetch_table") == 0) {
+            ok = parse_size(val, &v) && v >= 1 && v <= (1 << 24); geo->prefetch_table = (int)v;
+        } else if (strcmp(key, "lat_tlb") == 0 || strcmp(key, "lat_l2tlb") == 0) {
+            ok = parse_size(val, &v) && v <= INT32_MAX; geo->lat_tlb[key[4] == 'l' ? 1 : 0] = (int)v;
+        } else if (strcmp(key, "lat_pwc") == 0) {
+            ok = parse_size(val, &v) && v <= INT32_MAX; geo->lat_pwc = (int)v;
+        } else if (strcmp(key, "lat_mem") == 0) {
+            ok = parse_size(val, &v) && v <= INT32_MAX; geo->lat_mem = (int)v;
+        } else if (strcmp(key, "lat_fault") == 0) {
+            ok = parse_size(val, &v) && v <= INT32_MAX; geo->lat_fault = (int)v;
+        } else if (strcmp(key, "lat_swap") == 0) {
+            ok = parse_size(val, &v) && v <= INT32_MAX; geo->lat_swap = (int)v;
+        } else if (strcmp(key, "lat_slow") == 0) {
+            ok = parse_size(val, &v) && v <= INT32_MAX; geo->lat_slow = (int)v;
+        } else {
+            fprintf(stderr, "Unknown geometry key '%s'\n", key);
+            ret = -1;
+            continue;
+        }
+        if (!ok) {
+            fprintf(stderr, "Invalid value for geometry key '%s': %s\n", key, val);
+            ret = -1;
+        }
+    }
+    free(buf);
+
+    if (!split_given) {
+        memset(geo->level_bits, 0, sizeof(geo->level_bits));
+    }
+    if (ret == 0) {
+        ret = geometry_finalize(geo);
+    }
+    return ret;
+}
+
+static int log2_exact(uint64_t v) {
+    if (v == 0 || (v & (v - 1))) return -1;
+    return __builtin_ctzll(v);
+}
+
+// 엔트리 수가 연관도로 나누어떨어지고 set 수가 2의 거듭제곱이어야 함 (set = VPN 하위 비트)
+static int check_tlb_level(const char *name, int size, int ways) {
+    if (size < 0 || ways < 0) {
+        fprintf(stderr, "Geometry: invalid %s size\n", name);
+        return -1;
+    }
+    if (ways == 0) return 0; // fully associative
+    if (ways > size || size % ways != 0 || log2_exact((uint64_t)(size / ways)) < 0) {
+        fprintf(stderr, "Geometry: %s with %d entries cannot be %d-way "
+                        "(entries / ways must be a power of two)\n", name, size, ways);
+        return -1;
+    }
+    return 0;
+}
+
+int geometry_finalize(Geometry *geo) {
+    geo->offset_bits = log2_exact(geo->page_size);
+    if (geo->offset_bits < 1) {
+        fprintf(stderr, "Geometry: page size must be a power of two >= 2\n");
+        return -1;
+    }
+    if (geo->levels < 2 || geo->levels > MAX_LEVELS) {
+        fprintf(stderr, "Geometry: levels must be between 2 and %d\n", MAX_LEVELS);
+        return -1;
+    }
+    if (geo->va_bits <= geo->offset_bits || geo->va_bits > 64) {
+        fprintf(stderr, "Geometry: invalid address width %d\n", geo->va_bits);
+        return -1;
+    }
+    if (!(geo->pte_bytes == 1 || geo->pte_bytes == 2 || geo->pte_bytes == 4 || geo->pte_bytes == 8)) {
+        fprintf(stderr, "Geometry: PTE size must be 1, 2, 4 or 8 bytes\n");
+        return -1;
+    }
+
+    // 단계별 비트 수: 지정하지 않았으면 균등 분할 (나머지는 Root 가 가짐)
+    int vpn_bits = geo->va_bits - geo->offset_bits;
+    geo->vpn_bits = vpn_bits;
+    // 페이지 키는 TLB_TAG_INVALID / TLB_TAG_PAD 와 겹치지 않도록 62 비트 이내
+    geo->asid_bits = vpn_bits >= 62 ? 0 : (62 - vpn_bits < 16 ? 62 - vpn_bits : 16);
+    if (geo->level_bits[0] == 0) {
+        for (int l = 0; l < geo->levels; l++) {
+            geo->level_bits[l] = vpn_bits / geo->levels;
+        }
+        geo->level_bits[0] += vpn_bits % geo->levels;
+    }
+
+    int sum = 0;
+    for (int l = 0; l < geo->levels; l++) sum += geo->level_bits[l];
+    if (sum != vpn_bits) {
+        fprintf(stderr, "Geometry: level split covers %d bits, VPN has %d\n", sum, vpn_bits);
+        return -1;
+    }
+
+    // Leaf 가 가장 하위 비트 (Offset 바로 위)
+    int shift = geo->offset_bits;
+    for (int l = geo->levels - 1; l >= 0; l--) {
+        geo->level_shift[l] = shift;
+        shift += geo->level_bits[l];
+
+        // 테이블 하나가 프레임 하나에 들어가야 함
+        if ((1ULL << geo->level_bits[l]) * geo->pte_bytes > geo->page_size) {
+            fprintf(stderr, "Geometry: level %d table (%llu entries x %d bytes) exceeds page size\n",
+                    l + 1, 1ULL << geo->level_bits[l], geo->pte_bytes);
+            return -1;
+        }
+    }
+
+    geo->va_mask = geo->va_bits == 64 ? UINT64_MAX : (1ULL << geo->va_bits) - 1;
+    geo->offset_mask = geo->page_size - 1;
+
+    // [Tier] 느린 계층 프레임은 DRAM 프레임 뒤에 이어 붙임 (PFN 공간 하나)
+    if (geo->mem_size % geo->page_size != 0 || geo->slow_mem_size % geo->page_size != 0 ||
+        (geo->mem_size + geo->slow_mem_size) / geo->page_size > (1ULL << 31) - 1) {
+        fprintf(stderr, "Geometry: memory size must be a multiple of the page size (max 2^31 frames)\n");
+        return -1;
+    }
+    geo->fast_frames = (int)(geo->mem_size / geo->page_size);
+    geo->num_frames = (int)((geo->mem_size + geo->slow_mem_size) / geo->page_size);
+
+    // Swappable 비트마스크: 프레임당 1 bit, Frame 0 부터 연속 배치
+    uint64_t mask_bytes = ((uint64_t)geo->num_frames + 7) / 8;
+    geo->mask_frames = (int)((mask_bytes + geo->page_size - 1) / geo->page_size);
+    geo->root_pfn = geo->mask_frames;
+
+    geo->pte_present_mask = 1ULL << (geo->pte_bytes * 8 - 1);
+    geo->pte_pfn_mask = geo->pte_present_mask - 1;
+
+    if ((uint64_t)geo->num_frames - 1 > geo->pte_pfn_mask) {
+        fprintf(stderr, "Geometry: %d frames do not fit in a %d-byte PTE\n",
+                geo->num_frames, geo->pte_bytes);
+        return -1;
+    }
+    // Superpage 를 켜면 Present 바로 아래 비트가 Huge (PFN 이 그 비트까지 필요하면 설정 오류)
+    uint64_t flag = geo->pte_present_mask >> 1;
+    geo->pte_huge_mask = 0;
+    if (geo->superpage) {
+        if ((uint64_t)geo->num_frames - 1 > flag - 1) {
+            fprintf(stderr, "Geometry: no spare PTE bit for superpages (%d frames in a %d-byte PTE)\n",
+                    geo->num_frames, geo->pte_bytes);
+            return -1;
+        }
+        geo->pte_huge_mask = flag;
+        geo->pte_pfn_mask = flag - 1;
+        flag >>= 1;
+    }
+    // PFN 이 다음 비트를 쓰지 않으면 그 비트가 Dirty
+    geo->pte_dirty_mask = flag;
+    if ((uint64_t)geo->num_frames - 1 > geo->pte_dirty_mask - 1) {
+        geo->pte_dirty_mask = 0;
+    } else {
+        geo->pte_pfn_mask = geo->pte_dirty_mask - 1;
+    }
+    if (geo->fast_frames < geo->root_pfn + 2) {
+        fprintf(stderr, "Geometry: memory too small\n");
+        return -1;
+    }
+
+    // Superpage: sp_level 단계 PTE 하나가 그 아래 단계 전체 (2^sp_bits 페이지) 를 매핑
+    geo->sp_level = -1;
+    geo->sp_bits = 0;
+    if (geo->superpage) {
+        if (geo->superpage >= geo->levels) {
+            fprintf(stderr, "Geometry: superpage must be between 0 and %d (levels - 1)\n", geo->levels - 1);
+            return -1;
+        }
+        geo->sp_level = geo->levels - 1 - geo->superpage;
+        for (int l = geo->sp_level + 1; l < geo->levels; l++) geo->sp_bits += geo->level_bits[l];
+        // 예약 블록이 적어도 두 개 (첫 블록은 비트마스크 / Root 프레임이 차지)
+        if (geo->sp_bits > 30 || (uint64_t)geo->num_frames < (2ULL << geo->sp_bits)) {
+            fprintf(stderr, "Geometry: memory too small for %llu-page superpages\n", 1ULL << geo->sp_bits);
+            return -1;
+        }
+    }
+    if (geo->tlb_size < 1) {
+        fprintf(stderr, "Geometry: TLB needs at least one entry\n");
+        return -1;
+    }
+    if (check_tlb_level("L1 TLB", geo->tlb_size, geo->tlb_ways) != 0 ||
+        (geo->l2_tlb_size && check_tlb_level("L2 TLB", geo->l2_tlb_size, geo->l2_tlb_ways) != 0)) {
+        return -1;
+    }
+    if (geo->cores < 1 || geo->cores > MAX_CORES) {
+        fprintf(stderr, "Geometry: cores must be between 1 and %d\n", MAX_CORES);
+        return -1;
+    }
+    if (geo->slow_mem_size && geo->superpage) {
+        // 승격 / 강등이 페이지를 한 장씩 옮기므로 연속 블록을 유지할 수 없음
+        fprintf(stderr, "Geometry: slow_mem cannot be combined with superpages\n");
+        return -1;
+    }
+    if (geo->reclaim_batch < 1 || geo->reclaim_batch > geo->num_frames - geo->root_pfn - 1) {
+        fprintf(stderr, "Geometry: reclaim_batch must be between 1 and the data frame count\n");
+        return -1;
+    }
+    return 0;
+}
+
+void geometry_print(const Geometry *geo, FILE *fp) {
+    fprintf(fp, "[Geometry] VA %d-bit, page %llu B, %d levels (",
+            geo->va_bits, (unsigned long long)geo->page_size, geo->levels);
+    for (int l = 0; l < geo->levels; l++) {
+        fprintf(fp, "%s%d", l ? "/" : "", geo->level_bits[l]);
+    }
+    fprintf(fp, "), PTE %d B, memory %llu B (%d frames), TLB %d entries",
+            geo->pte_bytes, (unsigned long long)geo->mem_size, geo->fast_frames, geo->tlb_size);
+    if (geo->tlb_ways) fprintf(fp, " (%d-way)", geo->tlb_ways);
+    if (geo->l2_tlb_size) {
+        fprintf(fp, ", L2 TLB %d entries", geo->l2_tlb_size);
+        if (geo->l2_tlb_ways) fprintf(fp, " (%d-way)", geo->l2_tlb_ways);
+    }
+    if (!geo->tlb_asid) fprintf(fp, ", no ASID (flush on switch)");
+    if (geo->cores > 1) {
+        fprintf(fp, ", %d cores (%s shootdown)", geo->cores,
+                geo->shootdown == SHOOTDOWN_LAZY ? "lazy" : "sync");
+    }
+    if (geo->reclaim_batch > 1) fprintf(fp, ", reclaim batch %d", geo->reclaim_batch);
+    if (geo->pwc_entries) fprintf(fp, ", PWC %d entries/level", geo->pwc_entries);
+    if (geo->superpage) {
+        fprintf(fp, ", superpages %llu pages at level %d (promote at %d%%)",
+                1ULL << geo->sp_bits, geo->sp_level + 1, geo->sp_promote);
+    }
+    if (geo->prefetch != PREFETCH_NONE) {
+        fprintf(fp, ", %s prefetch (depth %d", prefetch_names[geo->prefetch], geo->prefetch_depth);
+        if (geo->prefetch == PREFETCH_MARKOV) fprintf(fp, ", %d-entry table", geo->prefetch_table);
+        fprintf(fp, ")");
+    }
+    if (geo->pt_reclaim) fprintf(fp, ", page table reclaim");
+    if (geo->slow_mem_size) {
+        fprintf(fp, ", slow tier %llu B (%d frames, %d cycles; every %d accesses promote up to %d pages with heat >= %d)",
+                (unsigned long long)geo->slow_mem_size, geo->num_frames - geo->fast_frames, geo->lat_slow,
+                geo->tier_epoch, geo->tier_batch, geo->tier_hot);
+    }
+    if (!geo->pte_dirty_mask) fprintf(fp, ", no PTE dirty bit (tracked per frame)");
+    fprintf(fp, "\n");
+}
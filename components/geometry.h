@@ -0,0 +1,28 @@
+/* geometry.h */
+#ifndef GEOMETRY_H
+#define GEOMETRY_H
+
+#include <stdio.h>
+#include "../common.h"
+
+// 프리셋 이름 또는 key=value 목록으로 Geometry 설정
+// 예) "12bit", "x86-64", "x86-64,mem=4G,tlb=64", "va=32,page=4096,levels=2,pte=4,mem=256M"
+//     "x86-64,tlb=64,tlb_ways=4,l2tlb=1024,l2tlb_ways=8,l2tlb_policy=RR" (L1/L2 TLB)
+//     "x86-64,tlb_asid=0" (ASID 없는 TLB: 문맥 교환마다 전체 flush)
+//     "x86-64,cores=4,shootdown=lazy,reclaim_batch=32" (코어별 TLB + shootdown 방식)
+//     "x86-64,pwc=16,lat_mem=200,lat_swap=1M" (Page Walk Cache + 지연 시간 모델, 단위 cycle)
+//     "12bit,pt_reclaim=1" (빈 PD2 / PT 프레임 회수)
+//     "x86-64,mem=1G,slow_mem=4G,lat_slow=300,tier_epoch=100000" (DRAM + 느린 계층, 뜨거운 페이지 승격)
+// 프리셋 없이 key=value 만 주면 12bit 프리셋 위에 덮어씀
+// 성공 0, 실패 -1 (에러 메시지는 stderr)
+int geometry_parse(Geometry *geo, const char *spec);
+
+// 기본 12-bit 프리셋
+void geometry_default(Geometry *geo);
+
+// 파생값 계산 및 검증. 성공 0, 실패 -1
+int geometry_finalize(Geometry *geo);
+
+void geometry_print(const Geometry *geo, FILE *fp);
+
+#endif
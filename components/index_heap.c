@@ -0,0 +1,105 @@
+/* index_heap.c */
+#include "index_heap.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+void heap_init(IndexHeap *h, int capacity) {
+    h->heap = malloc(sizeof(int) * capacity);
+    h->pos = malloc(sizeof(int) * capacity);
+    h->key = calloc(capacity, sizeof(uint64_t));
+    if (!h->heap || !h->pos || !h->key) {
+        perror("malloc index heap");
+        exit(1);
+    }
+    memset(h->pos, 0xff, sizeof(int) * capacity); // -1
+    h->size = 0;
+    h->capacity = capacity;
+}
+
+void heap_destroy(IndexHeap *h) {
+    free(h->heap);
+    free(h->pos);
+    free(h->key);
+    memset(h, 0, sizeof(*h));
+}
+
+// (key, idx) 사전식 비교: 같은 key 면 큰 인덱스가 위 (결과가 실행마다 같도록)
+static inline bool above(const IndexHeap *h, int a, int b) {
+    return h->key[a] > h->key[b] || (h->key[a] == h->key[b] && a > b);
+}
+
+static inline void place(IndexHeap *h, int k, int idx) {
+    h->heap[k] = idx;
+    h->pos[idx] = k;
+}
+
+static void sift_up(IndexHeap *h, int k) {
+    int idx = h->heap[k];
+    while (k > 0) {
+        int parent = (k - 1) / 2;
+        if (!above(h, idx, h->heap[parent])) break;
+        place(h, k, h->heap[parent]);
+        k = parent;
+    }
+    place(h, k, idx);
+}
+
+static void sift_down(IndexHeap *h, int k) {
+    int idx = h->heap[k];
+    while (1) {
+        int child = 2 * k + 1;
+        if (child >= h->size) break;
+        if (child + 1 < h->size && above(h, h->heap[child + 1], h->heap[child])) child++;
+        if (!above(h, h->heap[child], idx)) break;
+        place(h, k, h->heap[child]);
+        k = child;
+    }
+    place(h, k, idx);
+}
+
+void heap_update(IndexHeap *h, int idx, uint64_t key) {
+    int k = h->pos[idx];
+    if (k < 0) {
+        h->key[idx] = key;
+        place(h, h->size++, idx);
+        sift_up(h, h->size - 1);
+        return;
+    }
+
+    uint64_t old = h->key[idx];
+    h->key[idx] = key;
+    if (key >= old) sift_up(h, k);
+    else sift_down(h, k);
+}
+
+void heap_remove(IndexHeap *h, int idx) {
+    int k = h->pos[idx];
+    if (k < 0) return;
+
+    h->pos[idx] = -1;
+    int last = h->heap[--h->size];
+    if (k == h->size) return;
+
+    place(h, k, last);
+    sift_up(h, k);
+    sift_down(h, h->pos[last]);
+}
+
+void heap_exchange(IndexHeap *h, int a, int b) {
+    int ka = h->pos[a], kb = h->pos[b];
+    uint64_t key = h->key[a];
+    h->key[a] = h->key[b];
+    h->key[b] = key;
+    h->pos[a] = -1;
+    h->pos[b] = -1;
+    if (ka >= 0) place(h, ka, b);
+    if (kb >= 0) place(h, kb, a);
+    // key 는 자리를 따라갔으므로 어긋날 수 있는 것은 같은 key 사이의 인덱스 순서뿐
+    int moved[2] = { a, b };
+    for (int i = 0; i < 2; i++) {
+        if (h->pos[moved[i]] < 0) continue;
+        sift_up(h, h->pos[moved[i]]);
+        sift_down(h, h->pos[moved[i]]);
+    }
+}
@@ -0,0 +1,31 @@
+/* index_heap.h */
+#ifndef INDEX_HEAP_H
+#define INDEX_HEAP_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// --- 인덱스 기반 최대 힙 (우선순위 큐) ---
+// 프레임 번호(PFN) 또는 TLB way 를 노드로 사용, pos[] 로 임의 노드의 key 변경/삭제도 O(log n)
+// [OPT] key = 다음 사용 시점 -> top 이 가장 늦게 다시 쓰이는 Victim
+typedef struct {
+    int *heap;       // heap[k] = 노드 인덱스
+    int *pos;        // pos[idx] = heap 내 위치 (-1 = 없음)
+    uint64_t *key;   // key[idx]
+    int size;
+    int capacity;
+} IndexHeap;
+
+void heap_init(IndexHeap *h, int capacity);
+void heap_destroy(IndexHeap *h);
+
+// 없으면 삽입, 있으면 key 변경
+void heap_update(IndexHeap *h, int idx, uint64_t key);
+void heap_remove(IndexHeap *h, int idx);
+// 노드 a 와 b 의 자리와 key 를 맞바꿈 (없는 쪽은 없는 채로 넘어감, 같은 key 의 인덱스 순서는 다시 맞춤)
+void heap_exchange(IndexHeap *h, int a, int b);
+
+static inline bool heap_contains(const IndexHeap *h, int idx) { return h->pos[idx] >= 0; }
+static inline int heap_top(const IndexHeap *h) { return h->size ? h->heap[0] : -1; }
+
+#endif
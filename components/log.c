@@ -1,41 +1,193 @@
 #include "log.h"
+#include "profile.h"
 #include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
 
-FILE *log_fp;
+// [Buffer] 이벤트마다 fprintf 하지 않고 큰 사용자 버퍼에 모았다가 한 번에 fwrite
+#define LOG_BUF_SIZE (1 << 20) // 1 MiB
+#define LOG_BUF_SLACK 128      // 이벤트 하나의 최대 길이보다 넉넉하게
 
-void open_log_file(const char *filename)
+static const char *event_names[EV_COUNT] = {
+    "Access VA", "TLB Hit", "TLB Miss", "Page Table Hit",
+    "Page Table Miss", "Page Table Update", "TLB Update", "PA"
+};
+
+static void flush_log_buffer(Logger *lg) {
+    if (lg->fp && lg->buf_len > 0) {
+        fwrite(lg->buf, 1, lg->buf_len, lg->fp);
+    }
+    lg->buf_len = 0;
+}
+
+void open_log_file(Logger *lg, const char *filename)
+{
+    open_log_file_ex(lg, filename, LOG_LEVEL_FULL, LOG_FORMAT_TEXT, sizeof(uint16_t));
+}
+
+void open_log_file_ex(Logger *lg, const char *filename, int level, LogFormat format, int value_bytes)
 { 
+    memset(lg, 0, sizeof(*lg));
+    lg->level = level;
+    lg->format = format;
+    lg->value_bytes = value_bytes;
+
     if(strcmp(filename, "stdout") == 0){
-        log_fp = stdout; 
+        lg->fp = stdout; 
         
     }
     else{
-        log_fp = fopen(filename, "w"); 
-        if (!log_fp) {
+        lg->fp = fopen(filename, format == LOG_FORMAT_BINARY ? "wb" : "w"); 
+        if (!lg->fp) {
             perror("fopen log_fp");
             exit(1);
         }
     }
+
+    lg->buf = malloc(LOG_BUF_SIZE);
+    if (!lg->buf) {
+        perror("malloc log buffer");
+        exit(1);
+    }
+
+    if (format == LOG_FORMAT_BINARY && level == LOG_LEVEL_FULL) {
+        LogBinHeader hdr;
+        memset(&hdr, 0, sizeof(hdr));
+        memcpy(hdr.magic, LOG_BIN_MAGIC, sizeof(hdr.magic));
+        hdr.version = LOG_BIN_VERSION;
+        hdr.value_bytes = (uint8_t)value_bytes;
+        memcpy(lg->buf, &hdr, sizeof(hdr));
+        lg->buf_len = sizeof(hdr);
+    }
 }
-void close_log_file() 
+
+// [Summary] 종료 시 이벤트 횟수 요약
+static void write_summary(Logger *lg) {
+    FILE *out = (lg->format == LOG_FORMAT_TEXT) ? lg->fp : stderr;
+    if (out == lg->fp) flush_log_buffer(lg);
+
+    fprintf(out, "=== Summary ===\n");
+    for (int i = 0; i < EV_COUNT; i++) {
+        fprintf(out, "%s: %llu\n", event_names[i], (unsigned long long)lg->counts[i]);
+    }
+}
+
+void close_log_file(Logger *lg) 
 {
-    if (log_fp == stdout){
-        return;
+    if (!lg->fp) return;
+
+    if (lg->level == LOG_LEVEL_SUMMARY) {
+        write_summary(lg);
+    }
+    flush_log_buffer(lg);
+    free(lg->buf);
+    lg->buf = NULL;
+
+    if (lg->fp == stdout){
+        fflush(stdout);
     }
-    if (log_fp){ 
-        if(ferror(log_fp)){
+    else { 
+        if(ferror(lg->fp)){
             fprintf(stderr, "File write error occurred before fclose\n");
         }
-        fclose(log_fp); 
+        fclose(lg->fp); 
+    }
+    lg->fp = NULL;
+    lg->level = LOG_LEVEL_NONE;
+}
+
+int log_event_operands(LogEvent ev) {
+    switch (ev) {
+        case EV_VA_ACCESS:
+        case EV_TLB_MISS:
+        case EV_PT_MISS:
+        case EV_PA_RESULT:
+            return 1;
+        default:
+            return 2;
+    }
+}
+
+// "0x%03x" 와 동일한 출력 (최소 3자리 소문자 hex)
+static char* put_hex(char *p, uint64_t v) {
+    static const char digits[] = "0123456789abcdef";
+    char tmp[16];
+    int n = 0;
+    do {
+        tmp[n++] = digits[v & 0xF];
+        v >>= 4;
+    } while (v);
+    while (n < 3) tmp[n++] = '0';
+
+    *p++ = '0';
+    *p++ = 'x';
+    while (n > 0) *p++ = tmp[--n];
+    return p;
+}
+
+static char* put_str(char *p, const char *s) {
+    size_t n = strlen(s);
+    memcpy(p, s, n);
+    return p + n;
+}
+
+// 텍스트 한 줄 포맷 (기존 fprintf 포맷과 글자 단위로 동일해야 함)
+static char* format_event(char *p, LogEvent ev, uint64_t a, uint64_t b) {
+    switch (ev) {
+        case EV_VA_ACCESS:
+            p = put_str(p, "Access VA: "); p = put_hex(p, a); *p++ = '\n';
+            break;
+        case EV_TLB_HIT:
+            p = put_str(p, "TLB Hit: VPN "); p = put_hex(p, a);
+            p = put_str(p, " -> PFN "); p = put_hex(p, b); *p++ = '\n';
+            break;
+        case EV_TLB_MISS:
+            p = put_str(p, "TLB Miss: VPN "); p = put_hex(p, a); *p++ = '\n';
+            break;
+        case EV_PT_HIT:
+            p = put_str(p, "Page Table Hit: VPN "); p = put_hex(p, a);
+            p = put_str(p, " -> PFN "); p = put_hex(p, b); *p++ = '\n';
+            break;
+        case EV_PT_MISS:
+            p = put_str(p, "Page Table Miss: VPN "); p = put_hex(p, a); *p++ = '\n';
+            break;
+        case EV_PT_UPDATE:
+            p = put_str(p, "Page Table Update: VPN "); p = put_hex(p, a);
+            p = put_str(p, " -> PFN "); p = put_hex(p, b); *p++ = '\n';
+            break;
+        case EV_TLB_UPDATE:
+            p = put_str(p, "TLB Update: VPN "); p = put_hex(p, a);
+            p = put_str(p, " -> PFN "); p = put_hex(p, b); *p++ = '\n';
+            break;
+        case EV_PA_RESULT:
+            p = put_str(p, "PA: "); p = put_hex(p, a); *p++ = '\n'; *p++ = '\n';
+            break;
+        default:
+            break;
+    }
+    return p;
+}
+
+void log_event(Logger *lg, LogEvent ev, uint64_t a, uint64_t b) {
+    lg->counts[ev]++;
+    if (lg->level < LOG_LEVEL_FULL) return;
+    PROF_ENTER(PROF_LOG);
+
+    if (lg->buf_len + LOG_BUF_SLACK > LOG_BUF_SIZE) {
+        flush_log_buffer(lg);
+    }
+
+    char *p = lg->buf + lg->buf_len;
+    if (lg->format == LOG_FORMAT_BINARY) {
+        // little-endian 호스트 가정: 하위 value_bytes 바이트만 기록
+        *p++ = (char)ev;
+        memcpy(p, &a, lg->value_bytes); p += lg->value_bytes;
+        if (log_event_operands(ev) == 2) {
+            memcpy(p, &b, lg->value_bytes); p += lg->value_bytes;
+        }
+    } else {
+        p = format_event(p, ev, a, b);
     }
+    lg->buf_len = p - lg->buf;
+    PROF_EXIT(PROF_LOG);
 }
-void log_va_access(uint16_t va) { fprintf(log_fp, "Access VA: 0x%03x\n", va); }
-void log_tlb_hit(uint16_t vpn, uint16_t pfn) { fprintf(log_fp, "TLB Hit: VPN 0x%03x -> PFN 0x%03x\n", vpn, pfn); }
-void log_tlb_miss(uint16_t vpn) { fprintf(log_fp, "TLB Miss: VPN 0x%03x\n", vpn); }
-void log_pt_hit(uint16_t vpn, uint16_t pfn) { fprintf(log_fp, "Page Table Hit: VPN 0x%03x -> PFN 0x%03x\n", vpn, pfn); }
-void log_pt_miss(uint16_t vpn) { fprintf(log_fp, "Page Table Miss: VPN 0x%03x\n", vpn); }
-void log_pt_update(uint16_t vpn, uint16_t pfn) { fprintf(log_fp, "Page Table Update: VPN 0x%03x -> PFN 0x%03x\n", vpn, pfn); }
-void log_tlb_update(uint16_t vpn, uint16_t pfn) { fprintf(log_fp, "TLB Update: VPN 0x%03x -> PFN 0x%03x\n", vpn, pfn); }
-void log_pa_result(uint16_t pa) { fprintf(log_fp, "PA: 0x%03x\n\n", pa); }
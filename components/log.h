@@ -1,18 +1,87 @@
 #ifndef LOG_H
 #define LOG_H
 
+#include <stdio.h>
 #include <stdint.h>
 #include <stdbool.h>
 
-void open_log_file(const char *filename);
-void close_log_file();
-void log_va_access(uint16_t va);
-void log_tlb_hit(uint16_t vpn, uint16_t pfn);
-void log_tlb_miss(uint16_t vpn);
-void log_pt_hit(uint16_t vpn, uint16_t pfn);
-void log_pt_miss(uint16_t vpn);
-void log_pt_update(uint16_t vpn, uint16_t pfn);
-void log_tlb_update(uint16_t vpn, uint16_t pfn);
-void log_pa_result(uint16_t pa);
+// --- 로그 레벨 ---
+// NONE: 아무것도 기록하지 않음 (hot path 에는 분기 하나만 남음)
+// SUMMARY: 이벤트 종류별 횟수만 세고 종료 시 요약 출력
+// FULL: 모든 변환 단계를 기록 (기존 출력과 동일)
+#define LOG_LEVEL_NONE    0
+#define LOG_LEVEL_SUMMARY 1
+#define LOG_LEVEL_FULL    2
+
+// 컴파일 타임 상한: -DLOG_MAX_LEVEL=0 으로 빌드하면 로그 호출이 통째로 제거됨
+#ifndef LOG_MAX_LEVEL
+#define LOG_MAX_LEVEL LOG_LEVEL_FULL
+#endif
+
+// --- 로그 포맷 ---
+typedef enum {
+    LOG_FORMAT_TEXT,   // 사람이 읽는 텍스트 (기본값)
+    LOG_FORMAT_BINARY  // 이벤트 레코드 (tools/log_decode 로 텍스트 복원)
+} LogFormat;
+
+// --- 이벤트 종류 (바이너리 레코드의 type 바이트) ---
+typedef enum {
+    EV_VA_ACCESS,
+    EV_TLB_HIT,
+    EV_TLB_MISS,
+    EV_PT_HIT,
+    EV_PT_MISS,
+    EV_PT_UPDATE,
+    EV_TLB_UPDATE,
+    EV_PA_RESULT,
+    EV_COUNT
+} LogEvent;
+
+// --- 바이너리 로그 포맷 ---
+// | Header (8 Bytes) | Record ... |
+// Record: type (1 Byte) + 피연산자 (이벤트별 1~2개, 각 value_bytes 폭, little-endian)
+#define LOG_BIN_MAGIC "MLOG"
+#define LOG_BIN_VERSION 1
+
+typedef struct {
+    char magic[4];       // "MLOG"
+    uint16_t version;    // LOG_BIN_VERSION
+    uint8_t value_bytes; // 피연산자 폭
+    uint8_t reserved;
+} LogBinHeader;
+
+// --- 로거 (시뮬레이터 인스턴스마다 하나) ---
+// 0 으로 초기화된 Logger 는 LOG_LEVEL_NONE 이므로 열지 않아도 안전함
+typedef struct {
+    FILE *fp;
+    int level;
+    LogFormat format;
+    int value_bytes;
+    char *buf;                  // 사용자 공간 출력 버퍼
+    size_t buf_len;
+    uint64_t counts[EV_COUNT];  // [Summary] 이벤트 종류별 횟수
+} Logger;
+
+void open_log_file(Logger *lg, const char *filename);
+// value_bytes: 바이너리 레코드의 피연산자 폭 (주소/PFN 이 들어가는 최소 바이트 수)
+void open_log_file_ex(Logger *lg, const char *filename, int level, LogFormat format, int value_bytes);
+void close_log_file(Logger *lg);
+
+// 이벤트의 피연산자 개수 (EV_VA_ACCESS, EV_TLB_MISS, EV_PT_MISS, EV_PA_RESULT 는 1개)
+int log_event_operands(LogEvent ev);
+
+// 실제 기록 (out-of-line). 아래 inline 래퍼를 통해서만 호출됨
+void log_event(Logger *lg, LogEvent ev, uint64_t a, uint64_t b);
+
+#define LOG_ENABLED(lg) (LOG_MAX_LEVEL > LOG_LEVEL_NONE && (lg)->level > LOG_LEVEL_NONE)
+
+static inline void log_va_access(Logger *lg, uint64_t va) { if (LOG_ENABLED(lg)) log_event(lg, EV_VA_ACCESS, va, 0); }
+static inline void log_tlb_hit(Logger *lg, uint64_t vpn, uint64_t pfn) { if (LOG_ENABLED(lg)) log_event(lg, EV_TLB_HIT, vpn, pfn); }
+static inline void log_tlb_miss(Logger *lg, uint64_t vpn) { if (LOG_ENABLED(lg)) log_event(lg, EV_TLB_MISS, vpn, 0); }
+static inline void log_pt_hit(Logger *lg, uint64_t vpn, uint64_t pfn) { if (LOG_ENABLED(lg)) log_event(lg, EV_PT_HIT, vpn, pfn); }
+static inline void log_pt_miss(Logger *lg, uint64_t vpn) { if (LOG_ENABLED(lg)) log_event(lg, EV_PT_MISS, vpn, 0); }
+static inline void log_pt_update(Logger *lg, uint64_t vpn, uint64_t pfn) { if (LOG_ENABLED(lg)) log_event(lg, EV_PT_UPDATE, vpn, pfn); }
+static inline void log_tlb_update(Logger *lg, uint64_t vpn, uint64_t pfn) { if (LOG_ENABLED(lg)) log_event(lg, EV_TLB_UPDATE, vpn, pfn); }
+static inline void log_pa_result(Logger *lg, uint64_t pa) { if (LOG_ENABLED(lg)) log_event(lg, EV_PA_RESULT, pa, 0); }
 
 #endif
@@ -0,0 +1,111 @@
+/* lru_list.c */
+#include "lru_list.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+void lru_init(LRUList *l, int capacity) {
+    l->prev = malloc(sizeof(int) * capacity);
+    l->next = malloc(sizeof(int) * capacity);
+    l->linked = malloc(sizeof(bool) * capacity);
+    if (!l->prev || !l->next || !l->linked) {
+        perror("malloc lru list");
+        exit(1);
+    }
+    l->capacity = capacity;
+    lru_reset(l);
+}
+
+void lru_destroy(LRUList *l) {
+    free(l->prev);
+    free(l->next);
+    free(l->linked);
+    memset(l, 0, sizeof(*l));
+}
+
+void lru_reset(LRUList *l) {
+    memset(l->linked, 0, sizeof(bool) * l->capacity);
+    l->head = LRU_NIL;
+    l->tail = LRU_NIL;
+    l->size = 0;
+}
+
+void lru_remove(LRUList *l, int idx) {
+    if (!l->linked[idx]) return;
+
+    int p = l->prev[idx];
+    int n = l->next[idx];
+    if (p != LRU_NIL) l->next[p] = n; else l->head = n;
+    if (n != LRU_NIL) l->prev[n] = p; else l->tail = p;
+
+    l->linked[idx] = false;
+    l->size--;
+}
+
+// after 뒤에 idx 연결 (after == LRU_NIL 이면 맨 앞)
+static void link_after(LRUList *l, int idx, int after) {
+    int n = (after == LRU_NIL) ? l->head : l->next[after];
+
+    l->prev[idx] = after;
+    l->next[idx] = n;
+    if (after != LRU_NIL) l->next[after] = idx; else l->head = idx;
+    if (n != LRU_NIL) l->prev[n] = idx; else l->tail = idx;
+
+    l->linked[idx] = true;
+    l->size++;
+}
+
+void lru_push_tail(LRUList *l, int idx) {
+    lru_remove(l, idx);
+    link_after(l, idx, l->tail);
+}
+
+void lru_exchange(LRUList *l, int a, int b) {
+    if (a == b) return;
+    bool la = l->linked[a], lb = l->linked[b];
+    int pa = la ? l->prev[a] : LRU_NIL, pb = lb ? l->prev[b] : LRU_NIL;
+    if (la && lb && pa == b) {
+        // ... b a ... -> ... a b ...
+        lru_remove(l, a);
+        link_after(l, a, pb);
+    } else if (la && lb && pb == a) {
+        lru_remove(l, b);
+        link_after(l, b, pa);
+    } else {
+        // 떨어져 있으면 서로의 앞 노드는 그대로이므로 빼고 그 뒤에 다시 연결
+        lru_remove(l, a);
+        lru_remove(l, b);
+        if (la) link_after(l, b, pa);
+        if (lb) link_after(l, a, pb);
+    }
+}
+
+// (key, idx) 사전식 비교: a 가 b 보다 먼저(오래된 쪽)이면 true
+static inline bool before(const uint64_t *key, int a, int b) {
+    return key[a] < key[b] || (key[a] == key[b] && a < b);
+}
+
+void lru_insert_sorted(LRUList *l, int idx, const uint64_t *key) {
+    lru_remove(l, idx);
+
+    if (l->tail == LRU_NIL || !before(key, idx, l->tail)) {
+        link_after(l, idx, l->tail);
+        return;
+    }
+
+    if (key[idx] >= key[l->tail]) {
+        // tail 쪽에서 앞으로 이동
+        int cur = l->tail;
+        while (cur != LRU_NIL && before(key, idx, cur)) cur = l->prev[cur];
+        link_after(l, idx, cur);
+    } else {
+        // head 쪽에서 뒤로 이동
+        int after = LRU_NIL;
+        int cur = l->head;
+        while (cur != LRU_NIL && before(key, cur, idx)) {
+            after = cur;
+            cur = l->next[cur];
+        }
+        link_after(l, idx, after);
+    }
+}
@@ -0,0 +1,44 @@
+/* lru_list.h */
+#ifndef LRU_LIST_H
+#define LRU_LIST_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// --- 인덱스 기반 intrusive 이중 연결 리스트 ---
+// 프레임 번호(PFN) 또는 TLB 엔트리 인덱스를 노드로 사용
+// head = 가장 오래 전에 접근 (LRU Victim), tail = 가장 최근 접근
+#define LRU_NIL (-1)
+
+typedef struct {
+    int *prev;
+    int *next;
+    bool *linked;
+    int head;
+    int tail;
+    int capacity;
+    int size;
+} LRUList;
+
+void lru_init(LRUList *l, int capacity);
+void lru_destroy(LRUList *l);
+void lru_reset(LRUList *l);
+
+void lru_remove(LRUList *l, int idx);
+void lru_push_tail(LRUList *l, int idx);
+// a 와 b 의 리스트 위치를 맞바꿈 (하나만 연결되어 있으면 다른 쪽이 그 자리를 이어받음)
+void lru_exchange(LRUList *l, int a, int b);
+
+// (key[idx], idx) 오름차순 위치에 삽입
+// 기존 선형 탐색의 "가장 작은 시간, 같으면 가장 작은 인덱스" 선택과 동일한 순서를 유지
+// 새 key 가 tail 이상이면 tail 쪽에서, 아니면 head 쪽에서 위치를 찾음
+// 비용은 찾기 시작한 끝에서 들어갈 위치까지의 노드 수 (최악 O(n))
+// O(1) 인 경우: 접근 갱신 (최신 시간 -> tail), Victim 자리 재할당 (최소 시간 -> head)
+// 그 밖에 오래된 시간으로 다시 들어오는 프레임 (reclaim_batch > 1 로 먼저 비운 프레임의 재사용,
+// Superpage 승격으로 옮긴 페이지) 은 중간 위치까지 head 쪽에서 걸어감
+void lru_insert_sorted(LRUList *l, int idx, const uint64_t *key);
+
+static inline bool lru_contains(const LRUList *l, int idx) { return l->linked[idx]; }
+static inline int lru_head(const LRUList *l) { return l->head; }
+
+#endif
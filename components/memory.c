@@ -1,22 +1,20 @@
 /* memory.c */
 #include "memory.h"
+#include "swap.h"
+#include "sim.h"
+#include "superpage.h"
 #include <string.h>
 #include <stdio.h>
+#include <stdlib.h>
 
-uint8_t physical_memory[MEM_SIZE];
-
-// [Reverse Mapping] PFN -> VPN 매핑 정보 저장
-// Swap Out 시 해당 VPN의 PTE/TLB를 무효화하기 위함
-static uint16_t frame_owner_vpn[NUM_FRAMES];
-
-// [Internal] 비트마스크 조작 (물리 메모리 0~15번지 직접 액세스)
+// [Internal] 비트마스크 조작 (물리 메모리 Frame 0 ~ mask_frames-1 직접 액세스)
 // 0: Non-swappable, 1: Swappable
-static void set_swappable_bit(int pfn, bool swappable) {
-    int byte_idx = pfn / 8; // 0 or 1 (since pfn 0~127 -> 16 bytes)
+static void write_swappable_bit(SimContext *ctx, int pfn, bool swappable) {
+    int byte_idx = pfn / 8; // 12bit 프리셋: 0~15 (Frame 0, 1)
     int bit_idx = pfn % 8;
     
-    // 비트마스크는 Frame 0, 1에 위치함
-    uint8_t *mask_byte = &physical_memory[byte_idx];
+    // 비트마스크는 Frame 0 부터 위치함
+    uint8_t *mask_byte = &ctx->mem.physical_memory[byte_idx];
     
     if (swappable) {
         *mask_byte |= (1 << bit_idx);
@@ -25,48 +23,239 @@ static void set_swappable_bit(int pfn, bool swappable) {
     }
 }
 
+static void set_swappable_bit(SimContext *ctx, int pfn, bool swappable) {
+    write_swappable_bit(ctx, pfn, swappable);
+    notify_swappable_change(ctx, pfn, swappable);
+}
+
+bool is_frame_swappable(SimContext *ctx, int pfn) {
+    return (ctx->mem.physical_memory[pfn / 8] >> (pfn % 8)) & 1;
+}
+
+// [Free Bitmap] 64 프레임을 한 word 로 묶어 ctz 로 가장 낮은 PFN 을 찾음
+static inline void mark_allocated(MemoryState *m, int pfn) {
+    m->frame_free_mask[pfn / 64] &= ~(1ULL << (pfn % 64));
+}
+
+static inline void mark_free(MemoryState *m, int pfn) {
+    m->frame_free_mask[pfn / 64] |= (1ULL << (pfn % 64));
+    if (pfn / 64 < m->free_hint_word) {
+        m->free_hint_word = pfn / 64;
+    }
+}
+
+void init_memory(SimContext *ctx) {
+    MemoryState *m = &ctx->mem;
+    int num_frames = ctx->geo.num_frames;
+
+    // 큰 메모리도 calloc 이면 실제로 접근한 페이지만 OS 가 할당함
+    destroy_memory(ctx);
+    m->free_mask_words = (num_frames + 63) / 64;
+    m->physical_memory = calloc((size_t)num_frames, ctx->geo.page_size);
+    m->frame_owner_vpn = calloc(num_frames, sizeof(uint64_t));
+    m->frame_free_mask = calloc(m->free_mask_words, sizeof(uint64_t));
+    if (ctx->geo.superpage) m->frame_reserved_mask = calloc(m->free_mask_words, sizeof(uint64_t));
+    if (!ctx->geo.pte_dirty_mask) m->frame_dirty_mask = calloc(m->free_mask_words, sizeof(uint64_t));
+    if (!m->physical_memory || !m->frame_owner_vpn || !m->frame_free_mask ||
+        (ctx->geo.superpage && !m->frame_reserved_mask) || (!ctx->geo.pte_dirty_mask && !m->frame_dirty_mask)) {
+        perror("malloc physical memory");
+        exit(1);
+    }
+
+    // 마지막 word 의 범위 밖 비트는 0 으로 남겨둠
+    for (int w = 0; w < m->free_mask_words; w++) {
+        int bits = (w == m->free_mask_words - 1 && num_frames % 64) ? num_frames % 64 : 64;
+        m->frame_free_mask[w] = bits == 64 ? UINT64_MAX : (1ULL << bits) - 1;
+    }
+    m->free_hint_word = 0;
 
-static bool frame_allocated[NUM_FRAMES];
+    // [Spec] Frame 0 ~ mask_frames-1: Bitmask 저장용 (Allocated, Non-swappable)
+    // [Spec] Frame root_pfn: Root Page Directory (Allocated, Non-swappable)
+    // 12bit 프리셋: Frame 0, 1 = Bitmask, Frame 2 = Root
+    for (int i = 0; i <= ctx->geo.root_pfn; i++) {
+        mark_allocated(m, i); set_swappable_bit(ctx, i, false);
+    }
+}
 
-void init_memory() {
-    memset(physical_memory, 0, MEM_SIZE);
-    memset(frame_allocated, 0, sizeof(frame_allocated));
-    memset(frame_owner_vpn, 0, sizeof(frame_owner_vpn));
+void destroy_memory(SimContext *ctx) {
+    MemoryState *m = &ctx->mem;
+    free(m->physical_memory);
+    free(m->frame_owner_vpn);
+    free(m->frame_free_mask);
+    free(m->frame_reserved_mask);
+    free(m->frame_dirty_mask);
+    memset(m, 0, sizeof(*m));
+}
 
-    // [Spec] Frame 0, 1: Bitmask 저장용 (Allocated, Non-swappable)
-    frame_allocated[0] = true; set_swappable_bit(0, false);
-    frame_allocated[1] = true; set_swappable_bit(1, false);
+static void init_frame(SimContext *ctx, int pfn, uint64_t vpn, bool is_swappable) {
+    ctx->mem.frame_owner_vpn[pfn] = vpn; // 소유주 등록 (교체 정책이 적재 시 VPN 을 참조하므로 먼저)
+    set_swappable_bit(ctx, pfn, is_swappable);
+    set_frame_dirty(ctx, pfn, false);
 
-    // [Spec] Frame 2: Root Page Directory (Allocated, Non-swappable)
-    frame_allocated[2] = true; set_swappable_bit(2, false);
+    // 메모리 0으로 초기화
+    memset(get_frame_ptr(ctx, pfn), 0, ctx->geo.page_size);
 }
 
-int allocate_free_frame(uint16_t vpn, bool is_swappable) {
-    // 1. 빈 프레임 탐색 (Frame 3부터 시작)
-    for (int i = 3; i < NUM_FRAMES; i++) {
-        if (!frame_allocated[i]) {
-            frame_allocated[i] = true;
-            set_swappable_bit(i, is_swappable);
-            frame_owner_vpn[i] = vpn; // 소유주 등록
-            
-            // 메모리 0으로 초기화
-            memset(&physical_memory[i * FRAME_SIZE], 0, FRAME_SIZE);
-            return i;
+int allocate_free_frame(SimContext *ctx, uint64_t vpn, bool is_swappable) {
+    MemoryState *m = &ctx->mem;
+
+    // 1. 빈 프레임 탐색 (가장 낮은 PFN 우선, Bitmask/Root 프레임은 항상 Allocated)
+    for (int w = m->free_hint_word; w < m->free_mask_words; w++) {
+        if (m->frame_free_mask[w] == 0) continue;
+
+        int i = w * 64 + __builtin_ctzll(m->frame_free_mask[w]);
+        m->free_hint_word = w;
+
+        mark_allocated(m, i);
+        init_frame(ctx, i, vpn, is_swappable);
+        return i;
+    }
+    m->free_hint_word = m->free_mask_words;
+
+    // 2. [Superpage] 가장 낮은 예약 블록을 풀고 다시 탐색
+    if (m->frame_reserved_mask) {
+        for (int w = 0; w < m->free_mask_words; w++) {
+            if (m->frame_reserved_mask[w] == 0) continue;
+            sp_break_reservation(ctx, w * 64 + __builtin_ctzll(m->frame_reserved_mask[w]));
+            return allocate_free_frame(ctx, vpn, is_swappable);
         }
     }
     return -1; // Memory Full
 }
 
-uint8_t* get_frame_ptr(int pfn) {
-    return &physical_memory[pfn * FRAME_SIZE];
+int find_free_frame_in(SimContext *ctx, int lo, int hi) {
+    MemoryState *m = &ctx->mem;
+    int w = lo / 64 > m->free_hint_word ? lo / 64 : m->free_hint_word;
+    for (; w * 64 < hi && w < m->free_mask_words; w++) {
+        uint64_t bits = m->frame_free_mask[w];
+        if (w == lo / 64) bits &= UINT64_MAX << (lo % 64);
+        if (bits == 0) continue;
+        int i = w * 64 + __builtin_ctzll(bits);
+        return i < hi ? i : -1;
+    }
+    return -1;
+}
+
+void allocate_frame_at(SimContext *ctx, int pfn, uint64_t key) {
+    mark_allocated(&ctx->mem, pfn);
+    init_frame(ctx, pfn, key, true);
+}
+
+void exchange_frames(SimContext *ctx, int a, int b) {
+    MemoryState *m = &ctx->mem;
+    bool b_used = !((m->frame_free_mask[b / 64] >> (b % 64)) & 1);
+    bool b_swappable = is_frame_swappable(ctx, b), b_dirty = is_frame_dirty(ctx, b);
+
+    uint8_t *pa = get_frame_ptr(ctx, a), *pb = get_frame_ptr(ctx, b);
+    for (uint64_t i = 0; i < ctx->geo.page_size; i++) {
+        uint8_t x = pa[i];
+        pa[i] = pb[i];
+        pb[i] = x;
+    }
+    uint64_t owner = m->frame_owner_vpn[a];
+    m->frame_owner_vpn[a] = m->frame_owner_vpn[b];
+    m->frame_owner_vpn[b] = owner;
+    set_frame_dirty(ctx, b, is_frame_dirty(ctx, a));
+    set_frame_dirty(ctx, a, b_dirty);
+
+    // 교체 정책에는 알리지 않고 (on_load / on_unload 없이) 상태만 맞바꿈
+    write_swappable_bit(ctx, b, true);
+    write_swappable_bit(ctx, a, b_swappable);
+    swap_exchange_frames(ctx, a, b);
+    if (!b_used) {
+        mark_allocated(m, b);
+        mark_free(m, a);
+    }
+}
+
+int find_free_block(SimContext *ctx, int n) {
+    MemoryState *m = &ctx->mem;
+    if (n >= 64) {
+        // word 단위: n / 64 개 word 가 모두 비어 있어야 함
+        int words = n / 64;
+        for (int w = m->free_hint_word / words * words; w + words <= m->free_mask_words; w += words) {
+            int i = 0;
+            while (i < words && m->frame_free_mask[w + i] == UINT64_MAX) i++;
+            if (i == words) return w * 64;
+        }
+        return -1;
+    }
+    uint64_t block = (1ULL << n) - 1;
+    for (int w = m->free_hint_word; w < m->free_mask_words; w++) {
+        uint64_t bits = m->frame_free_mask[w];
+        for (int off = 0; bits && off < 64; off += n) {
+            if (((bits >> off) & block) == block) return w * 64 + off;
+        }
+    }
+    return -1;
+}
+
+void reserve_frames(SimContext *ctx, int first, int n) {
+    MemoryState *m = &ctx->mem;
+    for (int i = first; i < first + n; i++) {
+        mark_allocated(m, i);
+        m->frame_reserved_mask[i / 64] |= 1ULL << (i % 64);
+    }
+}
+
+void unreserve_frames(SimContext *ctx, int first, int n) {
+    MemoryState *m = &ctx->mem;
+    for (int i = first; i < first + n; i++) {
+        if (!is_frame_reserved(ctx, i)) continue;
+        m->frame_reserved_mask[i / 64] &= ~(1ULL << (i % 64));
+        mark_free(m, i);
+    }
+}
+
+bool is_frame_reserved(SimContext *ctx, int pfn) {
+    const uint64_t *r = ctx->mem.frame_reserved_mask;
+    return r && ((r[pfn / 64] >> (pfn % 64)) & 1);
+}
+
+void allocate_reserved_frame(SimContext *ctx, int pfn, uint64_t key) {
+    ctx->mem.frame_reserved_mask[pfn / 64] &= ~(1ULL << (pfn % 64));
+    init_frame(ctx, pfn, key, true);
+}
+
+uint8_t* get_frame_ptr(SimContext *ctx, int pfn) {
+    return &ctx->mem.physical_memory[(uint64_t)pfn * ctx->geo.page_size];
+}
+
+bool is_frame_dirty(SimContext *ctx, int pfn) {
+    const uint64_t *d = ctx->mem.frame_dirty_mask;
+    return d && ((d[pfn / 64] >> (pfn % 64)) & 1);
 }
 
-uint16_t get_frame_owner(int pfn) {
-    return frame_owner_vpn[pfn];
+void set_frame_dirty(SimContext *ctx, int pfn, bool dirty) {
+    uint64_t *d = ctx->mem.frame_dirty_mask;
+    if (!d) return;
+    if (dirty) d[pfn / 64] |= 1ULL << (pfn % 64);
+    else d[pfn / 64] &= ~(1ULL << (pfn % 64));
 }
 
-void free_frame(int pfn) {
-    if (pfn >= 0 && pfn < NUM_FRAMES) {
-        frame_allocated[pfn] = false;
+uint64_t get_frame_owner(SimContext *ctx, int pfn) {
+    return ctx->mem.frame_owner_vpn[pfn];
+}
+
+// [Superpage] 예약 자리로 돌아가는 프레임은 재할당 전까지 교체 정책에 남아 있으면 안 되므로 바로 뺌
+static bool hold_reserved(SimContext *ctx, int pfn) {
+    if (!ctx->mem.frame_reserved_mask || !sp_hold_frame(ctx, pfn)) return false;
+    set_swappable_bit(ctx, pfn, false);
+    ctx->mem.frame_reserved_mask[pfn / 64] |= 1ULL << (pfn % 64);
+    return true;
+}
+
+void free_frame(SimContext *ctx, int pfn) {
+    if (pfn >= 0 && pfn < ctx->geo.num_frames) {
+        if (hold_reserved(ctx, pfn)) return;
+        mark_free(&ctx->mem, pfn);
     }
-}
\ No newline at end of file
+}
+
+void release_frame(SimContext *ctx, int pfn) {
+    if (pfn >= 0 && pfn < ctx->geo.num_frames) {
+        if (hold_reserved(ctx, pfn)) return;
+        set_swappable_bit(ctx, pfn, false);
+        mark_free(&ctx->mem, pfn);
+    }
+}
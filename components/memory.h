@@ -6,27 +6,67 @@
 #include <stdbool.h>
 #include "../common.h"
 
-#define MEM_SIZE 1024
-#define FRAME_SIZE 8
+// 물리 메모리 상태 (SimContext 에 포함)
+typedef struct {
+    uint8_t *physical_memory;   // 크기 = geo.mem_size
+    uint64_t *frame_owner_vpn;  // [Reverse Mapping] PFN -> (pid, vpn) 페이지 키
+    uint64_t *frame_free_mask;  // [Free Bitmap] 1 = Free
+    int free_mask_words;
+    int free_hint_word;         // 이 word 보다 앞쪽에는 빈 프레임이 없음
+    uint64_t *frame_reserved_mask; // [Superpage] 1 = 예약 블록의 빈 자리 (free mask 에서는 빠져 있음, 없으면 NULL)
+    uint64_t *frame_dirty_mask; // [Dirty] PTE 에 Dirty 비트가 없는 Geometry 의 프레임별 Dirty (그 밖에는 NULL)
+} MemoryState;
 
-// 외부 참조 (물리 메모리 배열)
-extern uint8_t physical_memory[MEM_SIZE];
-
-// 초기화
-void init_memory();
+// 초기화 (ctx->geo 설정 이후 호출)
+void init_memory(SimContext *ctx);
+void destroy_memory(SimContext *ctx);
 
 // 프레임 할당 요청
-// vpn: 이 프레임을 사용할 가상 주소의 VPN (Page Table의 경우 무시 가능)
+// vpn: 이 프레임을 사용할 페이지 키 PAGE_KEY(pid, vpn) (Page Table의 경우 무시 가능)
 // is_swappable: 데이터 페이지면 true, 페이지 테이블이면 false
 // 반환값: 성공 시 PFN, 실패(Full) 시 -1
-int allocate_free_frame(uint16_t vpn, bool is_swappable);
+// [Superpage] 빈 프레임이 없으면 예약 블록 하나를 풀어서 그 자리를 씀
+int allocate_free_frame(SimContext *ctx, uint64_t vpn, bool is_swappable);
+
+// [Tier] lo <= PFN < hi 인 가장 낮은 빈 프레임 (예약 자리 제외), 없으면 -1
+int find_free_frame_in(SimContext *ctx, int lo, int hi);
+// 빈 프레임 pfn 에 데이터 페이지 key 적재 (allocate_free_frame 과 같은 초기화)
+void allocate_frame_at(SimContext *ctx, int pfn, uint64_t key);
+// 데이터 페이지 프레임 a 와 b (데이터 페이지 또는 빈 프레임) 의 자리를 맞바꿈
+// 내용 / 소유자 / 할당 상태 / 프레임별 Dirty / 교체 정책 상태 (swap_exchange_frames) 가 페이지를 따라감
+// 페이지를 새로 적재하는 것이 아니므로 교체 정책의 on_load / on_unload 는 부르지 않음. PTE 는 호출자가 고침
+void exchange_frames(SimContext *ctx, int a, int b);
+
+// [Superpage] 예약 블록 (superpage.c 에서 사용)
+// 정렬된 n 개 연속 빈 프레임의 첫 PFN (n 은 2의 거듭제곱), 없으면 -1
+int find_free_block(SimContext *ctx, int n);
+// first ~ first+n-1 (모두 빈 프레임) 을 예약: 일반 할당에서 제외
+void reserve_frames(SimContext *ctx, int first, int n);
+// 아직 예약 상태인 자리를 다시 빈 프레임으로
+void unreserve_frames(SimContext *ctx, int first, int n);
+bool is_frame_reserved(SimContext *ctx, int pfn);
+// 예약된 자리 pfn 에 데이터 페이지 key 적재 (allocate_free_frame 과 같은 초기화)
+void allocate_reserved_frame(SimContext *ctx, int pfn, uint64_t key);
 
 // 특정 프레임의 데이터 접근 헬퍼
-uint8_t* get_frame_ptr(int pfn);
+uint8_t* get_frame_ptr(SimContext *ctx, int pfn);
 
 // Reverse Mapping 확인 (Swap 모듈용)
-uint16_t get_frame_owner(int pfn);
+uint64_t get_frame_owner(SimContext *ctx, int pfn);
+
+// Swappable 비트 확인 (비트마스크는 물리 메모리 Frame 0 부터 위치)
+bool is_frame_swappable(SimContext *ctx, int pfn);
+
+// [Dirty] geo.pte_dirty_mask 가 0 일 때 PTE 대신 쓰는 프레임별 Dirty (page_table.c 가 사용)
+// 프레임 적재 시 Clean 으로 초기화, 페이지를 다른 프레임으로 옮기면 호출자가 함께 옮김
+// frame_dirty_mask 가 없으면 is_frame_dirty 는 항상 false, set_frame_dirty 는 아무것도 하지 않음
+bool is_frame_dirty(SimContext *ctx, int pfn);
+void set_frame_dirty(SimContext *ctx, int pfn, bool dirty);
+
+// [Superpage] 예약 블록 안의 자기 자리였던 프레임은 빈 프레임 대신 예약 상태로 돌아감
+void free_frame(SimContext *ctx, int pfn);
 
-void free_frame(int pfn);
+// 교체 정책에서도 빼면서 해제 (묶음 회수: 같은 프레임이 다시 Victim 으로 뽑히지 않도록)
+void release_frame(SimContext *ctx, int pfn);
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,227 @@
+/* multicore.c */
+#include "multicore.h"
+#include "sim.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+
+#define HIT_HUGE 0x80 // hit_level 의 최상위 비트: Superpage 엔트리로 Hit
+
+void init_cores(SimContext *ctx) {
+    destroy_cores(ctx);
+    ctx->num_cores = ctx->geo.cores;
+    ctx->cores = calloc(ctx->num_cores, sizeof(Core));
+    if (!ctx->cores) {
+        perror("malloc cores");
+        exit(1);
+    }
+    for (int c = 0; c < ctx->num_cores; c++) init_pwc(&ctx->cores[c].pwc, &ctx->geo);
+    ctx->core = 0; // 모든 코어는 pid 0 에서 시작
+}
+
+void destroy_cores(SimContext *ctx) {
+    for (int c = 0; c < ctx->num_cores; c++) {
+        free(ctx->cores[c].hit_pfn);
+        free(ctx->cores[c].hit_level);
+        destroy_pwc(&ctx->cores[c].pwc);
+    }
+    free(ctx->cores);
+    ctx->cores = NULL;
+    ctx->num_cores = 0;
+    ctx->tlb = NULL;
+}
+
+void sim_select_core(SimContext *ctx, int core) {
+    Core *c = &ctx->cores[core];
+    ctx->core = core;
+    ctx->tlb = &c->tlb;
+    ctx->proc.current = c->pid;
+    ctx->proc.key_base = c->key_base;
+}
+
+// --- (1) 병렬 단계: 코어 하나의 TLB Hit 구간 ---
+// 이 코어의 TLB 와 진행 상태만 바꿈 (공유 상태는 읽기만)
+static void run_hits(SimContext *ctx, Core *core, uint64_t quantum) {
+    const Geometry *geo = &ctx->geo;
+    const Trace *trace = core->trace;
+    TLBState *t = &core->tlb;
+
+    core->hits = 0;
+    while (core->hits < quantum && core->pos < trace->count) {
+        if (trace_get_pid(trace, core->pos) != core->pid) break; // 문맥 교환은 직렬 단계에서
+        if (trace_get_write(trace, core->pos)) break;            // 쓰기는 PTE / 공유 프레임을 바꾸므로 직렬 단계에서
+
+        uint64_t va = trace_get(trace, core->pos) & geo->va_mask;
+        t->clock++;
+        int pfn = tlb_lookup(ctx, t, core->key_base | GET_FULL_VPN(geo, va));
+        if (pfn == -1) {
+            t->clock--; // Miss 는 직렬 단계에서 같은 접근으로 다시 조회
+            break;
+        }
+        core->hit_pfn[core->hits] = (uint32_t)pfn;
+        core->hit_level[core->hits] = (uint8_t)(t->last_hit_level | (t->last_hit_huge ? HIT_HUGE : 0));
+        core->hits++;
+        core->pos++;
+    }
+}
+
+// --- (2) 직렬 단계: 병렬 단계의 Hit 을 공유 상태에 반영 ---
+// sim_access 의 TLB Hit 경로와 같은 카운터 / 교체 정책 갱신 (TLB 조회는 이미 끝남)
+static void commit_hits(SimContext *ctx, Core *core) {
+    const Geometry *geo = &ctx->geo;
+    Stats *st = &ctx->stats;
+    ProcessStats *ps = &ctx->proc.stats[core->pid];
+
+    for (size_t i = 0; i < core->hits; i++) {
+        int level = core->hit_level[i] & ~HIT_HUGE;
+        ctx->time++;
+        stats_on_access(st, &ctx->series);
+        st->tlb_hits++;
+        if (core->hit_level[i] & HIT_HUGE) st->tlb_huge_hits++;
+        for (int l = 0; l < level; l++) {
+            st->tlb_level_misses[l]++;
+            st->cycles_tlb += geo->lat_tlb[l];
+        }
+        st->tlb_level_hits[level]++;
+        st->cycles_tlb += geo->lat_tlb[level];
+        st->cycles_data += tier_latency(geo, (int)core->hit_pfn[i]);
+        if ((int)core->hit_pfn[i] >= geo->fast_frames) st->tier_slow_accesses++;
+        ps->accesses++;
+        // prefetch 된 페이지의 첫 접근은 정확도에만 반영 (뒤의 Hit 이 가리키는 프레임을 바꾸지 않도록 예측은 직렬 단계 Fault 에서만)
+        acknowledge_frame_access(ctx, (int)core->hit_pfn[i]);
+    }
+    core->stats.accesses += core->hits;
+    core->hits = 0;
+
+    for (int p = 0; p < POLICY_COUNT; p++) {
+        st->tlb_evictions[p] += core->tlb_evictions[p];
+        core->tlb_evictions[p] = 0;
+    }
+}
+
+// --- 병렬 단계 워커 (epoch 마다 barrier 두 번) ---
+typedef struct {
+    SimContext *ctx;
+    uint64_t quantum;
+    int threads;
+    bool stop;
+    pthread_barrier_t start;
+    pthread_barrier_t done;
+} CoreRun;
+
+typedef struct {
+    CoreRun *run;
+    int id;
+} CoreWorker;
+
+static void run_share(CoreRun *run, int id) {
+    for (int c = id; c < run->ctx->num_cores; c += run->threads) {
+        run_hits(run->ctx, &run->ctx->cores[c], run->quantum);
+    }
+}
+
+static void* core_worker(void *arg) {
+    CoreWorker *w = arg;
+    CoreRun *run = w->run;
+    while (1) {
+        pthread_barrier_wait(&run->start);
+        if (run->stop) break;
+        run_share(run, w->id);
+        pthread_barrier_wait(&run->done);
+    }
+    return NULL;
+}
+
+int sim_run_cores(SimContext *ctx, const Trace *traces, int threads, uint64_t quantum) {
+    int n = ctx->num_cores;
+    if (sim_uses_opt(&ctx->geo, ctx->policy)) {
+        fprintf(stderr, "Error: OPT needs a single access stream and cannot run on multiple cores.\n");
+        return -1;
+    }
+    if (quantum == 0) quantum = CORE_QUANTUM;
+    if (threads <= 0 || threads > n) threads = n;
+
+    for (int c = 0; c < n; c++) {
+        Core *core = &ctx->cores[c];
+        core->trace = &traces[c];
+        core->pos = 0;
+        core->hits = 0;
+        free(core->hit_pfn);
+        free(core->hit_level);
+        core->hit_pfn = malloc(sizeof(uint32_t) * quantum);
+        core->hit_level = malloc(quantum);
+        if (!core->hit_pfn || !core->hit_level) {
+            perror("malloc core hit buffer");
+            return -1;
+        }
+    }
+
+    // 로그는 직렬 단계의 Miss 만 남게 되어 의미가 없으므로 끔
+    int saved_level = ctx->log.level;
+    ctx->log.level = LOG_LEVEL_NONE;
+
+    CoreRun run = { .ctx = ctx, .quantum = quantum, .threads = threads, .stop = false };
+    pthread_t *tids = malloc(sizeof(pthread_t) * threads);
+    CoreWorker *workers = malloc(sizeof(CoreWorker) * threads);
+    if (!tids || !workers) {
+        perror("malloc core workers");
+        exit(1);
+    }
+    pthread_barrier_init(&run.start, NULL, threads);
+    pthread_barrier_init(&run.done, NULL, threads);
+    for (int i = 1; i < threads; i++) {
+        workers[i] = (CoreWorker){ &run, i };
+        if (pthread_create(&tids[i], NULL, core_worker, &workers[i]) != 0) {
+            perror("pthread_create");
+            exit(1);
+        }
+    }
+
+    int ret = 0;
+    while (ret == 0) {
+        bool remaining = false;
+        for (int c = 0; c < n; c++) remaining |= ctx->cores[c].pos < ctx->cores[c].trace->count;
+        if (!remaining) break;
+
+        // (1) 병렬: 호출 스레드도 워커 0 으로 참여
+        if (threads > 1) pthread_barrier_wait(&run.start);
+        run_share(&run, 0);
+        if (threads > 1) pthread_barrier_wait(&run.done);
+
+        // (2) 모든 코어의 Hit 반영이 이번 epoch 의 어떤 Fault / Shootdown 보다 먼저
+        for (int c = 0; c < n; c++) {
+            sim_select_core(ctx, c);
+            commit_hits(ctx, &ctx->cores[c]);
+        }
+
+        // (3) 코어마다 멈춘 접근 하나 (Miss 또는 문맥 교환)
+        for (int c = 0; c < n && ret == 0; c++) {
+            Core *core = &ctx->cores[c];
+            if (core->pos >= core->trace->count) continue;
+            sim_select_core(ctx, c);
+
+            uint64_t pa;
+            if (sim_switch_process(ctx, trace_get_pid(core->trace, core->pos)) != 0 ||
+                sim_access_rw(ctx, trace_get(core->trace, core->pos),
+                              trace_get_write(core->trace, core->pos), &pa) != 0) {
+                ret = -1;
+            }
+            core->pos++;
+        }
+    }
+
+    run.stop = true;
+    if (threads > 1) pthread_barrier_wait(&run.start);
+    for (int i = 1; i < threads; i++) pthread_join(tids[i], NULL);
+    pthread_barrier_destroy(&run.start);
+    pthread_barrier_destroy(&run.done);
+    free(tids);
+    free(workers);
+
+    // 마지막 직렬 단계의 TLB 교체도 합침
+    for (int c = 0; c < n; c++) commit_hits(ctx, &ctx->cores[c]);
+    sim_select_core(ctx, 0);
+    ctx->log.level = saved_level;
+    return ret;
+}
@@ -0,0 +1,50 @@
+/* multicore.h */
+#ifndef MULTICORE_H
+#define MULTICORE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "../common.h"
+#include "tlb.h"
+#include "pwc.h"
+#include "stats.h"
+#include "trace.h"
+
+// --- 코어 (geo.cores 개) ---
+// 코어마다 private TLB / Page Walk Cache 와 실행 중인 pid, 페이지 테이블 / 물리 메모리 / 교체 정책은 모두 공유
+// 스왑 아웃은 다른 코어의 TLB 에 shootdown (tlb_shootdown)
+typedef struct {
+    TLBState tlb;
+    PWCState pwc;
+    int pid;                              // 이 코어가 실행 중인 프로세스
+    uint64_t key_base;                    // PAGE_KEY(geo, pid, 0)
+    uint64_t tlb_evictions[POLICY_COUNT]; // 아직 ctx->stats 에 합치지 않은 TLB 교체 횟수
+    CoreStats stats;
+
+    // sim_run_cores 진행 상태
+    const Trace *trace;
+    uint64_t pos;                         // 다음에 처리할 레코드
+    uint32_t *hit_pfn;                    // 이번 epoch 병렬 단계의 TLB Hit (직렬 단계에서 반영)
+    uint8_t *hit_level;
+    size_t hits;
+} Core;
+
+// 병렬 단계에서 코어 하나가 처리하는 최대 접근 수 (코어 간 시간 차이의 상한)
+#define CORE_QUANTUM 1024
+
+// init_tlb 보다 먼저 (코어 배열만 할당, TLB 는 init_tlb 가 채움)
+void init_cores(SimContext *ctx);
+void destroy_cores(SimContext *ctx);
+
+// 이후 sim_access / translate_batch 를 core 에서 실행
+void sim_select_core(SimContext *ctx, int core);
+
+// 코어별 트레이스(trace_load 이후) traces[0 .. geo.cores-1] 를 동시에 실행
+// epoch 마다 (1) 코어별로 TLB Hit 구간을 threads 개 스레드에서 병렬 처리 (Miss / pid 변경 / 쓰기에서 멈춤)
+//             (2) 모든 코어의 Hit 을 코어 순서대로 공유 상태(교체 정책, 통계)에 반영
+//             (3) 코어 순서대로 멈춘 접근 하나씩 전체 경로(Page Walk, Fault, Shootdown)로 처리
+// 공유 상태는 직렬 단계에서만 바뀌므로 결과는 스레드 수와 무관하게 같음
+// per-access 로그는 남기지 않음. 성공 0, 실패 -1
+int sim_run_cores(SimContext *ctx, const Trace *traces, int threads, uint64_t quantum);
+
+#endif
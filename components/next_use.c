@@ -0,0 +1,31 @@
+/* next_use.c */
+#include "next_use.h"
+#include "vpn_map.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+uint32_t* build_next_use(const Geometry *geo, const Trace *trace) {
+    if (trace->count >= NEXT_USE_NEVER) {
+        fprintf(stderr, "OPT: trace too long for 32-bit next-use index (%llu accesses)\n",
+                (unsigned long long)trace->count);
+        return NULL;
+    }
+
+    uint32_t *next = malloc(sizeof(uint32_t) * (trace->count ? trace->count : 1));
+    if (!next) {
+        perror("malloc next-use index");
+        return NULL;
+    }
+
+    VpnMap last;
+    vmap_init(&last, 1024);
+    for (uint64_t i = trace->count; i-- > 0;) {
+        uint64_t vpn = GET_FULL_VPN(geo, trace_get(trace, i) & geo->va_mask);
+        uint64_t key = PAGE_KEY(geo, trace_get_pid(trace, i), vpn);
+        uint64_t j;
+        next[i] = vmap_get(&last, key, &j) ? (uint32_t)j : NEXT_USE_NEVER;
+        vmap_put(&last, key, i);
+    }
+    vmap_destroy(&last);
+    return next;
+}
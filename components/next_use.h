@@ -0,0 +1,18 @@
+/* next_use.h */
+#ifndef NEXT_USE_H
+#define NEXT_USE_H
+
+#include <stdint.h>
+#include "../common.h"
+#include "trace.h"
+
+// --- [OPT] 다음 사용 시점 인덱스 ---
+// next[i] = 접근 i 이후 같은 VPN 이 다시 접근되는 인덱스 (없으면 NEXT_USE_NEVER)
+// 트레이스 끝에서부터 한 번 훑으며 VPN -> 마지막으로 본 인덱스 맵으로 계산
+// 메모리: 접근당 4 Byte + 서로 다른 VPN 수에 비례하는 맵 (프레임 수와 무관)
+#define NEXT_USE_NEVER UINT32_MAX
+
+// trace 는 trace_load 로 메모리에 올린 상태여야 함. 실패 시 NULL (호출자가 free)
+uint32_t* build_next_use(const Geometry *geo, const Trace *trace);
+
+#endif
@@ -2,71 +2,169 @@
 #include "memory.h"
 #include "log.h"
 #include "swap.h" 
+#include "stats.h"
+#include "sim.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+void init_page_tables(SimContext *ctx) {
+    PageTableState *pt = &ctx->pt;
+    destroy_page_tables(ctx);
+    for (int l = 0; l < MAX_LEVELS; l++) pt->pin[l] = -1;
+    if (!ctx->geo.pt_reclaim) return;
+    pt->valid = calloc(ctx->geo.num_frames, sizeof(uint32_t));
+    if (!pt->valid) {
+        perror("malloc page table counts");
+        exit(1);
+    }
+}
+
+void destroy_page_tables(SimContext *ctx) {
+    free(ctx->pt.valid);
+    memset(&ctx->pt, 0, sizeof(ctx->pt));
+}
+
+static inline void pt_unpin(SimContext *ctx) {
+    for (int l = 0; l < MAX_LEVELS; l++) ctx->pt.pin[l] = -1;
+}
+
+static bool pt_pinned(const SimContext *ctx, int pfn) {
+    for (int l = 0; l < MAX_LEVELS; l++) {
+        if (ctx->pt.pin[l] == pfn) return true;
+    }
+    return false;
+}
 
 // 내부 헬퍼: 특정 테이블 프레임의 PTE 주소 반환
-uint8_t* get_pte_ptr(int table_pfn, int index) {
-    return &physical_memory[(table_pfn * FRAME_SIZE) + index];
+static inline uint8_t* get_pte_ptr(SimContext *ctx, int table_pfn, uint64_t index) {
+    return get_frame_ptr(ctx, table_pfn) + index * ctx->geo.pte_bytes;
+}
+
+uint64_t read_pte(SimContext *ctx, int table_pfn, uint64_t index) {
+    uint8_t *p = get_pte_ptr(ctx, table_pfn, index);
+    switch (ctx->geo.pte_bytes) {
+        case 1: return *p;
+        case 2: { uint16_t v; memcpy(&v, p, 2); return v; }
+        case 4: { uint32_t v; memcpy(&v, p, 4); return v; }
+        default: { uint64_t v; memcpy(&v, p, 8); return v; }
+    }
+}
+
+void write_pte(SimContext *ctx, int table_pfn, uint64_t index, uint64_t pte) {
+    uint8_t *p = get_pte_ptr(ctx, table_pfn, index);
+    if (ctx->pt.valid) {
+        // [pt_reclaim] Present 비트가 바뀌는 쓰기만 유효 엔트리 수에 반영
+        const Geometry *geo = &ctx->geo;
+        bool was = IS_PTE_PRESENT(geo, read_pte(ctx, table_pfn, index)) != 0;
+        bool now = IS_PTE_PRESENT(geo, pte) != 0;
+        if (now != was) {
+            if (now) ctx->pt.valid[table_pfn]++;
+            else ctx->pt.valid[table_pfn]--;
+        }
+    }
+    switch (ctx->geo.pte_bytes) {
+        case 1: *p = (uint8_t)pte; break;
+        case 2: { uint16_t v = (uint16_t)pte; memcpy(p, &v, 2); break; }
+        case 4: { uint32_t v = (uint32_t)pte; memcpy(p, &v, 4); break; }
+        default: memcpy(p, &pte, 8); break;
+    }
 }
 
 // 내부 헬퍼: 새 테이블(PD or PT)을 위한 프레임 할당
 // [Spec] Page table entries are never evicted. (Swappable = false)
-int alloc_table_frame() {
+static int alloc_table_frame(SimContext *ctx) {
     // 인자: vpn=0 (Dummy), is_swappable=false
-    int pfn = allocate_free_frame(0, false); 
+    int pfn = allocate_free_frame(ctx, 0, false); 
     
     if (pfn == -1) {
         // 메모리가 꽉 찼다면 스왑 수행 (Victim 선정 및 해제)
         // [Spec] If main memory is full, page swap should be occurred.
-        pfn = swap_out(); 
+        pfn = swap_out(ctx); 
         
         // 스왑으로 빈 공간이 생겼으므로 다시 할당 시도
-        pfn = allocate_free_frame(0, false);
+        pfn = allocate_free_frame(ctx, 0, false);
     }
+    if (pfn == -1) return -1; // 스왑할 프레임도 없음 (할당 횟수에 넣지 않음)
+    ctx->stats.table_frame_allocs++;
+    if (ctx->pt.valid) ctx->pt.valid[pfn] = 0;
+    uint64_t live = ctx->stats.table_frame_allocs - ctx->stats.pt_tables_freed;
+    if (live > ctx->stats.pt_tables_peak) ctx->stats.pt_tables_peak = live;
     return pfn;
 }
 
-PT_Result walk_page_table(uint16_t va) {
-    int vpn1 = GET_VPN1(va);
-    int vpn2 = GET_VPN2(va);
-    int vpn3 = GET_VPN3(va);
+int alloc_root_table(SimContext *ctx) {
+    return alloc_table_frame(ctx);
+}
 
+PT_Result walk_page_table(SimContext *ctx, uint64_t va) {
+    const Geometry *geo = &ctx->geo;
     PT_Result result;
     result.pfn = -1;
     result.hit = false;
+    result.huge_pfn = -1;
 
-    // 1. Root Page Table (PD1) - 항상 PFN 2
-    int pd1_pfn = 2; 
-
-    uint8_t* pte1 = get_pte_ptr(pd1_pfn, vpn1);
+    // 1. Root Page Table (PD1) - pid 0 은 geo->root_pfn (12bit 프리셋: PFN 2)
+    int table_pfn = ctx->proc.root_pfn[ctx->proc.current];
+    int leaf = geo->levels - 1;
+    int start = 0;
 
-    // [수정] 탐색 중에는 할당하지 않음. 없으면 Miss.
-    if (!IS_PTE_PRESENT(*pte1)) {
-        log_pt_miss(GET_FULL_VPN(va));
-        return result;
+    // Page Walk Cache: 가장 깊게 캐시된 단계의 다음 테이블부터 시작
+    uint64_t key = ctx->proc.key_base | GET_FULL_VPN(geo, va);
+    PWCState *pwc = &ctx->cores[ctx->core].pwc;
+    if (pwc->entries) {
+        ctx->stats.cycles_walk += geo->lat_pwc;
+        int cached_pfn;
+        int hit = pwc_lookup(pwc, geo, key, &cached_pfn);
+        if (hit >= 0) {
+            ctx->stats.pwc_hits++;
+            ctx->stats.walk_levels_skipped += hit + 1;
+            table_pfn = cached_pfn;
+            start = hit + 1;
+        } else {
+            ctx->stats.pwc_misses++;
+        }
     }
-    int pd2_pfn = GET_PTE_PFN(*pte1);
 
-    // 2. Page Directory 2 (PD2)
-    uint8_t* pte2 = get_pte_ptr(pd2_pfn, vpn2);
-
-    // [수정] 탐색 중에는 할당하지 않음. 없으면 Miss.
-    if (!IS_PTE_PRESENT(*pte2)) {
-        log_pt_miss(GET_FULL_VPN(va));
-        return result;
+    // 2. 중간 단계 (PD2 ...): 탐색 중에는 할당하지 않음. 없으면 Miss.
+    // PTE 읽기 1회 = 메모리 접근 1회 (Leaf 포함 leaf - start + 1 회)
+    for (int l = start; l < leaf; l++) {
+        uint64_t pte = read_pte(ctx, table_pfn, GET_LEVEL_INDEX(geo, va, l));
+        ctx->stats.walk_mem_refs++;
+        ctx->stats.cycles_walk += tier_latency(geo, table_pfn);
+        if (!IS_PTE_PRESENT(geo, pte)) {
+            log_pt_miss(&ctx->log, GET_FULL_VPN(geo, va));
+            ctx->stats.pt_misses++;
+            return result;
+        }
+        if (l == geo->sp_level && IS_PTE_HUGE(geo, pte)) {
+            // Superpage: 이 PTE 가 블록 전체를 매핑하므로 아래 단계는 읽지 않음 (PWC 에도 넣지 않음)
+            result.huge_pfn = GET_PTE_PFN(geo, pte);
+            result.pfn = result.huge_pfn + (int)(key & ((1ULL << geo->sp_bits) - 1));
+            result.hit = true;
+            log_pt_hit(&ctx->log, GET_FULL_VPN(geo, va), result.pfn);
+            ctx->stats.pt_hits++;
+            return result;
+        }
+        table_pfn = GET_PTE_PFN(geo, pte);
+        if (pwc->entries) pwc_fill(pwc, geo, key, l, table_pfn);
     }
-    int pt_pfn = GET_PTE_PFN(*pte2);
 
     // 3. Page Table (Leaf)
-    uint8_t* pte3 = get_pte_ptr(pt_pfn, vpn3);
+    uint64_t pte = read_pte(ctx, table_pfn, GET_LEVEL_INDEX(geo, va, leaf));
+    ctx->stats.walk_mem_refs++;
+    ctx->stats.cycles_walk += tier_latency(geo, table_pfn);
 
-    if (IS_PTE_PRESENT(*pte3)) {
+    if (IS_PTE_PRESENT(geo, pte)) {
         // [Log] Page Table Hit
-        log_pt_hit(GET_FULL_VPN(va), GET_PTE_PFN(*pte3));
-        result.pfn = GET_PTE_PFN(*pte3);
+        log_pt_hit(&ctx->log, GET_FULL_VPN(geo, va), GET_PTE_PFN(geo, pte));
+        result.pfn = GET_PTE_PFN(geo, pte);
         result.hit = true;
+        ctx->stats.pt_hits++;
     } else {
         // [Log] Page Table Miss
-        log_pt_miss(GET_FULL_VPN(va));
+        log_pt_miss(&ctx->log, GET_FULL_VPN(geo, va));
+        ctx->stats.pt_misses++;
         result.pfn = -1; 
         result.hit = false;
     }
@@ -75,70 +173,164 @@ PT_Result walk_page_table(uint16_t va) {
 }
 
 // Page Table에 최종 매핑 업데이트 (Swap In 후 호출)
-void update_page_table(uint16_t va, int new_pfn) {
-    int vpn1 = GET_VPN1(va);
-    int vpn2 = GET_VPN2(va);
-    int vpn3 = GET_VPN3(va);
-    
-    int pd1_pfn = 2;
+int update_page_table(SimContext *ctx, uint64_t va, int new_pfn) {
+    const Geometry *geo = &ctx->geo;
+    int table_pfn = ctx->proc.root_pfn[ctx->proc.current];
+    int leaf = geo->levels - 1;
     
-    // 1. PD1 -> PD2 탐색 및 할당
-    uint8_t* pte1 = get_pte_ptr(pd1_pfn, vpn1);
-    if (!IS_PTE_PRESENT(*pte1)) {
-        // [수정] 업데이트 시점에 테이블이 없으면 생성 (Lazy Allocation)
-        int new_table_pfn = alloc_table_frame();
-        *pte1 = CREATE_PTE(new_table_pfn);
+    // 1. 중간 단계 탐색 및 할당
+    // (테이블 할당의 스왑 아웃이 지나온 경로의 테이블을 비워도 해제하지 않도록 고정)
+    for (int l = 0; l < leaf; l++) {
+        uint64_t idx = GET_LEVEL_INDEX(geo, va, l);
+        uint64_t pte = read_pte(ctx, table_pfn, idx);
+        ctx->pt.pin[l] = table_pfn;
+        if (!IS_PTE_PRESENT(geo, pte)) {
+            // [수정] 업데이트 시점에 테이블이 없으면 생성 (Lazy Allocation)
+            int new_table_pfn = alloc_table_frame(ctx);
+            if (new_table_pfn == -1) {
+                pt_unpin(ctx);
+                return -1;
+            }
+            pte = CREATE_PTE(geo, new_table_pfn);
+            write_pte(ctx, table_pfn, idx, pte);
+        }
+        table_pfn = GET_PTE_PFN(geo, pte);
     }
-    int pd2_pfn = GET_PTE_PFN(*pte1);
 
-    // 2. PD2 -> PT 탐색 및 할당
-    uint8_t* pte2 = get_pte_ptr(pd2_pfn, vpn2);
-    if (!IS_PTE_PRESENT(*pte2)) {
-        // [수정] 업데이트 시점에 테이블이 없으면 생성
-        int new_table_pfn = alloc_table_frame();
-        *pte2 = CREATE_PTE(new_table_pfn);
+    // 2. Leaf PT -> Data PFN 업데이트
+    write_pte(ctx, table_pfn, GET_LEVEL_INDEX(geo, va, leaf), CREATE_PTE(geo, new_pfn));
+    pt_unpin(ctx);
+    
+    // [Log] Page Table Update
+    log_pt_update(&ctx->log, GET_FULL_VPN(geo, va), new_pfn);
+    return 0;
+}
+
+int pt_table_at(SimContext *ctx, uint64_t key, int level, bool alloc) {
+    const Geometry *geo = &ctx->geo;
+    uint64_t va = KEY_VPN(geo, key) << geo->offset_bits;
+    int table_pfn = ctx->proc.root_pfn[KEY_PID(geo, key)];
+
+    for (int l = 0; l < level; l++) {
+        uint64_t idx = GET_LEVEL_INDEX(geo, va, l);
+        uint64_t pte = read_pte(ctx, table_pfn, idx);
+        if (alloc) ctx->pt.pin[l] = table_pfn;
+        if (!IS_PTE_PRESENT(geo, pte)) {
+            if (!alloc) return -1;
+            int new_table_pfn = alloc_table_frame(ctx);
+            if (new_table_pfn == -1) {
+                pt_unpin(ctx);
+                return -1;
+            }
+            pte = CREATE_PTE(geo, new_table_pfn);
+            write_pte(ctx, table_pfn, idx, pte);
+        } else if (IS_PTE_HUGE(geo, pte)) {
+            table_pfn = -1;
+            break;
+        }
+        table_pfn = GET_PTE_PFN(geo, pte);
     }
-    int pt_pfn  = GET_PTE_PFN(*pte2);
+    if (alloc) pt_unpin(ctx);
+    return table_pfn;
+}
 
-    // 3. PT -> Data PFN 업데이트
-    uint8_t* pte3 = get_pte_ptr(pt_pfn, vpn3);
+int pt_lookup(SimContext *ctx, uint64_t key) {
+    const Geometry *geo = &ctx->geo;
+    uint64_t va = KEY_VPN(geo, key) << geo->offset_bits;
+    int table_pfn = ctx->proc.root_pfn[KEY_PID(geo, key)];
+    int leaf = geo->levels - 1;
 
-    // Update
-    *pte3 = CREATE_PTE(new_pfn);
-    
-    // [Log] Page Table Update
-    log_pt_update(GET_FULL_VPN(va), new_pfn);
+    for (int l = 0; l < leaf; l++) {
+        uint64_t pte = read_pte(ctx, table_pfn, GET_LEVEL_INDEX(geo, va, l));
+        if (!IS_PTE_PRESENT(geo, pte)) return -1;
+        if (IS_PTE_HUGE(geo, pte)) return GET_PTE_PFN(geo, pte) + (int)(key & ((1ULL << geo->sp_bits) - 1));
+        table_pfn = GET_PTE_PFN(geo, pte);
+    }
+    uint64_t pte = read_pte(ctx, table_pfn, GET_LEVEL_INDEX(geo, va, leaf));
+    return IS_PTE_PRESENT(geo, pte) ? GET_PTE_PFN(geo, pte) : -1;
 }
 
-void invalidate_pt_mapping(uint16_t vpn) {
-    // 주소 쪼개기 (매크로 사용을 위해 가상 주소 포맷으로 복원)
-    uint16_t va_dummy = vpn << 3; 
-    
-    int vpn1 = GET_VPN1(va_dummy);
-    int vpn2 = GET_VPN2(va_dummy);
-    int vpn3 = GET_VPN3(va_dummy);
+bool pt_is_mapped(SimContext *ctx, uint64_t key) {
+    return pt_lookup(ctx, key) != -1;
+}
 
-    // 1. Root Page Table (PD1) 접근 - PFN 2 고정
-    int pd1_pfn = 2;
-    uint8_t* pte1 = get_pte_ptr(pd1_pfn, vpn1);
+// [pt_reclaim] key 의 경로 path[0..leaf] 에서 비어 있는 테이블을 Leaf 쪽부터 해제
+// Root 와 고정된 테이블, 아직 유효 엔트리가 남은 테이블에서 멈춤
+static void reclaim_tables(SimContext *ctx, uint64_t key, const int *path) {
+    const Geometry *geo = &ctx->geo;
+    uint64_t va = KEY_VPN(geo, key) << geo->offset_bits;
 
-    // PD1 엔트리 자체가 없으면 하위도 없으므로 종료
-    if (!IS_PTE_PRESENT(*pte1)) return;
-    
-    int pd2_pfn = GET_PTE_PFN(*pte1);
+    for (int l = geo->levels - 1; l > 0; l--) {
+        int pfn = path[l];
+        if (ctx->pt.valid[pfn] || pt_pinned(ctx, pfn)) return;
+        write_pte(ctx, path[l - 1], GET_LEVEL_INDEX(geo, va, l - 1), 0);
+        // 이 테이블 (와 그 아래) 을 가리키는 PWC 엔트리 제거
+        for (int c = 0; c < ctx->num_cores; c++) {
+            PWCState *pwc = &ctx->cores[c].pwc;
+            if (pwc->entries) pwc_invalidate(pwc, geo, key, l - 1);
+        }
+        free_frame(ctx, pfn);
+        ctx->stats.pt_tables_freed++;
+        ctx->stats.pt_bytes_reclaimed += geo->page_size;
+    }
+}
+
+bool invalidate_pt_mapping(SimContext *ctx, uint64_t key) {
+    const Geometry *geo = &ctx->geo;
+    // 주소 쪼개기 (매크로 사용을 위해 가상 주소 포맷으로 복원)
+    uint64_t va_dummy = KEY_VPN(geo, key) << geo->offset_bits; 
 
-    // 2. Page Directory 2 (PD2) 접근
-    uint8_t* pte2 = get_pte_ptr(pd2_pfn, vpn2);
+    int table_pfn = ctx->proc.root_pfn[KEY_PID(geo, key)];
+    int leaf = geo->levels - 1;
+    int path[MAX_LEVELS];
 
-    if (!IS_PTE_PRESENT(*pte2)) return;
+    // 중간 단계 엔트리가 없으면 하위도 없으므로 종료
+    for (int l = 0; l < leaf; l++) {
+        path[l] = table_pfn;
+        uint64_t pte = read_pte(ctx, table_pfn, GET_LEVEL_INDEX(geo, va_dummy, l));
+        if (!IS_PTE_PRESENT(geo, pte)) return false;
+        table_pfn = GET_PTE_PFN(geo, pte);
+    }
+    path[leaf] = table_pfn;
 
-    int pt_pfn = GET_PTE_PFN(*pte2);
+    // [핵심] 최종 PTE가 존재한다면 Present / Dirty 비트 끄기
+    uint64_t idx = GET_LEVEL_INDEX(geo, va_dummy, leaf);
+    uint64_t pte = read_pte(ctx, table_pfn, idx);
+    if (!IS_PTE_PRESENT(geo, pte)) return false;
+    write_pte(ctx, table_pfn, idx, pte & ~(geo->pte_present_mask | geo->pte_dirty_mask));
+    if (ctx->pt.valid) reclaim_tables(ctx, key, path);
+    if (geo->pte_dirty_mask) return IS_PTE_DIRTY(geo, pte);
+    int pfn = (int)GET_PTE_PFN(geo, pte);
+    bool dirty = is_frame_dirty(ctx, pfn);
+    set_frame_dirty(ctx, pfn, false);
+    return dirty;
+}
 
-    // 3. Leaf Page Table (PT) 접근
-    uint8_t* pte3 = get_pte_ptr(pt_pfn, vpn3);
+bool mark_pte_dirty(SimContext *ctx, uint64_t va, int pfn) {
+    const Geometry *geo = &ctx->geo;
+    if (!geo->pte_dirty_mask) {
+        // PTE 에 남는 비트가 없으면 프레임별 Dirty (테이블로 재사용된 프레임은 제외)
+        if (!is_frame_swappable(ctx, pfn) || is_frame_dirty(ctx, pfn)) return false;
+        set_frame_dirty(ctx, pfn, true);
+        return true;
+    }
 
-    // [핵심] 최종 PTE가 존재한다면 Present 비트만 끄기
-    if (IS_PTE_PRESENT(*pte3)) {
-        *pte3 &= ~PTE_PRESENT_MASK; 
+    int table_pfn = ctx->proc.root_pfn[ctx->proc.current];
+    int leaf = geo->levels - 1;
+    for (int l = 0; l < leaf; l++) {
+        uint64_t idx = GET_LEVEL_INDEX(geo, va, l);
+        uint64_t pte = read_pte(ctx, table_pfn, idx);
+        if (!IS_PTE_PRESENT(geo, pte)) return false;
+        if (l == geo->sp_level && IS_PTE_HUGE(geo, pte)) {
+            if (IS_PTE_DIRTY(geo, pte)) return false;
+            write_pte(ctx, table_pfn, idx, pte | geo->pte_dirty_mask);
+            return true;
+        }
+        table_pfn = GET_PTE_PFN(geo, pte);
     }
-}
\ No newline at end of file
+    uint64_t idx = GET_LEVEL_INDEX(geo, va, leaf);
+    uint64_t pte = read_pte(ctx, table_pfn, idx);
+    if (!IS_PTE_PRESENT(geo, pte) || IS_PTE_DIRTY(geo, pte)) return false;
+    write_pte(ctx, table_pfn, idx, pte | geo->pte_dirty_mask);
+    return true;
+}
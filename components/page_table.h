@@ -3,19 +3,60 @@
 
 #include "common.h"
 
+// [pt_reclaim] 테이블 회수 상태 (SimContext 에 포함)
+// valid[pfn] = 테이블 프레임 pfn 의 Present 엔트리 수 (write_pte 가 유지). 0 이 되면 프레임을 해제하고
+// 부모 PTE 를 지움 (위로 연쇄, Root 는 남김). 빈 테이블에는 상태가 없으므로 (스왑 사본은 페이지 키로 찾음)
+// 해제 = 테이블을 내보냈다가 다음 Fault 의 Walk 가 다시 만드는 것과 같음
+// pin[l] = 지금 아래로 갱신 중인 경로의 l 단계 테이블: 그 사이 스왑 아웃이 비워도 해제하지 않음
+typedef struct {
+    uint32_t *valid;   // geo.pt_reclaim 이 0 이면 NULL (카운트도 하지 않음)
+    int pin[MAX_LEVELS];
+} PageTableState;
+
+void init_page_tables(SimContext *ctx);
+void destroy_page_tables(SimContext *ctx);
+
 // 결과 반환용 구조체
 typedef struct {
     int pfn;      // 찾은 물리 프레임 번호 (없으면 -1)
     bool hit;     // 최종 데이터 페이지가 메모리에 있었는지 여부
+    int huge_pfn; // Superpage 매핑이면 블록 첫 프레임 (update_tlb_huge 용), 아니면 -1
 } PT_Result;
 
-// Page Walk 수행 (va를 받아 VPN1,2,3 추출)
-PT_Result walk_page_table(uint16_t va);
+// Page Walk 수행 (va를 받아 단계별 인덱스 추출, geo.levels 단계)
+// 현재 프로세스(ctx->proc.current)의 Root 에서 시작
+PT_Result walk_page_table(SimContext *ctx, uint64_t va);
 
 // [Error 수정] Page Table 업데이트 함수 선언 추가
-void update_page_table(uint16_t va, int new_pfn);
+// 성공 0, 중간 테이블 프레임을 받지 못하면 -1 (PTE 는 쓰지 않음)
+int update_page_table(SimContext *ctx, uint64_t va, int new_pfn);
+
+// 스왑 아웃 시 매핑 끊기 (key = PAGE_KEY(pid, vpn), Victim 은 다른 프로세스의 페이지일 수 있음)
+// Superpage 의 페이지는 먼저 강등해야 함 (sp_before_evict)
+// 반환값: 페이지가 Dirty 였는지 (Geometry 에 Dirty 비트가 없으면 프레임별 Dirty, 확인 후 지움)
+bool invalidate_pt_mapping(SimContext *ctx, uint64_t key);
+
+// 현재 프로세스의 va 쓰기: Leaf PTE 의 Dirty 비트 설정 (하드웨어가 하는 PTE 갱신)
+// Superpage 에 매핑된 va 는 큰 페이지 PTE 의 Dirty 비트 (강등 때 모든 페이지에 물려줌)
+// Geometry 에 Dirty 비트가 없으면 va 가 변환된 프레임 pfn 의 프레임별 Dirty (memory.h, PTE 갱신 없음)
+// 반환값: 이번에 새로 Dirty 가 되었는지 (이미 Dirty 면 false)
+bool mark_pte_dirty(SimContext *ctx, uint64_t va, int pfn);
+
+// key = PAGE_KEY(pid, vpn) 의 level 단계 테이블 프레임 (Root 부터 따라감, level = leaf 면 PT)
+// alloc 이면 없는 중간 테이블을 만들고 (테이블 프레임을 받지 못하면 -1), 아니면 -1. 중간에 큰 페이지 PTE 를 만나도 -1
+int pt_table_at(SimContext *ctx, uint64_t key, int level, bool alloc);
+
+// key 가 지금 매핑되어 있는지 (Superpage 포함). 통계 / 로그 / PWC 없이 테이블도 만들지 않음
+bool pt_is_mapped(SimContext *ctx, uint64_t key);
+
+// pt_is_mapped 와 같은 조회로 key 의 데이터 프레임 (Superpage 면 블록 안 자리), 없으면 -1
+int pt_lookup(SimContext *ctx, uint64_t key);
+
+// 새 프로세스의 Root Page Directory 프레임 할당 (Non-swappable). 실패 시 -1
+int alloc_root_table(SimContext *ctx);
 
-// 스왑 아웃 시 매핑 끊기
-void invalidate_pt_mapping(uint16_t vpn);
+// PTE 읽기/쓰기 (pte_bytes 폭, little-endian)
+uint64_t read_pte(SimContext *ctx, int table_pfn, uint64_t index);
+void write_pte(SimContext *ctx, int table_pfn, uint64_t index, uint64_t pte);
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,192 @@
+/* prefetch.c */
+#include "prefetch.h"
+#include "sim.h"
+#include "page_table.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define PF_NONE UINT64_MAX
+
+void init_prefetch(SimContext *ctx) {
+    PrefetchState *pf = &ctx->pf;
+    const Geometry *geo = &ctx->geo;
+
+    destroy_prefetch(ctx);
+    if (geo->prefetch == PREFETCH_NONE) return;
+    pf->unused = calloc(geo->num_frames, 1);
+    pf->cand = malloc(sizeof(uint64_t) * geo->prefetch_depth);
+    if (!pf->unused || !pf->cand) {
+        perror("malloc prefetch");
+        exit(1);
+    }
+    if (geo->prefetch == PREFETCH_MARKOV) {
+        pf->slots = geo->prefetch_table;
+        pf->key = malloc(sizeof(uint64_t) * pf->slots);
+        pf->next = malloc(sizeof(uint64_t) * pf->slots * PF_MARKOV_WAYS);
+        if (!pf->key || !pf->next) {
+            perror("malloc prefetch table");
+            exit(1);
+        }
+        vmap_init(&pf->index, (uint64_t)pf->slots);
+    }
+}
+
+void destroy_prefetch(SimContext *ctx) {
+    PrefetchState *pf = &ctx->pf;
+    free(pf->unused);
+    free(pf->stream);
+    free(pf->cand);
+    if (pf->key) vmap_destroy(&pf->index);
+    free(pf->key);
+    free(pf->next);
+    memset(pf, 0, sizeof(*pf));
+}
+
+static PrefetchStream* stream_of(PrefetchState *pf, int pid) {
+    if (pid >= pf->streams) {
+        int cap = pf->streams ? pf->streams : 4;
+        while (cap <= pid) cap *= 2;
+        PrefetchStream *s = realloc(pf->stream, sizeof(PrefetchStream) * cap);
+        if (!s) {
+            perror("malloc prefetch streams");
+            exit(1);
+        }
+        memset(s + pf->streams, 0, sizeof(PrefetchStream) * (cap - pf->streams));
+        pf->stream = s;
+        pf->streams = cap;
+    }
+    return &pf->stream[pid];
+}
+
+// --- 예측기: Miss 하나를 학습하고 후보 키를 pf->cand 에 채움 (후보 수 반환) ---
+
+static int seq_predict(SimContext *ctx, PrefetchStream *s, uint64_t key) {
+    (void)s; // 순차 예측은 스트림 상태가 필요 없음
+    int depth = ctx->geo.prefetch_depth;
+    for (int i = 0; i < depth; i++) ctx->pf.cand[i] = key + 1 + i;
+    return depth;
+}
+
+// 간격이 두 번 연속 같아야 예측 (한 번 튄 접근으로 엉뚱한 페이지를 가져오지 않도록)
+static int stride_predict(SimContext *ctx, PrefetchStream *s, uint64_t key) {
+    int n = 0;
+    if (s->valid) {
+        int64_t d = (int64_t)(key - s->last);
+        s->confirmed = d != 0 && d == s->stride;
+        s->stride = d;
+    }
+    s->last = key;
+    s->valid = true;
+    if (!s->confirmed) return 0;
+    for (int i = 1; i <= ctx->geo.prefetch_depth; i++) {
+        ctx->pf.cand[n++] = key + (uint64_t)(s->stride * i);
+    }
+    return n;
+}
+
+static int markov_slot(PrefetchState *pf, uint64_t key) {
+    uint64_t slot;
+    return vmap_get(&pf->index, key, &slot) ? (int)slot : -1;
+}
+
+// prev 다음에 key 가 Miss 났음을 기록 (이미 있으면 맨 앞으로)
+static void markov_record(PrefetchState *pf, uint64_t prev, uint64_t key) {
+    int slot = markov_slot(pf, prev);
+    if (slot == -1) {
+        if (pf->used < pf->slots) {
+            slot = pf->used++;
+        } else {
+            slot = pf->clock;
+            pf->clock = (pf->clock + 1) % pf->slots;
+            vmap_remove(&pf->index, pf->key[slot]);
+        }
+        pf->key[slot] = prev;
+        for (int w = 0; w < PF_MARKOV_WAYS; w++) pf->next[slot * PF_MARKOV_WAYS + w] = PF_NONE;
+        vmap_put(&pf->index, prev, (uint64_t)slot);
+    }
+    uint64_t *next = &pf->next[slot * PF_MARKOV_WAYS];
+    int w = 0;
+    while (w < PF_MARKOV_WAYS - 1 && next[w] != key) w++;
+    memmove(next + 1, next, sizeof(uint64_t) * w);
+    next[0] = key;
+}
+
+// key 의 후속 Miss 들, 모자라면 가장 최근 후속을 따라 한 단계씩 더
+static int markov_predict(SimContext *ctx, PrefetchStream *s, uint64_t key) {
+    PrefetchState *pf = &ctx->pf;
+    int depth = ctx->geo.prefetch_depth;
+    int n = 0;
+
+    if (s->valid && s->last != key) markov_record(pf, s->last, key);
+    s->last = key;
+    s->valid = true;
+
+    uint64_t cur = key;
+    while (n < depth) {
+        int slot = markov_slot(pf, cur);
+        if (slot == -1) break;
+        const uint64_t *next = &pf->next[slot * PF_MARKOV_WAYS];
+        for (int w = 0; w < PF_MARKOV_WAYS && n < depth && next[w] != PF_NONE; w++) {
+            if (next[w] != key) pf->cand[n++] = next[w];
+        }
+        if (next[0] == key) break;
+        cur = next[0];
+    }
+    return n;
+}
+
+typedef int (*PrefetchPredict)(SimContext *ctx, PrefetchStream *s, uint64_t key);
+
+static const PrefetchPredict predictors[] = {
+    [PREFETCH_NONE]   = NULL,
+    [PREFETCH_SEQ]    = seq_predict,
+    [PREFETCH_STRIDE] = stride_predict,
+    [PREFETCH_MARKOV] = markov_predict,
+};
+
+// 비상주 페이지 key 하나를 적재하고 그 프로세스의 Page Table 에 매핑
+// 테이블을 먼저 만들어 두므로 데이터 프레임을 받은 뒤에는 스왑이 일어나지 않음. 메모리가 바닥나면 false
+static bool prefetch_page(SimContext *ctx, uint64_t key) {
+    const Geometry *geo = &ctx->geo;
+    int leaf = geo->levels - 1;
+    int table = pt_table_at(ctx, key, leaf, true);
+    if (table == -1) return true; // 그 사이 승격된 Superpage 안 (이미 상주), 또는 테이블 프레임이 없음 (Fault 가 처리)
+
+    bool sp = ctx->sp.pages != 0;
+    ctx->pt.pin[leaf] = table; // [pt_reclaim] 아래의 스왑 아웃이 이 테이블을 비워도 해제하지 않음
+    ctx->swap.load_prefetch = true;
+    int pfn = sp ? sp_alloc_page(ctx, key) : allocate_free_frame(ctx, key, true);
+    if (pfn == -1) {
+        ctx->swap.load_prefetch = false;
+        if (swap_out(ctx) == -1) return false;
+        ctx->swap.load_prefetch = true;
+        pfn = sp ? sp_alloc_page(ctx, key) : allocate_free_frame(ctx, key, true);
+    }
+    ctx->swap.load_prefetch = false;
+    ctx->pt.pin[leaf] = -1;
+    if (pfn == -1) return false;
+
+    if (swapdev_read(&ctx->swap.device, key, get_frame_ptr(ctx, pfn))) ctx->stats.prefetch_reads++;
+    uint64_t idx = KEY_VPN(geo, key) & ((1ULL << geo->level_bits[leaf]) - 1);
+    write_pte(ctx, table, idx, CREATE_PTE(geo, pfn));
+    ctx->stats.prefetch_issued++;
+    if (sp) sp_try_promote(ctx, key);
+    return true;
+}
+
+void prefetch_issue(SimContext *ctx) {
+    const Geometry *geo = &ctx->geo;
+    uint64_t key = ctx->pf.pending_key;
+    ctx->pf.pending = false;
+    int pid = KEY_PID(geo, key);
+    PrefetchStream *s = stream_of(&ctx->pf, pid);
+    int n = predictors[geo->prefetch](ctx, s, key);
+
+    for (int i = 0; i < n; i++) {
+        uint64_t cand = ctx->pf.cand[i];
+        // 주소 공간 밖 (다른 pid 의 키로 넘어감) 이나 이미 상주하는 페이지는 건너뜀
+        if (KEY_PID(geo, cand) != pid || pt_is_mapped(ctx, cand)) continue;
+        if (!prefetch_page(ctx, cand)) break;
+    }
+}
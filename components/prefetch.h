@@ -0,0 +1,61 @@
+/* prefetch.h */
+#ifndef PREFETCH_H
+#define PREFETCH_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "../common.h"
+#include "vpn_map.h"
+
+// --- Page Fault Prefetcher (geo.prefetch) ---
+// Miss 이벤트 (Page Fault, prefetch 로 들어온 페이지의 첫 접근) 마다 예측기를 학습시키고
+// 예측한 같은 프로세스의 비상주 페이지를 최대 prefetch_depth 개 미리 적재 / 매핑
+//   seq:    다음 페이지들 (v+1 ... v+depth)
+//   stride: 연속한 두 Miss 간격이 같으면 그 간격으로 (v+d ... v+depth*d)
+//   markov: Miss 키 -> 그 다음 Miss 키 (최근 것부터 PF_MARKOV_WAYS 개) 상관 테이블을 따라감
+// prefetch 된 페이지는 교체 정책에 아직 참조되지 않은 페이지로 들어가고 (SwapState.load_prefetch:
+// CLOCK 계열은 참조 비트 / test 기간 없이, 2Q / ARC 는 ghost 기록을 쓰지 않고 A1in / T1 으로),
+// 스왑 장치 읽기는 비동기 I/O 로 보고 cycle 에 넣지 않음 (prefetch_reads 로 따로 셈)
+// TLB 에는 넣지 않음 (첫 접근은 Page Walk Hit)
+#define PF_MARKOV_WAYS 2
+
+// pid 별 Miss 흐름 (seq 는 쓰지 않음)
+typedef struct {
+    uint64_t last;        // 직전 Miss 의 페이지 키
+    int64_t stride;       // 직전 두 Miss 의 간격
+    bool valid;           // last 가 있음
+    bool confirmed;       // 같은 간격이 두 번 연속 (stride 예측 가능)
+} PrefetchStream;
+
+typedef struct {
+    uint8_t *unused;      // 프레임별: prefetch 로 적재된 뒤 아직 접근 전 (prefetch 가 꺼져 있으면 NULL)
+    PrefetchStream *stream; // pid -> Miss 흐름
+    int streams;
+    // [markov] 상관 테이블 (slot 은 FIFO 로 재사용)
+    VpnMap index;         // 키 -> slot
+    uint64_t *key;        // slot -> 키
+    uint64_t *next;       // slot * PF_MARKOV_WAYS, [0] 이 가장 최근 (UINT64_MAX = 없음)
+    int slots;
+    int used;             // 채운 slot 수
+    int clock;            // 다음에 재사용할 slot
+    uint64_t *cand;       // 이번 Miss 의 후보 키 (prefetch_depth 개)
+    bool pending;         // 다음 접근 시작 때 처리할 Miss 가 있음
+    uint64_t pending_key;
+} PrefetchState;
+
+// init_swap 이후 호출
+void init_prefetch(SimContext *ctx);
+void destroy_prefetch(SimContext *ctx);
+
+// 요청한 접근을 끝낸 뒤 호출 (key = 이번 접근의 페이지 키)
+// 예측 / 적재는 다음 접근을 시작할 때: 돌려준 PA 는 다음 접근 전까지 유효해야 하는데
+// prefetch 의 스왑 아웃이 방금 접근한 페이지를 내보낼 수 있음
+static inline void prefetch_note_miss(PrefetchState *pf, uint64_t key) {
+    pf->pending = true;
+    pf->pending_key = key;
+}
+
+// 미뤄 둔 Miss 처리 (pending 일 때 접근 시작에서 호출)
+void prefetch_issue(SimContext *ctx);
+
+#endif
@@ -0,0 +1,96 @@
+/* process.c */
+#include "process.h"
+#include "page_table.h"
+#include "tlb.h"
+#include "sim.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// pid 슬롯을 need 개 이상으로 늘림 (새 슬롯은 Root 없음)
+static int grow_table(ProcessTable *pt, int need) {
+    int cap = pt->count ? pt->count : 4;
+    while (cap < need) cap *= 2;
+    int *roots = realloc(pt->root_pfn, sizeof(int) * cap);
+    if (roots) pt->root_pfn = roots;
+    ProcessStats *stats = realloc(pt->stats, sizeof(ProcessStats) * cap);
+    if (stats) pt->stats = stats;
+    uint64_t *cpumask = realloc(pt->cpumask, sizeof(uint64_t) * cap);
+    if (cpumask) pt->cpumask = cpumask;
+    uint64_t *stale = realloc(pt->stale_mask, sizeof(uint64_t) * cap);
+    if (stale) pt->stale_mask = stale;
+    if (!roots || !stats || !cpumask || !stale) {
+        perror("malloc process table");
+        return -1;
+    }
+    for (int i = pt->count; i < cap; i++) pt->root_pfn[i] = -1;
+    memset(pt->stats + pt->count, 0, sizeof(ProcessStats) * (cap - pt->count));
+    memset(pt->cpumask + pt->count, 0, sizeof(uint64_t) * (cap - pt->count));
+    memset(pt->stale_mask + pt->count, 0, sizeof(uint64_t) * (cap - pt->count));
+    pt->count = cap;
+    return 0;
+}
+
+void init_processes(SimContext *ctx) {
+    ProcessTable *pt = &ctx->proc;
+    destroy_processes(ctx);
+    if (grow_table(pt, 1) != 0) exit(1);
+    pt->root_pfn[0] = ctx->geo.root_pfn; // init_memory 가 예약해 둔 프레임
+    pt->cpumask[0] = ctx->num_cores == MAX_CORES ? UINT64_MAX : (1ULL << ctx->num_cores) - 1;
+    pt->current = 0;
+    pt->key_base = 0;
+}
+
+void destroy_processes(SimContext *ctx) {
+    ProcessTable *pt = &ctx->proc;
+    free(pt->root_pfn);
+    free(pt->stats);
+    free(pt->cpumask);
+    free(pt->stale_mask);
+    memset(pt, 0, sizeof(*pt));
+}
+
+int process_switch(SimContext *ctx, int pid) {
+    ProcessTable *pt = &ctx->proc;
+    if (pid == pt->current) return 0;
+
+    if (pid < 0 || pid >= (1 << ctx->geo.asid_bits)) {
+        fprintf(stderr, "Error: pid %d exceeds the %d-bit ASID space of this geometry.\n",
+                pid, ctx->geo.asid_bits);
+        return -1;
+    }
+    if (pid >= pt->count && grow_table(pt, pid + 1) != 0) return -1;
+
+    // 새 주소 공간: Root 는 교체되지 않는 테이블 프레임
+    if (pt->root_pfn[pid] == -1) {
+        int root = alloc_root_table(ctx);
+        if (root == -1) return -1;
+        pt->root_pfn[pid] = root;
+    }
+
+    // ASID 가 없으면 이전 프로세스의 변환은 모두 무효 (태그로 구분할 수 없으므로)
+    uint64_t bit = 1ULL << ctx->core;
+    if (!ctx->geo.tlb_asid) {
+        ctx->stats.tlb_flushes++;
+        ctx->stats.tlb_flush_entries += flush_tlb(ctx);
+        pwc_flush(&ctx->cores[ctx->core].pwc); // 캐시된 상위 PTE 도 태그로 구분할 수 없음
+        pt->cpumask[pt->current] &= ~bit;
+        pt->stale_mask[pt->current] &= ~bit;
+    }
+
+    // [Lazy] 실행하지 않는 동안 스왑 아웃된 pid 의 페이지가 있으면 pid 엔트리를 모두 버림
+    if (pt->stale_mask[pid] & bit) {
+        ctx->stats.deferred_flushes++;
+        ctx->stats.deferred_flush_entries += flush_tlb_pid(ctx, ctx->tlb, pid);
+        pt->stale_mask[pid] &= ~bit;
+    }
+    pt->cpumask[pid] |= bit;
+
+    pt->current = pid;
+    pt->key_base = PAGE_KEY(&ctx->geo, pid, 0);
+    ctx->cores[ctx->core].pid = pid;
+    ctx->cores[ctx->core].key_base = pt->key_base;
+    pt->stats[pid].switches_in++;
+    ctx->stats.context_switches++;
+    return 0;
+}
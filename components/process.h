@@ -0,0 +1,32 @@
+/* process.h */
+#ifndef PROCESS_H
+#define PROCESS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "../common.h"
+#include "stats.h"
+
+// --- 프로세스 (주소 공간) 테이블 ---
+// pid 마다 Root Page Directory 하나와 카운터 하나
+// pid 0 의 Root 는 기존과 같은 geo.root_pfn, 나머지는 처음 문맥 교환될 때 테이블 프레임으로 할당
+typedef struct {
+    int *root_pfn;          // pid -> Root PFN (-1 = 아직 없음)
+    ProcessStats *stats;    // pid -> 카운터
+    uint64_t *cpumask;      // pid -> TLB 에 그 pid 의 엔트리가 있을 수 있는 코어 (bit c = 코어 c)
+    uint64_t *stale_mask;   // pid -> [Lazy] 그 pid 로 돌아올 때 pid 엔트리를 비워야 하는 코어
+    int count;              // 할당된 pid 슬롯 수 (지금까지 본 가장 큰 pid + 1 이상)
+    int current;            // 선택된 코어(ctx->core)가 실행 중인 pid
+    uint64_t key_base;      // PAGE_KEY(geo, current, 0)
+} ProcessTable;
+
+// 초기화 (init_memory / init_cores 이후 호출, 모든 코어가 pid 0 으로 시작)
+void init_processes(SimContext *ctx);
+void destroy_processes(SimContext *ctx);
+
+// 선택된 코어의 문맥 교환: pid 가 처음이면 Root 테이블 할당
+// ASID 없는 TLB (geo.tlb_asid == 0) 는 여기서 전체 flush, lazy shootdown 이 미뤄둔 flush 도 여기서
+// 성공 0, pid 범위 초과 또는 Root 할당 실패 시 -1
+int process_switch(SimContext *ctx, int pid);
+
+#endif
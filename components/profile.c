@@ -0,0 +1,198 @@
+/* profile.c */
+#include "profile.h"
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+#include <unistd.h>
+
+#ifdef __linux__
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#endif
+
+__thread Profiler *prof_active = NULL;
+
+static const char *stage_names[PROF_STAGES] = {
+    "trace", "access", "tlb", "walk", "fault", "evict", "log"
+};
+
+static const char *counter_names[PROF_COUNTERS] = { "cycles", "instructions", "cache-misses" };
+
+static double wall_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+#ifdef __linux__
+// 카운터 하나 열기: group_fd 가 -1 이면 그룹 리더 (리더가 멈춘 상태로 시작, prof_start 에서 켬)
+static int open_counter(uint64_t config, int group_fd) {
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.config = config;
+    attr.disabled = group_fd == -1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_GROUP;
+    return (int)syscall(SYS_perf_event_open, &attr, 0, -1, group_fd, 0);
+}
+#endif
+
+void prof_init(Profiler *p, bool with_perf) {
+    memset(p, 0, sizeof(*p));
+    for (int i = 0; i < PROF_COUNTERS; i++) p->perf_fd[i] = -1;
+    if (!with_perf) return;
+
+#ifdef __linux__
+    static const uint64_t configs[PROF_COUNTERS] = {
+        PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_CACHE_MISSES
+    };
+    // 그룹 한 번의 read() 로 세 값을 같이 읽음. 일부만 열리면 앞쪽 것만 사용
+    for (int i = 0; i < PROF_COUNTERS; i++) {
+        int fd = open_counter(configs[i], i == 0 ? -1 : p->perf_fd[0]);
+        if (fd < 0) {
+            fprintf(stderr, "[Profile] perf_event_open(%s) failed: %s%s\n", counter_names[i], strerror(errno),
+                    (errno == EACCES || errno == EPERM) ? " (see /proc/sys/kernel/perf_event_paranoid)" :
+                    errno == ENOENT ? " (no hardware PMU, e.g. a virtual machine)" : "");
+            break;
+        }
+        p->perf_fd[i] = fd;
+        p->perf_n++;
+    }
+    if (p->perf_n == 0) fprintf(stderr, "[Profile] hardware counters unavailable, timing only\n");
+#else
+    fprintf(stderr, "[Profile] hardware counters need Linux perf_event_open, timing only\n");
+#endif
+}
+
+void prof_destroy(Profiler *p) {
+    if (prof_active == p) prof_active = NULL;
+    for (int i = 0; i < PROF_COUNTERS; i++) {
+        if (p->perf_fd[i] >= 0) close(p->perf_fd[i]);
+        p->perf_fd[i] = -1;
+    }
+    p->perf_n = 0;
+}
+
+void prof_read_counters(const Profiler *p, uint64_t *out) {
+    uint64_t buf[1 + PROF_COUNTERS] = { 0 }; // PERF_FORMAT_GROUP: nr, value...
+    if (read(p->perf_fd[0], buf, sizeof(buf)) < (ssize_t)(sizeof(uint64_t) * (1 + p->perf_n))) {
+        memset(buf, 0, sizeof(buf));
+    }
+    for (int i = 0; i < PROF_COUNTERS; i++) out[i] = i < p->perf_n ? buf[1 + i] : 0;
+}
+
+void prof_start(Profiler *p) {
+    // 빈 단계 하나의 진입 + 탈출 비용 (단계마다 mean 에 이만큼 섞여 있음). 기록은 버림
+    enum { CALIBRATE = 1000 };
+    uint64_t t0 = prof_ticks();
+    for (int i = 0; i < CALIBRATE; i++) {
+        prof_enter(p, PROF_TRACE);
+        prof_exit(p);
+    }
+    p->overhead = (prof_ticks() - t0) / CALIBRATE;
+    memset(p->stages, 0, sizeof(p->stages));
+
+#ifdef __linux__
+    if (p->perf_n) ioctl(p->perf_fd[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+#endif
+    p->wall_start = wall_seconds();
+    p->t_start = prof_ticks();
+    prof_active = p;
+}
+
+void prof_stop(Profiler *p) {
+    p->t_stop = prof_ticks();
+    p->wall_stop = wall_seconds();
+    if (prof_active == p) prof_active = NULL;
+#ifdef __linux__
+    if (p->perf_n) ioctl(p->perf_fd[0], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+#endif
+}
+
+// 히스토그램에서 q 분위가 들어 있는 버킷의 상한 (tick)
+static uint64_t hist_quantile(const ProfStageStats *s, double q) {
+    uint64_t target = (uint64_t)(q * s->calls), seen = 0;
+    for (int b = 0; b < PROF_BUCKETS; b++) {
+        seen += s->hist[b];
+        if (seen > target) return b >= 63 || (2ULL << b) > s->max ? s->max : (2ULL << b);
+    }
+    return s->max;
+}
+
+// 크기에 맞는 단위로 (ns / us / ms)
+static const char* fmt_ns(char *buf, size_t len, double ns) {
+    if (ns < 1e4) snprintf(buf, len, "%.0fns", ns);
+    else if (ns < 1e7) snprintf(buf, len, "%.1fus", ns / 1e3);
+    else snprintf(buf, len, "%.1fms", ns / 1e6);
+    return buf;
+}
+
+void prof_print(const Profiler *p, FILE *fp) {
+    uint64_t span = p->t_stop - p->t_start;
+    double wall = p->wall_stop - p->wall_start;
+    double ns_per_tick = span ? wall * 1e9 / span : 1.0;
+    char a[32], b[32], c[32], d[32], e[32];
+
+#if defined(__x86_64__) || defined(__i386__)
+    fprintf(fp, "[Profile] %.3f s, %llu accesses (rdtsc, %.3f GHz, ~%.0fns timer cost per call)\n", wall,
+            (unsigned long long)p->accesses, ns_per_tick > 0 ? 1.0 / ns_per_tick : 0.0, p->overhead * ns_per_tick);
+#else
+    fprintf(fp, "[Profile] %.3f s, %llu accesses (clock_gettime, ~%.0fns timer cost per call)\n", wall,
+            (unsigned long long)p->accesses, p->overhead * ns_per_tick);
+#endif
+    fprintf(fp, "  %-8s %12s %10s %7s %9s %9s %9s %9s", "stage", "calls", "self", "self%",
+            "mean", "p50", "p99", "max");
+    if (p->perf_n) {
+        for (int i = 0; i < p->perf_n; i++) fprintf(fp, " %14s", counter_names[i]);
+        if (p->perf_n >= 2) fprintf(fp, " %6s", "IPC");
+    }
+    fputc('\n', fp);
+
+    // self 는 안쪽 단계를 뺀 값이라 합하면 측정 구간을 넘지 않음. 나머지는 other (배치 루프, 표본 추출 등)
+    uint64_t accounted = 0;
+    uint64_t counted[PROF_COUNTERS] = { 0 };
+    for (int st = 0; st < PROF_STAGES; st++) {
+        const ProfStageStats *s = &p->stages[st];
+        accounted += s->self;
+        for (int i = 0; i < PROF_COUNTERS; i++) counted[i] += s->counter[i];
+        if (!s->calls) continue;
+        fprintf(fp, "  %-8s %12llu %10s %6.1f%% %9s %9s %9s %9s", stage_names[st], (unsigned long long)s->calls,
+                fmt_ns(a, sizeof(a), s->self * ns_per_tick), span ? 100.0 * s->self / span : 0.0,
+                fmt_ns(b, sizeof(b), (double)s->total / s->calls * ns_per_tick),
+                fmt_ns(c, sizeof(c), hist_quantile(s, 0.5) * ns_per_tick),
+                fmt_ns(d, sizeof(d), hist_quantile(s, 0.99) * ns_per_tick),
+                fmt_ns(e, sizeof(e), s->max * ns_per_tick));
+        if (p->perf_n) {
+            for (int i = 0; i < p->perf_n; i++) fprintf(fp, " %14llu", (unsigned long long)s->counter[i]);
+            if (p->perf_n >= 2) fprintf(fp, " %6.2f", s->counter[0] ? (double)s->counter[1] / s->counter[0] : 0.0);
+        }
+        fputc('\n', fp);
+    }
+    uint64_t other = span > accounted ? span - accounted : 0;
+    fprintf(fp, "  %-8s %12s %10s %6.1f%%\n", "other", "", fmt_ns(a, sizeof(a), other * ns_per_tick),
+            span ? 100.0 * other / span : 0.0);
+    if (p->perf_n) {
+        fprintf(fp, "  counters cover the stages only (user space):");
+        for (int i = 0; i < p->perf_n; i++) fprintf(fp, " %s %llu", counter_names[i], (unsigned long long)counted[i]);
+        fputc('\n', fp);
+    }
+
+    // 호출당 지연 시간 (안쪽 단계 포함): 비어 있지 않은 log2 버킷의 상한과 호출 수
+    fprintf(fp, "[Profile] latency histograms (calls per bucket, upper bound)\n");
+    for (int st = 0; st < PROF_STAGES; st++) {
+        const ProfStageStats *s = &p->stages[st];
+        if (!s->calls) continue;
+        fprintf(fp, "  %-8s", stage_names[st]);
+        for (int bk = 0; bk < PROF_BUCKETS; bk++) {
+            if (!s->hist[bk]) continue;
+            fprintf(fp, " <%s:%llu", fmt_ns(a, sizeof(a), (double)(2ULL << (bk < 63 ? bk : 62)) * ns_per_tick),
+                    (unsigned long long)s->hist[bk]);
+        }
+        fputc('\n', fp);
+    }
+}
@@ -0,0 +1,142 @@
+/* profile.h */
+#ifndef PROFILE_H
+#define PROFILE_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+// --- 단계별 시간 측정 (make PROFILE=1) ---
+// 시뮬레이터 State Machine 의 단계마다 진입 / 탈출 시각을 재서 호출 수, 자기 시간 (안쪽 단계 제외),
+// 호출당 지연 시간의 log2 히스토그램을 모음. 종료 시 단계별 분해를 출력 (main 의 -X)
+// SIM_PROFILE 없이 빌드하면 PROF_ENTER / PROF_EXIT 는 빈 매크로라 hot path 에 아무것도 남지 않음
+// (Makefile 은 헤더 의존성을 추적하지 않으므로 PROFILE 을 바꿀 때는 make clean 먼저)
+// 시계: x86 은 rdtsc (종료 시 clock_gettime 과 비교해 ns 로 환산), 그 밖은 clock_gettime
+// -X perf: perf_event_open 으로 사용자 공간 cycles / instructions / cache-misses 도 단계별로 나눔
+// (경계마다 read() 시스템 콜이라 실행이 크게 느려짐, 카운터는 exclude_kernel 이라 영향이 적음)
+// 측정 대상은 활성화한 스레드 하나 (prof_active 가 스레드 지역 변수)
+typedef enum {
+    PROF_TRACE,   // 트레이스 레코드 읽기 (main 의 trace_next)
+    PROF_ACCESS,  // access_one 의 나머지 (통계, 프레임 접근 표시, prefetch / tier 처리)
+    PROF_TLB,     // search_tlb / update_tlb
+    PROF_WALK,    // walk_page_table
+    PROF_FAULT,   // Page Fault 처리 (프레임 할당, Swap-in, Page Table 갱신)
+    PROF_EVICT,   // swap_out (Victim 선정, write-back, shootdown)
+    PROF_LOG,     // log_event (포맷 + 버퍼 flush 의 fwrite)
+    PROF_STAGES
+} ProfStage;
+
+#define PROF_BUCKETS 64  // 버킷 b: [2^b, 2^(b+1)) tick
+#define PROF_DEPTH 16    // 단계 중첩 한도 (넘으면 안쪽 단계는 바깥 단계에 포함)
+#define PROF_COUNTERS 3  // cycles, instructions, cache-misses
+
+typedef struct {
+    uint64_t calls;
+    uint64_t self;                     // 안쪽 단계를 뺀 tick 합
+    uint64_t total;                    // 안쪽 단계 포함 tick 합
+    uint64_t max;
+    uint64_t hist[PROF_BUCKETS];       // 호출당 (안쪽 포함) tick 의 log2 히스토그램
+    uint64_t counter[PROF_COUNTERS];   // 자기 구간의 하드웨어 카운터
+} ProfStageStats;
+
+typedef struct {
+    int stage;
+    uint64_t t0;
+    uint64_t child;                    // 안쪽 단계가 쓴 tick
+    uint64_t c0[PROF_COUNTERS];
+    uint64_t cchild[PROF_COUNTERS];
+} ProfFrame;
+
+typedef struct {
+    ProfStageStats stages[PROF_STAGES];
+    ProfFrame stack[PROF_DEPTH];
+    int depth;
+    int skipped;                       // 한도를 넘어 기록하지 않은 중첩 깊이
+
+    int perf_fd[PROF_COUNTERS];        // -1 이면 없음 (perf_fd[0] 이 그룹 리더)
+    int perf_n;                        // 연 카운터 수 (0 이면 카운터 없음)
+
+    uint64_t overhead;                 // 빈 단계 하나의 진입 + 탈출 tick (prof_start 에서 잼)
+    uint64_t t_start, t_stop;          // prof_start / prof_stop 의 tick
+    double wall_start, wall_stop;      // 같은 순간의 clock_gettime 초 (tick -> ns 환산)
+    uint64_t accesses;                 // 출력용 (호출자가 채움)
+} Profiler;
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+static inline uint64_t prof_ticks(void) { return __rdtsc(); }
+#else
+#include <time.h>
+static inline uint64_t prof_ticks(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+#endif
+
+// 지금 스레드에서 기록 중인 Profiler (없으면 NULL, PROF_* 매크로가 아무것도 하지 않음)
+extern __thread Profiler *prof_active;
+
+// with_perf: 하드웨어 카운터도 열어 봄 (실패하면 이유를 stderr 에 쓰고 시간만 측정)
+void prof_init(Profiler *p, bool with_perf);
+void prof_destroy(Profiler *p);
+// 측정 시작 / 끝 (이 사이의 시간이 분해의 100%), prof_start 는 prof_active 를 p 로 설정
+void prof_start(Profiler *p);
+void prof_stop(Profiler *p);
+// 단계별 분해 + 히스토그램
+void prof_print(const Profiler *p, FILE *fp);
+
+// 카운터 읽기 (out-of-line, perf_n > 0 일 때만)
+void prof_read_counters(const Profiler *p, uint64_t *out);
+
+static inline void prof_enter(Profiler *p, int stage) {
+    if (p->depth == PROF_DEPTH) {
+        p->skipped++;
+        return;
+    }
+    ProfFrame *f = &p->stack[p->depth++];
+    f->stage = stage;
+    f->child = 0;
+    if (p->perf_n) {
+        prof_read_counters(p, f->c0);
+        for (int i = 0; i < PROF_COUNTERS; i++) f->cchild[i] = 0;
+    }
+    f->t0 = prof_ticks();
+}
+
+static inline void prof_exit(Profiler *p) {
+    uint64_t t1 = prof_ticks();
+    if (p->skipped) {
+        p->skipped--;
+        return;
+    }
+    ProfFrame *f = &p->stack[--p->depth];
+    ProfStageStats *s = &p->stages[f->stage];
+    uint64_t dt = t1 - f->t0;
+    s->calls++;
+    s->total += dt;
+    s->self += dt - f->child;
+    if (dt > s->max) s->max = dt;
+    s->hist[63 - __builtin_clzll(dt | 1)]++;
+    if (p->depth > 0) p->stack[p->depth - 1].child += dt;
+
+    if (p->perf_n) {
+        uint64_t c1[PROF_COUNTERS];
+        prof_read_counters(p, c1);
+        for (int i = 0; i < PROF_COUNTERS; i++) {
+            uint64_t d = c1[i] - f->c0[i];
+            s->counter[i] += d - f->cchild[i];
+            if (p->depth > 0) p->stack[p->depth - 1].cchild[i] += d;
+        }
+    }
+}
+
+#ifdef SIM_PROFILE
+#define PROF_ENTER(stage) do { if (prof_active) prof_enter(prof_active, (stage)); } while (0)
+#define PROF_EXIT(stage)  do { if (prof_active) prof_exit(prof_active); } while (0)
+#else
+#define PROF_ENTER(stage) ((void)0)
+#define PROF_EXIT(stage)  ((void)0)
+#endif
+
+#endif
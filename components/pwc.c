@@ -0,0 +1,101 @@
+/* pwc.c */
+#include "pwc.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// l 단계 엔트리의 태그: 키에서 l+1 ~ Leaf 단계 인덱스를 떼어낸 값 (pid 는 상위 비트에 그대로 남음)
+static inline uint64_t level_tag(const Geometry *geo, uint64_t key, int l) {
+    return key >> (geo->level_shift[l] - geo->offset_bits);
+}
+
+void init_pwc(PWCState *pwc, const Geometry *geo) {
+    memset(pwc, 0, sizeof(*pwc));
+    pwc->entries = geo->pwc_entries;
+    pwc->levels = geo->levels - 1;
+    if (!pwc->entries) return;
+
+    size_t n = (size_t)pwc->levels * pwc->entries;
+    pwc->tag = malloc(sizeof(uint64_t) * n);
+    pwc->pfn = calloc(n, sizeof(uint32_t));
+    pwc->stamp = calloc(n, sizeof(uint64_t));
+    if (!pwc->tag || !pwc->pfn || !pwc->stamp) {
+        perror("malloc page walk cache");
+        exit(1);
+    }
+    for (size_t i = 0; i < n; i++) pwc->tag[i] = PWC_TAG_INVALID;
+}
+
+void destroy_pwc(PWCState *pwc) {
+    free(pwc->tag);
+    free(pwc->pfn);
+    free(pwc->stamp);
+    memset(pwc, 0, sizeof(*pwc));
+}
+
+int pwc_lookup(PWCState *pwc, const Geometry *geo, uint64_t key, int *table_pfn) {
+    pwc->clock++;
+    // 깊은 단계부터: Hit 하면 그 위 단계는 볼 필요 없음
+    for (int l = pwc->levels - 1; l >= 0; l--) {
+        uint64_t tag = level_tag(geo, key, l);
+        size_t base = (size_t)l * pwc->entries;
+        for (int i = 0; i < pwc->entries; i++) {
+            if (pwc->tag[base + i] == tag) {
+                pwc->stamp[base + i] = pwc->clock;
+                *table_pfn = (int)pwc->pfn[base + i];
+                return l;
+            }
+        }
+    }
+    return -1;
+}
+
+void pwc_fill(PWCState *pwc, const Geometry *geo, uint64_t key, int level, int table_pfn) {
+    uint64_t tag = level_tag(geo, key, level);
+    size_t base = (size_t)level * pwc->entries;
+
+    // 같은 태그가 있으면 그곳, 다음은 빈 엔트리, 없으면 LRU (stamp 가 가장 작은 엔트리)
+    // (pwc_invalidate 로 중간에 빈 엔트리가 생길 수 있으므로 태그는 끝까지 확인)
+    int victim = 0, empty = -1;
+    for (int i = 0; i < pwc->entries; i++) {
+        if (pwc->tag[base + i] == tag) {
+            empty = i;
+            break;
+        }
+        if (pwc->tag[base + i] == PWC_TAG_INVALID) {
+            if (empty == -1) empty = i;
+            continue;
+        }
+        if (pwc->stamp[base + i] < pwc->stamp[base + victim]) victim = i;
+    }
+    if (empty != -1) victim = empty;
+    pwc->tag[base + victim] = tag;
+    pwc->pfn[base + victim] = (uint32_t)table_pfn;
+    pwc->stamp[base + victim] = pwc->clock;
+}
+
+uint64_t pwc_invalidate(PWCState *pwc, const Geometry *geo, uint64_t key, int level) {
+    uint64_t dropped = 0;
+    int range_bits = geo->level_shift[level] - geo->offset_bits;
+    uint64_t range = key >> range_bits;
+    for (int l = level; l < pwc->levels; l++) {
+        int shift = range_bits - (geo->level_shift[l] - geo->offset_bits);
+        size_t base = (size_t)l * pwc->entries;
+        for (int i = 0; i < pwc->entries; i++) {
+            if (pwc->tag[base + i] == PWC_TAG_INVALID || pwc->tag[base + i] >> shift != range) continue;
+            pwc->tag[base + i] = PWC_TAG_INVALID;
+            dropped++;
+        }
+    }
+    return dropped;
+}
+
+uint64_t pwc_flush(PWCState *pwc) {
+    uint64_t dropped = 0;
+    size_t n = (size_t)pwc->levels * pwc->entries;
+    for (size_t i = 0; i < n; i++) {
+        if (pwc->tag[i] != PWC_TAG_INVALID) dropped++;
+        pwc->tag[i] = PWC_TAG_INVALID;
+    }
+    return dropped;
+}
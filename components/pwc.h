@@ -0,0 +1,42 @@
+/* pwc.h */
+#ifndef PWC_H
+#define PWC_H
+
+#include <stdint.h>
+#include "../common.h"
+
+// --- Page Walk Cache (paging-structure cache) ---
+// Leaf 위의 단계(PD1, PD2 ...) PTE 를 단계별로 캐시: (pid, 그 단계까지의 VA 인덱스) -> 다음 단계 테이블 프레임
+// Page Walk 는 가장 깊은 Hit 단계의 다음 테이블에서 시작하므로 위쪽 단계의 메모리 읽기를 건너뜀
+// Leaf PTE 는 캐시하지 않으므로 스왑 아웃(Present 비트만 끔)과는 무관함
+// 불변식: 캐시된 엔트리가 가리키는 테이블 프레임은 항상 그 경로에 붙어 있는 테이블
+// 그래서 테이블을 경로에서 떼어 내는 곳마다 무효화함: ASID 없는 문맥 교환 flush,
+// Superpage 승격 (그 영역의 하위 테이블), [pt_reclaim] 빈 테이블 해제 (reclaim_tables, 모든 코어에서)
+// 코어마다 하나 (Core.pwc), 단계별 fully associative + LRU
+#define PWC_TAG_INVALID UINT64_MAX
+
+typedef struct {
+    int entries;          // 단계별 엔트리 수 (0 = PWC 없음)
+    int levels;           // 캐시하는 단계 수 (= geo.levels - 1)
+    uint64_t *tag;        // [level * entries + i] 페이지 키의 상위 비트 (PWC_TAG_INVALID = 빈 엔트리)
+    uint32_t *pfn;        // 다음 단계 테이블 프레임
+    uint64_t *stamp;      // [LRU] 마지막 사용 시점
+    uint64_t clock;
+} PWCState;
+
+void init_pwc(PWCState *pwc, const Geometry *geo);
+void destroy_pwc(PWCState *pwc);
+
+// key = PAGE_KEY(pid, vpn). Hit 한 가장 깊은 단계 l (없으면 -1), *table_pfn 에 l+1 단계 테이블
+int pwc_lookup(PWCState *pwc, const Geometry *geo, uint64_t key, int *table_pfn);
+
+// Walk 중 읽은 level 단계 PTE (-> table_pfn) 기록 (가득 차면 LRU 엔트리 교체)
+void pwc_fill(PWCState *pwc, const Geometry *geo, uint64_t key, int level, int table_pfn);
+
+// key 를 덮는 level 단계 엔트리와 그 범위 안의 더 깊은 단계 엔트리 무효화. 반환값: 버린 엔트리 수
+uint64_t pwc_invalidate(PWCState *pwc, const Geometry *geo, uint64_t key, int level);
+
+// 전체 무효화. 반환값: 버린 유효 엔트리 수
+uint64_t pwc_flush(PWCState *pwc);
+
+#endif
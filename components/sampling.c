@@ -0,0 +1,182 @@
+/* sampling.c */
+#include "sampling.h"
+#include "sim.h"
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+static const char *metric_names[SAMPLE_METRICS] = {
+    "tlb_miss_rate", "page_fault_rate", "swap_out_rate", "amat"
+};
+// 외삽한 전체 값의 이름 (지표 x 전체 레코드 수)
+static const char *total_names[SAMPLE_METRICS] = {
+    "tlb_misses", "page_faults", "swap_outs", "cycles"
+};
+
+int sampling_parse(SamplingState *s, const char *spec) {
+    uint64_t v[3] = { 0, 0, UINT64_MAX };
+    const char *p = spec;
+    int n = 0;
+    while (1) {
+        if (n == 3) return -1;
+        char *end;
+        v[n++] = strtoull(p, &end, 0);
+        if (end == p || (*end && *end != ',')) return -1;
+        if (!*end) break;
+        p = end + 1;
+    }
+    memset(s, 0, sizeof(*s));
+    s->period = v[0];
+    s->window = v[1];
+    s->warmup = v[2] == UINT64_MAX ? v[1] / 10 : v[2];
+    if (n < 2 || s->period == 0 || s->window == 0 || s->window > s->period || s->warmup >= s->window) {
+        fprintf(stderr, "Sampling: need period >= window > warmup (-P <period>,<window>[,<warmup>])\n");
+        return -1;
+    }
+    return 0;
+}
+
+static double ratio(uint64_t num, uint64_t den) {
+    return den ? (double)num / den : 0.0;
+}
+
+// 측정 구간 하나를 표본으로
+static void close_sample(SimContext *ctx, SamplingState *s) {
+    const Stats *a = &s->start, *b = &ctx->stats;
+    uint64_t n = b->accesses - a->accesses;
+    double x[SAMPLE_METRICS] = {
+        [SAMPLE_TLB_MISS_RATE]   = ratio(b->tlb_misses - a->tlb_misses, n),
+        [SAMPLE_PAGE_FAULT_RATE] = ratio(b->pt_misses - a->pt_misses, n),
+        [SAMPLE_SWAP_OUT_RATE]   = ratio(b->swap_outs - a->swap_outs, n),
+        [SAMPLE_AMAT]            = ratio(stats_total_cycles(b) - stats_total_cycles(a), n),
+    };
+    for (int m = 0; m < SAMPLE_METRICS; m++) {
+        s->sum[m] += x[m];
+        s->sumsq[m] += x[m] * x[m];
+    }
+    s->samples++;
+}
+
+size_t sampling_run(SimContext *ctx, SamplingState *s, const uint64_t *va, const uint8_t *write, size_t n) {
+    uint64_t detail_at = s->period - s->window;
+    uint64_t measure_at = detail_at + s->warmup;
+    size_t i = 0;
+
+    while (i < n) {
+        // 이번 단계가 끝나는 period 안의 위치
+        uint64_t end = s->pos < detail_at ? detail_at : (s->pos < measure_at ? measure_at : s->period);
+        size_t len = end - s->pos < n - i ? (size_t)(end - s->pos) : n - i;
+        const uint8_t *w = write ? write + i : NULL;
+        size_t done;
+
+        if (s->pos < detail_at) {
+            done = sim_fast_forward(ctx, va + i, w, len);
+        } else {
+            if (s->pos == measure_at) s->start = ctx->stats;
+            done = translate_batch_rw(ctx, va + i, w, NULL, len);
+            s->detailed += done;
+        }
+        s->pos += done;
+        s->records += done;
+        i += done;
+        if (done < len) break;
+
+        if (s->pos == s->period) {
+            close_sample(ctx, s);
+            s->pos = 0;
+        }
+    }
+    return i;
+}
+
+// 양측 95% Student t 분위수 (자유도 df)
+static double t_quantile(uint64_t df) {
+    static const double t[30] = {
+        12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+        2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+        2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042
+    };
+    if (df <= 30) return t[df - 1];
+    if (df <= 40) return 2.021;
+    if (df <= 60) return 2.000;
+    if (df <= 120) return 1.980;
+    return 1.960;
+}
+
+typedef struct {
+    double mean;
+    double half;    // 95% 신뢰구간 반폭 (표본이 둘 미만이면 음수 = 없음)
+} Estimate;
+
+static Estimate estimate(const SamplingState *s, int m) {
+    Estimate e = { 0.0, -1.0 };
+    if (s->samples == 0) return e;
+    double n = (double)s->samples;
+    e.mean = s->sum[m] / n;
+    if (s->samples >= 2) {
+        double var = (s->sumsq[m] - n * e.mean * e.mean) / (n - 1);
+        e.half = t_quantile(s->samples - 1) * sqrt(var > 0 ? var / n : 0.0);
+    }
+    return e;
+}
+
+void sampling_print(const SamplingState *s, FILE *fp) {
+    fprintf(fp, "[Sampling] %llu windows of %llu records (warmup %llu) every %llu: %llu of %llu records detailed (%.2f%%)\n",
+            (unsigned long long)s->samples, (unsigned long long)s->window, (unsigned long long)s->warmup,
+            (unsigned long long)s->period, (unsigned long long)s->detailed, (unsigned long long)s->records,
+            100.0 * ratio(s->detailed, s->records));
+    for (int m = 0; m < SAMPLE_METRICS; m++) {
+        Estimate e = estimate(s, m);
+        fprintf(fp, "  %-16s %.6f", metric_names[m], e.mean);
+        if (e.half >= 0) fprintf(fp, " +/- %.6f (95%% CI)", e.half);
+        fprintf(fp, " -> %s ~ %.0f\n", total_names[m], e.mean * s->records);
+    }
+}
+
+int sampling_write_summary(const SamplingState *s, const char *filename) {
+    bool out = strcmp(filename, "stdout") == 0;
+    FILE *fp = out ? stdout : fopen(filename, "w");
+    if (!fp) {
+        perror("fopen sampling summary");
+        return -1;
+    }
+    size_t len = strlen(filename);
+    bool csv = len >= 4 && strcmp(filename + len - 4, ".csv") == 0;
+
+    if (csv) {
+        // 지표마다 한 줄
+        fprintf(fp, "metric,mean,ci95_low,ci95_high,total,samples,records,detailed\n");
+        for (int m = 0; m < SAMPLE_METRICS; m++) {
+            Estimate e = estimate(s, m);
+            double h = e.half >= 0 ? e.half : 0.0;
+            fprintf(fp, "%s,%.6f,%.6f,%.6f,%.0f,%llu,%llu,%llu\n", metric_names[m], e.mean,
+                    e.mean - h, e.mean + h, e.mean * s->records, (unsigned long long)s->samples,
+                    (unsigned long long)s->records, (unsigned long long)s->detailed);
+        }
+    } else {
+        fprintf(fp, "{\n");
+        fprintf(fp, "  \"period\": %llu,\n", (unsigned long long)s->period);
+        fprintf(fp, "  \"window\": %llu,\n", (unsigned long long)s->window);
+        fprintf(fp, "  \"warmup\": %llu,\n", (unsigned long long)s->warmup);
+        fprintf(fp, "  \"samples\": %llu,\n", (unsigned long long)s->samples);
+        fprintf(fp, "  \"records\": %llu,\n", (unsigned long long)s->records);
+        fprintf(fp, "  \"detailed\": %llu,\n", (unsigned long long)s->detailed);
+        fprintf(fp, "  \"estimates\": {\n");
+        for (int m = 0; m < SAMPLE_METRICS; m++) {
+            Estimate e = estimate(s, m);
+            fprintf(fp, "    \"%s\": { \"mean\": %.6f, ", metric_names[m], e.mean);
+            if (e.half >= 0) fprintf(fp, "\"ci95\": [%.6f, %.6f], ", e.mean - e.half, e.mean + e.half);
+            else fprintf(fp, "\"ci95\": null, ");
+            fprintf(fp, "\"%s\": %.0f }%s\n", total_names[m], e.mean * s->records,
+                    m + 1 < SAMPLE_METRICS ? "," : "");
+        }
+        fprintf(fp, "  }\n");
+        fprintf(fp, "}\n");
+    }
+
+    if (out) {
+        fflush(stdout);
+        return 0;
+    }
+    return fclose(fp) == 0 ? 0 : -1;
+}
@@ -0,0 +1,52 @@
+/* sampling.h */
+#ifndef SAMPLING_H
+#define SAMPLING_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stddef.h>
+#include "../common.h"
+#include "stats.h"
+
+// --- 표본 시뮬레이션 (SMARTS 식 systematic sampling) ---
+// 트레이스를 period 레코드씩 나누고, 각 period 는
+//   | 빨리 감기 (period - window) | 상세 워밍업 (warmup) | 상세 측정 (window - warmup) |
+// 빨리 감기는 sim_fast_forward (상주 페이지 / 교체 정책만), 나머지는 translate_batch_rw
+// 워밍업은 빨리 감기 동안 갱신되지 않은 TLB / PWC 를 다시 채우는 구간 (측정에서 제외)
+// 측정 구간마다 지표 하나씩을 표본으로 모아 평균과 95% 신뢰구간 (Student t) 을 내고,
+// 평균에 전체 레코드 수를 곱해 트레이스 전체 값으로 외삽
+typedef enum {
+    SAMPLE_TLB_MISS_RATE,
+    SAMPLE_PAGE_FAULT_RATE,
+    SAMPLE_SWAP_OUT_RATE,
+    SAMPLE_AMAT,            // cycle / 접근
+    SAMPLE_METRICS
+} SampleMetric;
+
+typedef struct {
+    uint64_t period;
+    uint64_t window;        // 상세 구간 (워밍업 포함)
+    uint64_t warmup;
+    uint64_t pos;           // 지금 period 안의 위치
+    Stats start;            // 이번 측정 구간 시작 시점의 카운터
+    uint64_t records;       // 처리한 전체 레코드 수
+    uint64_t detailed;      // 그중 상세 모드로 처리한 수
+    uint64_t samples;       // 끝까지 측정한 구간 수
+    double sum[SAMPLE_METRICS];
+    double sumsq[SAMPLE_METRICS];
+} SamplingState;
+
+// "period,window[,warmup]" (warmup 생략 시 window / 10). 성공 0, 형식 오류 -1
+int sampling_parse(SamplingState *s, const char *spec);
+
+// 같은 pid 의 주소 n 개를 단계에 맞게 빨리 감기 / 상세 모드로 나눠 처리
+// 반환값은 translate_batch_rw 와 같음 (n 보다 작으면 메모리 할당 실패)
+size_t sampling_run(SimContext *ctx, SamplingState *s, const uint64_t *va, const uint8_t *write, size_t n);
+
+// 추정치 요약 (사람이 읽는 형식)
+void sampling_print(const SamplingState *s, FILE *fp);
+
+// 추정치 파일 (.csv 확장자면 CSV, 아니면 JSON / "stdout" 가능). 성공 0, 실패 -1
+int sampling_write_summary(const SamplingState *s, const char *filename);
+
+#endif
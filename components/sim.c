@@ -0,0 +1,373 @@
+/* sim.c */
+#include "sim.h"
+#include "page_table.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static const char *policy_names[POLICY_COUNT] = { "RR", "LRU", "CLOCK", "CLOCK-PRO", "2Q", "ARC", "OPT" };
+
+const char* policy_name(Policy policy) {
+    return (policy >= 0 && policy < POLICY_COUNT) ? policy_names[policy] : "?";
+}
+
+int policy_parse(const char *str, Policy *policy) {
+    for (int i = 0; i < POLICY_COUNT; i++) {
+        if (strcmp(str, policy_names[i]) == 0) {
+            *policy = (Policy)i;
+            return 0;
+        }
+    }
+    return -1;
+}
+
+void sim_init(SimContext *ctx, const Geometry *geo, Policy policy) {
+    memset(ctx, 0, sizeof(*ctx));
+    ctx->geo = *geo;
+    ctx->policy = policy;
+
+    // init_memory 가 Swappable 비트를 설정하면서 swap 모듈에 알리므로 swap 먼저
+    init_swap(ctx);
+    init_memory(ctx);
+    init_page_tables(ctx);
+    init_tiers(ctx);
+    init_superpages(ctx);
+    init_prefetch(ctx);
+    init_cores(ctx);
+    init_tlb(ctx);
+    init_processes(ctx);
+}
+
+void sim_destroy(SimContext *ctx) {
+    destroy_processes(ctx);
+    destroy_tlb(ctx);
+    destroy_cores(ctx);
+    destroy_prefetch(ctx);
+    destroy_superpages(ctx);
+    destroy_tiers(ctx);
+    destroy_page_tables(ctx);
+    destroy_memory(ctx);
+    destroy_swap(ctx);
+}
+
+bool sim_uses_opt(const Geometry *geo, Policy policy) {
+    return policy == POLICY_OPT || geo->tlb_policy[0] == POLICY_OPT || geo->tlb_policy[1] == POLICY_OPT;
+}
+
+void sim_set_future(SimContext *ctx, const uint32_t *next_use, uint64_t len) {
+    ctx->next_use = next_use;
+    ctx->next_use_len = len;
+}
+
+SimContext* sim_create(const Geometry *geo, Policy policy) {
+    SimContext *ctx = malloc(sizeof(SimContext));
+    if (ctx) sim_init(ctx, geo, policy);
+    return ctx;
+}
+
+void sim_free(SimContext *ctx) {
+    if (!ctx) return;
+    close_log_file(&ctx->log);
+    sim_destroy(ctx);
+    free(ctx);
+}
+
+// Page Fault 처리: 데이터 프레임 할당 (모자라면 스왑 아웃), Swap-in, Page Table 갱신
+// 반환값: 새 프레임 (실패 -1), *huge_pfn 에 이번에 승격된 Superpage 블록 첫 프레임 (아니면 -1)
+static inline int fault_in(SimContext *ctx, uint64_t va, uint64_t key, int *huge_pfn) {
+    swap_note_fault(ctx, key);
+    // [pt_reclaim] 테이블이 수시로 해제 / 재할당되므로 경로의 테이블을 먼저 만들고 고정
+    // (데이터 프레임을 받은 뒤 테이블 할당의 스왑 아웃이 아직 매핑 전인 그 프레임을 Victim 으로 고르지 않도록)
+    if (ctx->pt.valid) {
+        int leaf = ctx->geo.levels - 1;
+        ctx->pt.pin[leaf] = pt_table_at(ctx, key, leaf, true);
+        if (ctx->pt.pin[leaf] == -1) {
+            fprintf(stderr, "Critical Error: Memory allocation failed even after swap.\n");
+            return -1;
+        }
+    }
+    // Superpage 를 쓰면 영역의 예약 블록 안 자리부터
+    bool sp = ctx->sp.pages != 0;
+    int new_pfn = sp ? sp_alloc_page(ctx, key) : allocate_free_frame(ctx, key, true); 
+    
+    if (new_pfn == -1) {
+        // Memory Full -> Swap Out 발생
+        swap_out(ctx); 
+        
+        // 다시 할당 시도
+        new_pfn = sp ? sp_alloc_page(ctx, key) : allocate_free_frame(ctx, key, true);
+        if (new_pfn == -1) {
+            fprintf(stderr, "Critical Error: Memory allocation failed even after swap.\n");
+            ctx->pt.pin[ctx->geo.levels - 1] = -1;
+            return -1;
+        }
+    }
+
+    // 스왑 장치에 사본이 있으면 읽어 옴 (없으면 0 페이지)
+    swap_in(ctx, key, new_pfn);
+
+    if (update_page_table(ctx, va, new_pfn) != 0) {
+        fprintf(stderr, "Critical Error: Memory allocation failed even after swap.\n");
+        return -1;
+    }
+    *huge_pfn = sp ? sp_try_promote(ctx, key) : -1;
+    return new_pfn;
+}
+
+// sim_access / translate_batch 공용 본체 (batch 루프 안에 인라인됨)
+static inline int access_one(SimContext *ctx, uint64_t va, bool write, uint64_t *pa) {
+    const Geometry *geo = &ctx->geo;
+    // 직전 접근이 남긴 prefetch (다른 프로세스의 키일 수 있으나 키의 pid 기준으로 매핑)
+    if (ctx->pf.pending) prefetch_issue(ctx);
+    if (ctx->tier.heat && ctx->time >= ctx->tier.next_epoch) tier_migrate(ctx);
+    va &= geo->va_mask;
+    uint64_t vpn = GET_FULL_VPN(geo, va);
+    uint64_t offset = GET_OFFSET(geo, va);
+    // [ASID] TLB / Reverse Mapping / 교체 정책은 (pid, vpn) 키로 구분
+    uint64_t key = ctx->proc.key_base | vpn;
+    ProcessStats *ps = &ctx->proc.stats[ctx->proc.current];
+    CoreStats *cs = &ctx->cores[ctx->core].stats;
+
+    // [LRU] 시간 증가 (메모리 접근 1회 = 시간 1 흐름)
+    ctx->time++;
+    ctx->tlb->clock++;
+    stats_on_access(&ctx->stats, &ctx->series);
+    ps->accesses++;
+    cs->accesses++;
+    bool first_lookup = true; // 재시도 조회는 통계에서 제외
+    bool faulted = false;
+
+    // State Machine Loop
+    while (1) {
+        // (1) Access VA 로그 출력
+        log_va_access(&ctx->log, va);
+
+        // (2) TLB Lookup
+        PROF_ENTER(PROF_TLB);
+        int pfn = search_tlb(ctx, key); 
+        PROF_EXIT(PROF_TLB);
+        if (first_lookup) {
+            if (pfn != -1) {
+                ctx->stats.tlb_hits++;
+                if (ctx->tlb->last_hit_huge) ctx->stats.tlb_huge_hits++;
+            } else {
+                ctx->stats.tlb_misses++;
+                ps->tlb_misses++;
+                cs->tlb_misses++;
+            }
+            for (int l = 0; l < ctx->tlb->levels; l++) {
+                ctx->stats.cycles_tlb += geo->lat_tlb[l];
+                if (l == ctx->tlb->last_hit_level) {
+                    ctx->stats.tlb_level_hits[l]++;
+                    break;
+                }
+                ctx->stats.tlb_level_misses[l]++;
+            }
+            first_lookup = false;
+        }
+
+        if (pfn != -1) {
+            // --- Case A: TLB Hit ---
+            // [LRU] 데이터 페이지 접근 시간 갱신 (CLOCK 계열은 참조 비트)
+            bool prefetched = acknowledge_frame_access(ctx, pfn);
+            ctx->stats.cycles_data += tier_latency(geo, pfn);
+            if (pfn >= geo->fast_frames) ctx->stats.tier_slow_accesses++;
+
+            // 쓰기: PTE Dirty 비트 (처음 한 번은 PTE 갱신 비용) + 프레임 내용 변경
+            // 내용은 접근 시각의 하위 바이트 (스왑 장치를 거쳐도 보존되는지 확인할 수 있는 값)
+            // 테이블 할당 중 이 페이지의 프레임이 테이블로 재사용된 경우(기존 동작)에는 내용을 쓰지 않음
+            if (write) {
+                ctx->stats.writes++;
+                if (mark_pte_dirty(ctx, va, pfn)) {
+                    ctx->stats.pages_dirtied++;
+                    if (geo->pte_dirty_mask) ctx->stats.cycles_walk += geo->lat_mem;
+                }
+                if (is_frame_swappable(ctx, pfn)) get_frame_ptr(ctx, pfn)[offset] = (uint8_t)ctx->time;
+            }
+
+            // (4) PA 계산 및 출력
+            *pa = ((uint64_t)pfn << geo->offset_bits) | offset;
+            log_pa_result(&ctx->log, *pa);
+
+            // Prefetch: Page Fault 와 prefetch 된 페이지의 첫 접근이 예측기의 Miss 흐름
+            if ((faulted || prefetched) && ctx->pf.unused) prefetch_note_miss(&ctx->pf, key);
+            
+            return 0; // 처리 완료
+        } 
+
+        // --- Case B: TLB Miss ---
+        
+        // (5) Page Table Lookup
+        PROF_ENTER(PROF_WALK);
+        PT_Result pt_res = walk_page_table(ctx, va); 
+        PROF_EXIT(PROF_WALK);
+
+        if (pt_res.hit) {
+            // --- Case B-1: Page Table Hit ---
+            PROF_ENTER(PROF_TLB);
+            if (pt_res.huge_pfn != -1) update_tlb_huge(ctx, key, pt_res.huge_pfn);
+            else update_tlb(ctx, key, pt_res.pfn);
+            PROF_EXIT(PROF_TLB);
+            
+            // [LRU] 루프를 돌아 TLB Hit가 될 때 acknowledge_frame_access가 호출됨
+            continue; // Retry
+        } 
+
+        // --- Case B-2: Page Table Miss (Page Fault) ---
+        
+        // (6) Allocate Free Frame (or Swap)
+        faulted = true;
+        ps->page_faults++;
+        cs->page_faults++;
+        ctx->stats.cycles_fault += geo->lat_fault;
+        int huge_pfn;
+        PROF_ENTER(PROF_FAULT);
+        int new_pfn = fault_in(ctx, va, key, &huge_pfn);
+        PROF_EXIT(PROF_FAULT);
+        if (new_pfn == -1) return -1;
+
+        // (7) Update TLB (Page Table 은 fault_in 에서)
+        PROF_ENTER(PROF_TLB);
+        if (huge_pfn != -1) update_tlb_huge(ctx, key, huge_pfn);
+        else update_tlb(ctx, key, new_pfn);
+        PROF_EXIT(PROF_TLB);
+        
+        continue; // Retry
+    }
+}
+
+// [Sampling] 기능 모드 접근: 상주 여부만 따라감 (TLB / PWC / 로그 / 단계별 Walk 비용 / 카운터 없음)
+// Page Table, 교체 정책, 프레임 내용, prefetch 는 상세 모드와 같이 갱신하므로 다음 상세 구간이 이어받음
+// TLB 는 건드리지 않지만 스왑 아웃의 shootdown 은 그대로라 남은 엔트리는 항상 유효
+// *last_key / *last_pfn: 직전 접근의 변환 (같은 페이지의 연속 접근은 Page Table 을 다시 읽지 않음,
+// 매핑이 바뀔 수 있는 Fault / prefetch 뒤에는 비움)
+static inline int access_functional(SimContext *ctx, uint64_t va, bool write, uint64_t *last_key, int *last_pfn) {
+    const Geometry *geo = &ctx->geo;
+    if (ctx->pf.pending) {
+        prefetch_issue(ctx);
+        *last_key = UINT64_MAX;
+    }
+    if (ctx->tier.heat && ctx->time >= ctx->tier.next_epoch) {
+        tier_migrate(ctx);
+        *last_key = UINT64_MAX;
+    }
+    va &= geo->va_mask;
+    uint64_t key = ctx->proc.key_base | GET_FULL_VPN(geo, va);
+    ctx->time++;
+
+    bool faulted = false;
+    int pfn = key == *last_key ? *last_pfn : pt_lookup(ctx, key);
+    if (pfn == -1) {
+        int huge_pfn;
+        faulted = true;
+        PROF_ENTER(PROF_FAULT);
+        pfn = fault_in(ctx, va, key, &huge_pfn);
+        PROF_EXIT(PROF_FAULT);
+        if (pfn == -1) return -1;
+        if (huge_pfn != -1) pfn = huge_pfn + (int)(key & ((1ULL << geo->sp_bits) - 1));
+    }
+    *last_key = faulted ? UINT64_MAX : key;
+    *last_pfn = pfn;
+
+    bool prefetched = acknowledge_frame_access(ctx, pfn);
+    if (write) {
+        mark_pte_dirty(ctx, va, pfn);
+        if (is_frame_swappable(ctx, pfn)) get_frame_ptr(ctx, pfn)[GET_OFFSET(geo, va)] = (uint8_t)ctx->time;
+    }
+    if ((faulted || prefetched) && ctx->pf.unused) prefetch_note_miss(&ctx->pf, key);
+    return 0;
+}
+
+int sim_access(SimContext *ctx, uint64_t va, uint64_t *pa) {
+    return access_one(ctx, va, false, pa);
+}
+
+int sim_access_rw(SimContext *ctx, uint64_t va, bool write, uint64_t *pa) {
+    return access_one(ctx, va, write, pa);
+}
+
+int sim_set_swap_file(SimContext *ctx, const char *path) {
+    return swapdev_open(&ctx->swap.device, path);
+}
+
+size_t translate_batch(SimContext *ctx, const uint64_t *va, uint64_t *pa, size_t n) {
+    return translate_batch_rw(ctx, va, NULL, pa, n);
+}
+
+size_t translate_batch_rw(SimContext *ctx, const uint64_t *va, const uint8_t *write, uint64_t *pa, size_t n) {
+    // 로그를 건너뛸 때는 레벨만 잠시 내림 (하위 모듈의 LOG_ENABLED 검사가 바로 빠져나감)
+    int saved_level = ctx->log.level;
+    if (!ctx->batch_log) ctx->log.level = LOG_LEVEL_NONE;
+
+    uint64_t scratch;
+    size_t i = 0;
+    for (; i < n; i++) {
+        PROF_ENTER(PROF_ACCESS);
+        int ret = access_one(ctx, va[i], write && write[i], pa ? &pa[i] : &scratch);
+        PROF_EXIT(PROF_ACCESS);
+        if (ret != 0) break;
+    }
+
+    ctx->log.level = saved_level;
+    return i;
+}
+
+size_t sim_fast_forward(SimContext *ctx, const uint64_t *va, const uint8_t *write, size_t n) {
+    int saved_level = ctx->log.level;
+    ctx->log.level = LOG_LEVEL_NONE;
+    // 스왑 아웃 / Swap-in 등 하위 모듈이 세는 카운터도 이 구간 것은 버림 (프로세스별 / 코어별 포함)
+    Stats saved = ctx->stats;
+    int num_procs = ctx->proc.count;
+    ProcessStats *saved_proc = malloc(sizeof(ProcessStats) * num_procs);
+    CoreStats *saved_core = malloc(sizeof(CoreStats) * ctx->num_cores);
+    if (!saved_proc || !saved_core) {
+        free(saved_proc);
+        free(saved_core);
+        ctx->log.level = saved_level;
+        return 0;
+    }
+    memcpy(saved_proc, ctx->proc.stats, sizeof(ProcessStats) * num_procs);
+    for (int c = 0; c < ctx->num_cores; c++) saved_core[c] = ctx->cores[c].stats;
+
+    uint64_t last_key = UINT64_MAX;
+    int last_pfn = -1;
+    size_t i = 0;
+    for (; i < n; i++) {
+        if (access_functional(ctx, va[i], write && write[i], &last_key, &last_pfn) != 0) break;
+    }
+
+    // 테이블 할당 / 해제 수는 구간의 사건이 아니라 지금 있는 테이블 수를 만드는 값이라 그대로 둠
+    // (버리면 live = 할당 - 해제 가 실제 테이블 수와 어긋나고 음수로 넘어감)
+    saved.table_frame_allocs = ctx->stats.table_frame_allocs;
+    saved.pt_tables_freed = ctx->stats.pt_tables_freed;
+    saved.pt_bytes_reclaimed = ctx->stats.pt_bytes_reclaimed;
+    saved.pt_tables_peak = ctx->stats.pt_tables_peak;
+    ctx->stats = saved;
+    // 빨리 감기는 문맥 교환을 하지 않으므로 pid 슬롯 수는 그대로
+    memcpy(ctx->proc.stats, saved_proc, sizeof(ProcessStats) * num_procs);
+    for (int c = 0; c < ctx->num_cores; c++) ctx->cores[c].stats = saved_core[c];
+    free(saved_proc);
+    free(saved_core);
+    ctx->log.level = saved_level;
+    return i;
+}
+
+int sim_run_trace(SimContext *ctx, const Trace *trace) {
+    uint64_t va[TRANSLATE_CHUNK];
+    uint8_t write[TRANSLATE_CHUNK];
+    uint64_t base = 0;
+    while (base < trace->count) {
+        // 묶음은 pid 가 같은 구간 안에서만
+        int pid = trace_get_pid(trace, base);
+        if (sim_switch_process(ctx, pid) != 0) return -1;
+        size_t n = 0;
+        do {
+            va[n] = trace_get(trace, base + n);
+            write[n] = trace_get_write(trace, base + n);
+            n++;
+        } while (n < TRANSLATE_CHUNK && base + n < trace->count && trace_get_pid(trace, base + n) == pid);
+        if (translate_batch_rw(ctx, va, trace->writes ? write : NULL, NULL, n) != n) return -1;
+        base += n;
+    }
+    return 0;
+}
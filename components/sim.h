@@ -0,0 +1,130 @@
+/* sim.h */
+#ifndef SIM_H
+#define SIM_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "../common.h"
+#include "geometry.h"
+#include "memory.h"
+#include "page_table.h"
+#include "swap.h"
+#include "tlb.h"
+#include "process.h"
+#include "multicore.h"
+#include "superpage.h"
+#include "prefetch.h"
+#include "tier.h"
+#include "log.h"
+#include "stats.h"
+#include "trace.h"
+#include "next_use.h"
+#include "checkpoint.h"
+#include "sampling.h"
+#include "profile.h"
+
+// --- MMU 시뮬레이터 라이브러리 (libmmusim) ---
+// 외부 프로그램은 이 헤더 하나만 포함해서 사용
+//   Geometry geo; geometry_parse(&geo, "x86-64,mem=1G");
+//   SimContext *ctx = sim_create(&geo, POLICY_LRU);
+//   translate_batch(ctx, va, pa, n);
+//   sim_free(ctx);
+
+// --- 시뮬레이터 인스턴스 ---
+// 기존의 전역 상태(g_policy, g_time, tlb[], physical_memory, swap.c/memory.c 의 static 배열)를
+// 모두 담고 있어 한 프로세스 안에서 여러 인스턴스를 독립적으로(스레드별로) 실행할 수 있음
+struct SimContext {
+    Geometry geo;
+    Policy policy;
+    uint64_t time;        // LRU용 시뮬레이션 시간 (메모리 액세스 횟수)
+
+    MemoryState mem;
+    PageTableState pt;    // [pt_reclaim] 테이블별 유효 엔트리 수 (geo.pt_reclaim 이 0 이면 비어 있음)
+    SwapState swap;
+    SuperpageState sp;    // 예약 블록 / 승격 상태 (geo.superpage 가 0 이면 비어 있음)
+    PrefetchState pf;     // 예측기 상태 (geo.prefetch 가 none 이면 비어 있음)
+    TierState tier;       // 프레임별 heat (geo.slow_mem_size 가 0 이면 비어 있음)
+    Core *cores;          // 코어별 TLB / 실행 중 pid / 카운터 (geo.cores 개, 기본 1)
+    int num_cores;
+    int core;             // sim_access 가 실행되는 코어 (sim_select_core)
+    TLBState *tlb;        // = &cores[core].tlb
+    ProcessTable proc;    // pid 별 Root / 카운터 (기본은 pid 0 하나)
+
+    Logger log;           // 기본값 LOG_LEVEL_NONE (open_log_file_ex 로 열기)
+    Stats stats;
+    StatsSeries series;   // -w / -t 시계열 (기본 비활성)
+
+    bool batch_log;       // translate_batch 에서도 로그를 남길지 (기본 false)
+
+    // [OPT] 접근 i 의 다음 사용 인덱스 (sim_set_future, 호출자 소유)
+    const uint32_t *next_use;
+    uint64_t next_use_len;
+};
+
+// [OPT] 지금 처리 중인 접근(ctx->time 번째)의 VPN 이 다음에 쓰이는 시점
+// 인덱스 범위를 벗어나면 다시 쓰이지 않는 것으로 취급
+static inline uint64_t sim_next_use(const SimContext *ctx) {
+    uint64_t i = ctx->time - 1;
+    return (ctx->next_use && i < ctx->next_use_len) ? ctx->next_use[i] : NEXT_USE_NEVER;
+}
+
+// geo 는 geometry_finalize 가 끝난 값이어야 함
+void sim_init(SimContext *ctx, const Geometry *geo, Policy policy);
+void sim_destroy(SimContext *ctx);
+
+// 프레임 또는 TLB 중 하나라도 OPT 를 쓰면 true (next-use 인덱스 필요)
+bool sim_uses_opt(const Geometry *geo, Policy policy);
+
+// [OPT] 앞으로 변환할 주소열의 next-use 인덱스 연결 (build_next_use 결과)
+// 이후 sim_access / translate_batch 로 넘기는 주소가 인덱스를 만든 트레이스와 같은 순서여야 함
+void sim_set_future(SimContext *ctx, const uint32_t *next_use, uint64_t len);
+
+// 힙에 할당하는 버전 (구조체 크기에 의존하지 않아도 되는 임베딩용). 실패 시 NULL
+SimContext* sim_create(const Geometry *geo, Policy policy);
+void sim_free(SimContext *ctx);
+
+// translate_batch 의 로그 출력 여부 (열린 로그가 있을 때만 의미 있음)
+static inline void sim_set_batch_logging(SimContext *ctx, bool enable) {
+    ctx->batch_log = enable;
+}
+
+// 선택된 코어의 문맥 교환: 이후 sim_access / translate_batch 의 주소는 pid 의 주소 공간
+// 성공 0, 실패 (pid 가 ASID 범위 밖 등) -1
+static inline int sim_switch_process(SimContext *ctx, int pid) {
+    return process_switch(ctx, pid);
+}
+
+// 주소 하나 변환 (TLB -> Page Walk -> Page Fault 처리 State Machine)
+// 성공 0 (*pa 에 물리 주소), 메모리 할당 실패 시 -1
+int sim_access(SimContext *ctx, uint64_t va, uint64_t *pa);
+
+// 읽기 / 쓰기를 구분하는 버전 (sim_access 는 읽기). 쓰기는 PTE Dirty 비트를 설정하고 프레임 내용을 바꿈
+int sim_access_rw(SimContext *ctx, uint64_t va, bool write, uint64_t *pa);
+
+// 스왑 장치로 쓸 파일 (새로 만들거나 비움). 지정하지 않으면 첫 write-back 때 익명 임시 파일
+// 성공 0, 실패 -1
+int sim_set_swap_file(SimContext *ctx, const char *path);
+
+// 주소 n 개를 순서대로 변환 (호출당 오버헤드를 n 개에 나눔)
+// pa 가 NULL 이면 결과는 버리고 상태/통계만 갱신
+// batch_log 가 false 면 이 호출 동안 로그를 건너뜀
+// 반환값: 변환에 성공한 주소 수 (n 보다 작으면 va[반환값] 에서 메모리 할당 실패)
+size_t translate_batch(SimContext *ctx, const uint64_t *va, uint64_t *pa, size_t n);
+
+// write[i] != 0 이면 va[i] 는 쓰기 (write 가 NULL 이면 translate_batch 와 같음)
+size_t translate_batch_rw(SimContext *ctx, const uint64_t *va, const uint8_t *write, uint64_t *pa, size_t n);
+
+// [Sampling] 주소 n 개를 기능 모드로 처리 (빨리 감기): 상주 페이지 / Page Table / 교체 정책 / 스왑 장치만 갱신
+// TLB 조회 / 갱신, PWC, 로그, 지연 시간, 카운터 (ctx->stats, 프로세스별, 코어별) 는 건너뜀 (시간 ctx->time 은 흐름)
+// 단 테이블 할당 / 해제 / peak 는 구조 상태라 그대로 반영
+// 반환값은 translate_batch_rw 와 같음
+size_t sim_fast_forward(SimContext *ctx, const uint64_t *va, const uint8_t *write, size_t n);
+
+// 트레이스를 translate_batch 에 넘길 때의 묶음 크기
+#define TRANSLATE_CHUNK 4096
+
+// 메모리에 올린 트레이스 전체 실행 (trace_load 이후, pid 가 바뀌는 곳에서 문맥 교환). 성공 0, 실패 -1
+int sim_run_trace(SimContext *ctx, const Trace *trace);
+
+#endif
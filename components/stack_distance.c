@@ -0,0 +1,224 @@
+/* stack_distance.c */
+#include "stack_distance.h"
+#include "../common.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define SD_MIN_TREE (1 << 16)
+
+static void *xcalloc(uint64_t n, size_t sz) {
+    void *p = calloc(n, sz);
+    if (!p) {
+        perror("malloc stack distance");
+        exit(1);
+    }
+    return p;
+}
+
+static inline void fen_add(StackDist *sd, uint64_t i, int delta) {
+    for (; i <= sd->tree_size; i += i & (~i + 1)) sd->tree[i] += delta;
+}
+
+static inline uint64_t fen_sum(const StackDist *sd, uint64_t i) {
+    uint64_t s = 0;
+    for (; i > 0; i -= i & (~i + 1)) s += sd->tree[i];
+    return s;
+}
+
+void sd_init(StackDist *sd) {
+    memset(sd, 0, sizeof(*sd));
+    vmap_init(&sd->last, 1024);
+    sd->tree_size = SD_MIN_TREE;
+    sd->tree = xcalloc(sd->tree_size + 1, sizeof(uint32_t));
+    sd->hist_cap = 1024;
+    sd->hist = xcalloc(sd->hist_cap, sizeof(uint64_t));
+}
+
+void sd_destroy(StackDist *sd) {
+    vmap_destroy(&sd->last);
+    free(sd->tree);
+    free(sd->hist);
+    memset(sd, 0, sizeof(*sd));
+}
+
+typedef struct {
+    uint64_t time;
+    uint64_t key;
+} TimeKey;
+
+static int cmp_time(const void *a, const void *b) {
+    uint64_t x = ((const TimeKey *)a)->time, y = ((const TimeKey *)b)->time;
+    return (x > y) - (x < y);
+}
+
+// 시각이 tree 끝에 닿으면 살아있는 마커(= 서로 다른 VPN 수)만 1..d 로 재번호
+// tree 크기는 트레이스 길이가 아니라 서로 다른 VPN 수에 비례하게 유지됨
+static void compact(StackDist *sd) {
+    uint64_t d = sd->last.size;
+    TimeKey *tk = malloc(sizeof(TimeKey) * (d ? d : 1));
+    if (!tk) {
+        perror("malloc stack distance");
+        exit(1);
+    }
+
+    uint64_t n = 0;
+    for (uint64_t i = 0; i < sd->last.capacity; i++) {
+        if (sd->last.used[i]) {
+            tk[n].time = sd->last.values[i];
+            tk[n].key = sd->last.keys[i];
+            n++;
+        }
+    }
+    qsort(tk, n, sizeof(TimeKey), cmp_time);
+
+    uint64_t new_size = d * 2 > SD_MIN_TREE ? d * 2 : SD_MIN_TREE;
+    free(sd->tree);
+    sd->tree_size = new_size;
+    sd->tree = xcalloc(new_size + 1, sizeof(uint32_t));
+
+    for (uint64_t i = 0; i < n; i++) {
+        vmap_put(&sd->last, tk[i].key, i + 1);
+        sd->tree[i + 1] = 1;
+    }
+    // O(n) Fenwick 구성
+    for (uint64_t i = 1; i <= new_size; i++) {
+        uint64_t parent = i + (i & (~i + 1));
+        if (parent <= new_size) sd->tree[parent] += sd->tree[i];
+    }
+    sd->now = n;
+    free(tk);
+}
+
+uint64_t sd_access(StackDist *sd, uint64_t key) {
+    if (sd->now == sd->tree_size) compact(sd);
+    sd->accesses++;
+
+    uint64_t prev, dist = SD_COLD;
+    if (vmap_get(&sd->last, key, &prev)) {
+        // prev 이후에 마지막 접근이 있었던 VPN 수 + 자기 자신
+        dist = fen_sum(sd, sd->now) - fen_sum(sd, prev) + 1;
+        fen_add(sd, prev, -1);
+
+        if (dist >= sd->hist_cap) {
+            uint64_t cap = sd->hist_cap;
+            while (cap <= dist) cap *= 2;
+            sd->hist = realloc(sd->hist, sizeof(uint64_t) * cap);
+            if (!sd->hist) {
+                perror("malloc stack distance");
+                exit(1);
+            }
+            memset(sd->hist + sd->hist_cap, 0, sizeof(uint64_t) * (cap - sd->hist_cap));
+            sd->hist_cap = cap;
+        }
+        sd->hist[dist]++;
+        if (dist > sd->max_dist) sd->max_dist = dist;
+    } else {
+        sd->cold++;
+    }
+
+    sd->now++;
+    fen_add(sd, sd->now, 1);
+    vmap_put(&sd->last, key, sd->now);
+    return dist;
+}
+
+uint64_t sd_misses(const StackDist *sd, uint64_t size) {
+    uint64_t misses = sd->cold;
+    for (uint64_t d = size + 1; d <= sd->max_dist; d++) misses += sd->hist[d];
+    return misses;
+}
+
+int run_stack_distance(const Geometry *geo, Trace *trace, const char *csv_path) {
+    StackDist sd;
+    sd_init(&sd);
+
+    // 페이지 테이블 프레임 수 추정: 단계별로 서로 다른 상위 prefix 수
+    // (테이블 프레임은 스왑되지 않으므로 데이터 프레임 수 = 전체 - 예약 - 테이블)
+    VpnMap tables[MAX_LEVELS];
+    for (int l = 1; l < geo->levels; l++) vmap_init(&tables[l], 1024);
+
+    struct timespec t_start, t_end;
+    clock_gettime(CLOCK_MONOTONIC, &t_start);
+
+    // 다중 프로세스 트레이스: 페이지 / 테이블 모두 (pid, ...) 키로 구분 (ASID 태그 TLB 기준)
+    VpnMap pids;
+    vmap_init(&pids, 16);
+    uint64_t va;
+    while (trace_next(trace, &va)) {
+        va &= geo->va_mask;
+        sd_access(&sd, PAGE_KEY(geo, trace->pid, GET_FULL_VPN(geo, va)));
+        for (int l = 1; l < geo->levels; l++) {
+            vmap_put(&tables[l], PAGE_KEY(geo, trace->pid, va >> geo->level_shift[l - 1]), 0);
+        }
+        if (trace->pid) vmap_put(&pids, trace->pid, 0);
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &t_end);
+    double elapsed = (t_end.tv_sec - t_start.tv_sec) + (t_end.tv_nsec - t_start.tv_nsec) / 1e9;
+
+    uint64_t table_frames = 0;
+    for (int l = 1; l < geo->levels; l++) {
+        table_frames += tables[l].size;
+        vmap_destroy(&tables[l]);
+    }
+    // pid 0 이외 프로세스의 Root 도 테이블 프레임
+    table_frames += pids.size;
+    vmap_destroy(&pids);
+    uint64_t reserved = (uint64_t)geo->root_pfn + 1;
+    uint64_t overhead = reserved + table_frames;
+
+    FILE *fp = strcmp(csv_path, "stdout") == 0 ? stdout : fopen(csv_path, "w");
+    if (!fp) {
+        perror("fopen stack distance csv");
+        sd_destroy(&sd);
+        return -1;
+    }
+
+    // size 는 TLB 엔트리 수이자 전체 프레임 수
+    // page_faults 는 (size - 예약 프레임 - 테이블 프레임) 개의 데이터 프레임을 가진 LRU 기준
+    // 실제 시뮬레이션에서는 테이블 프레임이 점진적으로 늘어나므로 page fault 의 상한값에 해당
+    fprintf(fp, "size,tlb_misses,tlb_miss_rate,page_faults,page_fault_rate\n");
+
+    // suffix 합으로 한 번에 계산 (misses(size) = cold + sum_{d > size} hist[d])
+    uint64_t max_size = sd.max_dist + overhead + 1;
+    uint64_t *misses = malloc(sizeof(uint64_t) * (sd.max_dist + 2));
+    if (!misses) {
+        perror("malloc stack distance");
+        exit(1);
+    }
+    misses[sd.max_dist + 1] = sd.cold;
+    for (uint64_t d = sd.max_dist + 1; d > 0; d--) {
+        misses[d - 1] = misses[d] + (d <= sd.max_dist ? sd.hist[d] : 0);
+    }
+    #define MISSES_AT(sz) ((sz) > sd.max_dist ? sd.cold : misses[(sz)])
+
+    double n = sd.accesses ? (double)sd.accesses : 1.0;
+    for (uint64_t size = 1; size <= max_size; size++) {
+        uint64_t tlb = MISSES_AT(size);
+        fprintf(fp, "%llu,%llu,%.6f,", (unsigned long long)size,
+                (unsigned long long)tlb, tlb / n);
+        if (size > overhead) {
+            uint64_t pf = MISSES_AT(size - overhead);
+            fprintf(fp, "%llu,%.6f\n", (unsigned long long)pf, pf / n);
+        } else {
+            fprintf(fp, ",\n"); // 데이터 프레임이 없는 크기
+        }
+    }
+    #undef MISSES_AT
+
+    if (fp != stdout) fclose(fp);
+    free(misses);
+
+    fprintf(stderr, "[StackDist] %llu accesses, %llu distinct pages, %llu table frames, "
+                    "%llu reserved frames\n",
+            (unsigned long long)sd.accesses, (unsigned long long)sd.cold,
+            (unsigned long long)table_frames, (unsigned long long)reserved);
+    fprintf(stderr, "[Trace] %s: %llu records in %.3f s (%.0f records/s)\n",
+            trace_format_name(trace), (unsigned long long)trace->pos, elapsed,
+            elapsed > 0 ? trace->pos / elapsed : 0.0);
+
+    sd_destroy(&sd);
+    return 0;
+}
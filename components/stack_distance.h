@@ -0,0 +1,43 @@
+/* stack_distance.h */
+#ifndef STACK_DISTANCE_H
+#define STACK_DISTANCE_H
+
+#include <stdint.h>
+#include "vpn_map.h"
+#include "trace.h"
+#include "../common.h"
+
+// --- Mattson Stack Distance (LRU) ---
+// 트레이스 한 번만 훑어서 모든 크기의 LRU 캐시(TLB 엔트리 수, 프레임 수)에 대한 miss 수를 구함
+// Fenwick tree 위에 "각 VPN 의 마지막 접근 시각" 마커를 두고,
+// 재접근 시 그 사이의 마커 수(= 그 사이에 접근된 서로 다른 VPN 수)로 거리를 계산 -> 접근당 O(log n)
+typedef struct {
+    VpnMap last;          // VPN -> 마지막 접근 시각
+    uint32_t *tree;       // Fenwick tree (1-based)
+    uint64_t tree_size;
+    uint64_t now;         // 마지막으로 부여한 시각
+    uint64_t *hist;       // hist[d]: 스택 거리 d 인 재접근 횟수 (d >= 1)
+    uint64_t hist_cap;
+    uint64_t max_dist;
+    uint64_t cold;        // 첫 접근 (어떤 크기에서도 miss)
+    uint64_t accesses;
+} StackDist;
+
+#define SD_COLD UINT64_MAX
+
+void sd_init(StackDist *sd);
+void sd_destroy(StackDist *sd);
+
+// key 접근 처리, 스택 거리 반환 (첫 접근이면 SD_COLD)
+uint64_t sd_access(StackDist *sd, uint64_t key);
+
+// 크기 size 인 LRU 캐시의 miss 수
+uint64_t sd_misses(const StackDist *sd, uint64_t size);
+
+// -D 모드: 트레이스 전체를 한 번 훑고 크기별 TLB miss / page fault 곡선을 CSV 로 출력
+// (geo 의 주소 분해 사용) 성공 0, 실패 -1
+// TLB miss 는 TLB 를 독립된 LRU 캐시로 본 값: 스왑 아웃의 shootdown 으로 지워지는 엔트리는 반영하지 않으므로
+// 페이지 교체가 없을 때 (프레임이 footprint 를 모두 담을 때) 만 -p LRU 의 결과와 정확히 같고, 교체가 있으면 더 적게 나옴
+int run_stack_distance(const Geometry *geo, Trace *trace, const char *csv_path);
+
+#endif
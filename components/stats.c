@@ -0,0 +1,269 @@
+/* stats.c */
+#include "stats.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static FILE* open_out(const char *filename) {
+    if (strcmp(filename, "stdout") == 0) return stdout;
+    FILE *fp = fopen(filename, "w");
+    if (!fp) {
+        perror("fopen stats");
+        exit(1);
+    }
+    return fp;
+}
+
+static void close_out(FILE *fp) {
+    if (fp == stdout) {
+        fflush(stdout);
+        return;
+    }
+    if (ferror(fp)) {
+        fprintf(stderr, "File write error occurred before fclose\n");
+    }
+    fclose(fp);
+}
+
+static double ratio(uint64_t num, uint64_t den) {
+    return den ? (double)num / den : 0.0;
+}
+
+void stats_open_timeseries(StatsSeries *ts, const char *filename, uint64_t window) {
+    memset(ts, 0, sizeof(*ts));
+    ts->window = window;
+    ts->left = window ? window + 1 : 0;
+    if (window == 0) return;
+
+    ts->fp = open_out(filename);
+    fprintf(ts->fp, "accesses,window_tlb_misses,window_pt_misses,window_swap_outs,"
+                   "window_tlb_miss_rate,window_page_fault_rate,"
+                   "cumulative_tlb_miss_rate,cumulative_page_fault_rate\n");
+}
+
+void stats_write_window(StatsSeries *ts, const Stats *st) {
+    ts->left = ts->window;
+    if (!ts->fp) return;
+
+    uint64_t n = st->accesses - ts->prev.accesses;
+    uint64_t tlb_misses = st->tlb_misses - ts->prev.tlb_misses;
+    uint64_t pt_misses = st->pt_misses - ts->prev.pt_misses;
+    uint64_t swap_outs = st->swap_outs - ts->prev.swap_outs;
+
+    fprintf(ts->fp, "%llu,%llu,%llu,%llu,%.6f,%.6f,%.6f,%.6f\n",
+            (unsigned long long)st->accesses,
+            (unsigned long long)tlb_misses, (unsigned long long)pt_misses,
+            (unsigned long long)swap_outs,
+            ratio(tlb_misses, n), ratio(pt_misses, n),
+            ratio(st->tlb_misses, st->accesses),
+            ratio(st->pt_misses, st->accesses));
+    ts->prev = *st;
+}
+
+void stats_close_timeseries(StatsSeries *ts, const Stats *st) {
+    if (!ts->fp) return;
+
+    // 마지막 window 가 덜 찼으면 남은 구간도 기록
+    if (st->accesses != ts->prev.accesses) {
+        stats_write_window(ts, st);
+    }
+    close_out(ts->fp);
+    ts->fp = NULL;
+    ts->left = 0;
+}
+
+void stats_write_summary(const Stats *st, const ProcessStats *proc, int num_procs,
+                         const CoreStats *core, int num_cores,
+                         Policy policy, const char *filename) {
+    FILE *fp = open_out(filename);
+    size_t len = strlen(filename);
+    bool csv = len >= 4 && strcmp(filename + len - 4, ".csv") == 0;
+
+    uint64_t frame_ev = st->frame_evictions[policy];
+    uint64_t tlb_ev = st->tlb_evictions[policy];
+    uint64_t cycles = stats_total_cycles(st);
+    // prefetch 가 없었다면 Fault 였을 접근 중 prefetch 가 막은 비율
+    double pf_coverage = ratio(st->prefetch_useful, st->prefetch_useful + st->pt_misses);
+    // [Tier] 데이터 접근 1회의 평균 지연 (계층별 지연 + 승격 / 강등의 복사 비용을 나눠 가짐)
+    double eat = ratio(st->cycles_data + st->cycles_migrate, st->accesses);
+
+    if (csv) {
+        // 한 줄짜리 CSV (여러 실행 결과를 이어붙이기 쉽게)
+        fprintf(fp, "policy,accesses,tlb_hits,tlb_misses,pt_hits,pt_misses,swap_outs,"
+                    "table_frame_allocs,frame_evictions,tlb_evictions,"
+                    "tlb_miss_rate,page_fault_rate,l1_tlb_hits,l1_tlb_misses,l2_tlb_hits,l2_tlb_misses,"
+                    "context_switches,tlb_flushes,tlb_flush_entries,"
+                    "shootdowns,shootdown_ipis,remote_invalidations,deferred_flushes,deferred_flush_entries,"
+                    "pwc_hits,pwc_misses,walk_mem_refs,cycles,amat,"
+                    "writes,pages_dirtied,writebacks,writeback_bytes,clean_evictions,writeback_avoided_bytes,"
+                    "swap_ins,swap_in_bytes,zero_fills,"
+                    "tlb_huge_hits,sp_reservations,sp_reservations_broken,sp_promotions,sp_demotions,"
+                    "sp_pages_migrated,sp_pages_filled,"
+                    "prefetch_issued,prefetch_reads,prefetch_useful,prefetch_wasted,prefetch_wasted_bytes,"
+                    "prefetch_accuracy,prefetch_coverage,"
+                    "pt_tables_freed,pt_bytes_reclaimed,pt_tables_peak,"
+                    "tier_slow_accesses,tier_promotions,tier_demotions,cycles_migrate,effective_access_time\n");
+        fprintf(fp, "%s,%llu,%llu,%llu,%llu,%llu,%llu,%llu,%llu,%llu,%.6f,%.6f,%llu,%llu,%llu,%llu,"
+                    "%llu,%llu,%llu,%llu,%llu,%llu,%llu,%llu,%llu,%llu,%llu,%llu,%.3f,"
+                    "%llu,%llu,%llu,%llu,%llu,%llu,%llu,%llu,%llu,"
+                    "%llu,%llu,%llu,%llu,%llu,%llu,%llu,"
+                    "%llu,%llu,%llu,%llu,%llu,%.6f,%.6f,"
+                    "%llu,%llu,%llu,"
+                    "%llu,%llu,%llu,%llu,%.3f\n",
+                policy_name(policy),
+                (unsigned long long)st->accesses,
+                (unsigned long long)st->tlb_hits, (unsigned long long)st->tlb_misses,
+                (unsigned long long)st->pt_hits, (unsigned long long)st->pt_misses,
+                (unsigned long long)st->swap_outs,
+                (unsigned long long)st->table_frame_allocs,
+                (unsigned long long)frame_ev, (unsigned long long)tlb_ev,
+                ratio(st->tlb_misses, st->accesses),
+                ratio(st->pt_misses, st->accesses),
+                (unsigned long long)st->tlb_level_hits[0], (unsigned long long)st->tlb_level_misses[0],
+                (unsigned long long)st->tlb_level_hits[1], (unsigned long long)st->tlb_level_misses[1],
+                (unsigned long long)st->context_switches, (unsigned long long)st->tlb_flushes,
+                (unsigned long long)st->tlb_flush_entries,
+                (unsigned long long)st->shootdowns, (unsigned long long)st->shootdown_ipis,
+                (unsigned long long)st->remote_invalidations,
+                (unsigned long long)st->deferred_flushes, (unsigned long long)st->deferred_flush_entries,
+                (unsigned long long)st->pwc_hits, (unsigned long long)st->pwc_misses,
+                (unsigned long long)st->walk_mem_refs, (unsigned long long)cycles,
+                ratio(cycles, st->accesses),
+                (unsigned long long)st->writes, (unsigned long long)st->pages_dirtied,
+                (unsigned long long)st->writebacks, (unsigned long long)st->writeback_bytes,
+                (unsigned long long)st->clean_evictions, (unsigned long long)st->writeback_avoided_bytes,
+                (unsigned long long)st->swap_ins, (unsigned long long)st->swap_in_bytes,
+                (unsigned long long)st->zero_fills,
+                (unsigned long long)st->tlb_huge_hits,
+                (unsigned long long)st->sp_reservations, (unsigned long long)st->sp_reservations_broken,
+                (unsigned long long)st->sp_promotions, (unsigned long long)st->sp_demotions,
+                (unsigned long long)st->sp_pages_migrated, (unsigned long long)st->sp_pages_filled,
+                (unsigned long long)st->prefetch_issued, (unsigned long long)st->prefetch_reads,
+                (unsigned long long)st->prefetch_useful, (unsigned long long)st->prefetch_wasted,
+                (unsigned long long)st->prefetch_wasted_bytes,
+                ratio(st->prefetch_useful, st->prefetch_issued), pf_coverage,
+                (unsigned long long)st->pt_tables_freed, (unsigned long long)st->pt_bytes_reclaimed,
+                (unsigned long long)st->pt_tables_peak,
+                (unsigned long long)st->tier_slow_accesses, (unsigned long long)st->tier_promotions,
+                (unsigned long long)st->tier_demotions, (unsigned long long)st->cycles_migrate, eat);
+    } else {
+        fprintf(fp, "{\n");
+        fprintf(fp, "  \"policy\": \"%s\",\n", policy_name(policy));
+        fprintf(fp, "  \"accesses\": %llu,\n", (unsigned long long)st->accesses);
+        fprintf(fp, "  \"tlb_hits\": %llu,\n", (unsigned long long)st->tlb_hits);
+        fprintf(fp, "  \"tlb_misses\": %llu,\n", (unsigned long long)st->tlb_misses);
+        for (int l = 0; l < TLB_LEVELS; l++) {
+            fprintf(fp, "  \"l%d_tlb_hits\": %llu,\n", l + 1, (unsigned long long)st->tlb_level_hits[l]);
+            fprintf(fp, "  \"l%d_tlb_misses\": %llu,\n", l + 1, (unsigned long long)st->tlb_level_misses[l]);
+        }
+        fprintf(fp, "  \"pt_hits\": %llu,\n", (unsigned long long)st->pt_hits);
+        fprintf(fp, "  \"pt_misses\": %llu,\n", (unsigned long long)st->pt_misses);
+        fprintf(fp, "  \"swap_outs\": %llu,\n", (unsigned long long)st->swap_outs);
+        fprintf(fp, "  \"writes\": %llu,\n", (unsigned long long)st->writes);
+        fprintf(fp, "  \"pages_dirtied\": %llu,\n", (unsigned long long)st->pages_dirtied);
+        fprintf(fp, "  \"writebacks\": %llu,\n", (unsigned long long)st->writebacks);
+        fprintf(fp, "  \"writeback_bytes\": %llu,\n", (unsigned long long)st->writeback_bytes);
+        fprintf(fp, "  \"clean_evictions\": %llu,\n", (unsigned long long)st->clean_evictions);
+        fprintf(fp, "  \"writeback_avoided_bytes\": %llu,\n", (unsigned long long)st->writeback_avoided_bytes);
+        fprintf(fp, "  \"swap_ins\": %llu,\n", (unsigned long long)st->swap_ins);
+        fprintf(fp, "  \"swap_in_bytes\": %llu,\n", (unsigned long long)st->swap_in_bytes);
+        fprintf(fp, "  \"zero_fills\": %llu,\n", (unsigned long long)st->zero_fills);
+        fprintf(fp, "  \"table_frame_allocs\": %llu,\n", (unsigned long long)st->table_frame_allocs);
+
+        fprintf(fp, "  \"frame_evictions\": {");
+        for (int i = 0; i < POLICY_COUNT; i++) {
+            fprintf(fp, "%s\"%s\": %llu", i ? ", " : "", policy_name((Policy)i),
+                    (unsigned long long)st->frame_evictions[i]);
+        }
+        fprintf(fp, "},\n");
+        fprintf(fp, "  \"tlb_evictions\": {");
+        for (int i = 0; i < POLICY_COUNT; i++) {
+            fprintf(fp, "%s\"%s\": %llu", i ? ", " : "", policy_name((Policy)i),
+                    (unsigned long long)st->tlb_evictions[i]);
+        }
+        fprintf(fp, "},\n");
+
+        fprintf(fp, "  \"context_switches\": %llu,\n", (unsigned long long)st->context_switches);
+        fprintf(fp, "  \"tlb_flushes\": %llu,\n", (unsigned long long)st->tlb_flushes);
+        fprintf(fp, "  \"tlb_flush_entries\": %llu,\n", (unsigned long long)st->tlb_flush_entries);
+        fprintf(fp, "  \"shootdowns\": %llu,\n", (unsigned long long)st->shootdowns);
+        fprintf(fp, "  \"shootdown_ipis\": %llu,\n", (unsigned long long)st->shootdown_ipis);
+        fprintf(fp, "  \"remote_invalidations\": %llu,\n", (unsigned long long)st->remote_invalidations);
+        fprintf(fp, "  \"deferred_flushes\": %llu,\n", (unsigned long long)st->deferred_flushes);
+        fprintf(fp, "  \"deferred_flush_entries\": %llu,\n", (unsigned long long)st->deferred_flush_entries);
+        fprintf(fp, "  \"pwc_hits\": %llu,\n", (unsigned long long)st->pwc_hits);
+        fprintf(fp, "  \"pwc_misses\": %llu,\n", (unsigned long long)st->pwc_misses);
+        fprintf(fp, "  \"walk_mem_refs\": %llu,\n", (unsigned long long)st->walk_mem_refs);
+        fprintf(fp, "  \"walk_levels_skipped\": %llu,\n", (unsigned long long)st->walk_levels_skipped);
+        fprintf(fp, "  \"tlb_huge_hits\": %llu,\n", (unsigned long long)st->tlb_huge_hits);
+        fprintf(fp, "  \"superpages\": {\"reservations\": %llu, \"reservations_broken\": %llu, "
+                    "\"promotions\": %llu, \"demotions\": %llu, \"pages_migrated\": %llu, "
+                    "\"pages_filled\": %llu},\n",
+                (unsigned long long)st->sp_reservations, (unsigned long long)st->sp_reservations_broken,
+                (unsigned long long)st->sp_promotions, (unsigned long long)st->sp_demotions,
+                (unsigned long long)st->sp_pages_migrated, (unsigned long long)st->sp_pages_filled);
+        fprintf(fp, "  \"prefetch\": {\"issued\": %llu, \"swap_reads\": %llu, \"useful\": %llu, "
+                    "\"wasted\": %llu, \"wasted_bytes\": %llu, \"accuracy\": %.6f, \"coverage\": %.6f},\n",
+                (unsigned long long)st->prefetch_issued, (unsigned long long)st->prefetch_reads,
+                (unsigned long long)st->prefetch_useful, (unsigned long long)st->prefetch_wasted,
+                (unsigned long long)st->prefetch_wasted_bytes,
+                ratio(st->prefetch_useful, st->prefetch_issued), pf_coverage);
+        fprintf(fp, "  \"page_tables\": {\"allocated\": %llu, \"freed\": %llu, \"live\": %llu, "
+                    "\"peak\": %llu, \"bytes_reclaimed\": %llu},\n",
+                (unsigned long long)st->table_frame_allocs, (unsigned long long)st->pt_tables_freed,
+                (unsigned long long)(st->table_frame_allocs - st->pt_tables_freed),
+                (unsigned long long)st->pt_tables_peak, (unsigned long long)st->pt_bytes_reclaimed);
+        fprintf(fp, "  \"tiers\": {\"fast_accesses\": %llu, \"slow_accesses\": %llu, \"promotions\": %llu, "
+                    "\"demotions\": %llu, \"effective_access_time\": %.3f},\n",
+                (unsigned long long)(st->accesses - st->tier_slow_accesses),
+                (unsigned long long)st->tier_slow_accesses,
+                (unsigned long long)st->tier_promotions, (unsigned long long)st->tier_demotions, eat);
+        fprintf(fp, "  \"cycles\": %llu,\n", (unsigned long long)cycles);
+        fprintf(fp, "  \"cycles_breakdown\": {\"tlb\": %llu, \"walk\": %llu, \"fault\": %llu, "
+                    "\"swap\": %llu, \"data\": %llu, \"migrate\": %llu},\n",
+                (unsigned long long)st->cycles_tlb, (unsigned long long)st->cycles_walk,
+                (unsigned long long)st->cycles_fault, (unsigned long long)st->cycles_swap,
+                (unsigned long long)st->cycles_data, (unsigned long long)st->cycles_migrate);
+
+        // 프로세스별 (한 번도 접근하지 않은 pid 는 생략)
+        if (proc && num_procs > 1) {
+            fprintf(fp, "  \"processes\": [\n");
+            bool first = true;
+            for (int pid = 0; pid < num_procs; pid++) {
+                const ProcessStats *ps = &proc[pid];
+                if (!ps->accesses) continue;
+                fprintf(fp, "%s    {\"pid\": %d, \"accesses\": %llu, \"tlb_misses\": %llu, "
+                            "\"page_faults\": %llu, \"evictions\": %llu, \"switches_in\": %llu, "
+                            "\"tlb_miss_rate\": %.6f, \"page_fault_rate\": %.6f}",
+                        first ? "" : ",\n", pid,
+                        (unsigned long long)ps->accesses, (unsigned long long)ps->tlb_misses,
+                        (unsigned long long)ps->page_faults, (unsigned long long)ps->evictions,
+                        (unsigned long long)ps->switches_in,
+                        ratio(ps->tlb_misses, ps->accesses), ratio(ps->page_faults, ps->accesses));
+                first = false;
+            }
+            fprintf(fp, "\n  ],\n");
+        }
+        if (core && num_cores > 1) {
+            fprintf(fp, "  \"cores\": [\n");
+            for (int c = 0; c < num_cores; c++) {
+                const CoreStats *cs = &core[c];
+                fprintf(fp, "    {\"core\": %d, \"accesses\": %llu, \"tlb_misses\": %llu, "
+                            "\"page_faults\": %llu, \"shootdown_ipis\": %llu, \"remote_invalidations\": %llu, "
+                            "\"tlb_miss_rate\": %.6f}%s\n",
+                        c, (unsigned long long)cs->accesses, (unsigned long long)cs->tlb_misses,
+                        (unsigned long long)cs->page_faults, (unsigned long long)cs->shootdown_ipis,
+                        (unsigned long long)cs->remote_invalidations,
+                        ratio(cs->tlb_misses, cs->accesses), c + 1 < num_cores ? "," : "");
+            }
+            fprintf(fp, "  ],\n");
+        }
+
+        fprintf(fp, "  \"tlb_miss_rate\": %.6f,\n", ratio(st->tlb_misses, st->accesses));
+        fprintf(fp, "  \"page_fault_rate\": %.6f,\n", ratio(st->pt_misses, st->accesses));
+        fprintf(fp, "  \"amat\": %.3f\n", ratio(cycles, st->accesses));
+        fprintf(fp, "}\n");
+    }
+
+    close_out(fp);
+}
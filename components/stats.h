@@ -0,0 +1,125 @@
+/* stats.h */
+#ifndef STATS_H
+#define STATS_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "../common.h"
+
+// --- 시뮬레이터 내부 카운터 ---
+// 로그를 grep 하지 않고도 miss rate 등을 얻기 위한 용도
+typedef struct {
+    uint64_t accesses;            // 트레이스 레코드 수 (재시도 제외)
+    uint64_t tlb_hits;            // 첫 TLB 조회 결과 기준
+    uint64_t tlb_misses;
+    uint64_t tlb_level_hits[TLB_LEVELS];   // 단계별 (L2 는 L1 Miss 일 때만 조회)
+    uint64_t tlb_level_misses[TLB_LEVELS];
+    uint64_t pt_hits;             // Page Walk 결과 기준
+    uint64_t pt_misses;           // = Page Fault
+    uint64_t swap_outs;
+    uint64_t writes;              // 쓰기 접근 수 (accesses 에 포함)
+    uint64_t pages_dirtied;       // 쓰기로 PTE Dirty 비트를 새로 설정한 횟수
+    uint64_t writebacks;          // 스왑 장치에 기록한 Dirty Victim 수
+    uint64_t writeback_bytes;
+    uint64_t clean_evictions;     // 기록 없이 버린 Clean Victim 수 (= 피한 write-back)
+    uint64_t writeback_avoided_bytes;
+    uint64_t swap_ins;            // 스왑 장치에서 읽어 온 페이지 수
+    uint64_t swap_in_bytes;
+    uint64_t zero_fills;          // 사본이 없어 0 페이지로 시작한 Page Fault 수
+    uint64_t table_frame_allocs;  // PD2 / PT 프레임 할당 횟수
+    uint64_t frame_evictions[POLICY_COUNT]; // 정책별 프레임 Victim 선정 횟수
+    uint64_t tlb_evictions[POLICY_COUNT];   // 정책별 유효 TLB 엔트리 교체 횟수
+    uint64_t context_switches;    // 실제로 pid 가 바뀐 횟수
+    uint64_t tlb_flushes;         // ASID 없는 TLB 의 문맥 교환 flush 횟수
+    uint64_t tlb_flush_entries;   // flush 로 버린 유효 엔트리 수 (flush 비용)
+    uint64_t shootdowns;          // IPI 를 하나 이상 보낸 shootdown 횟수 (reclaim 묶음당 최대 1회)
+    uint64_t shootdown_ipis;      // 다른 코어로 보낸 IPI 수
+    uint64_t remote_invalidations; // IPI 로 실제로 지워진 원격 TLB 변환 수
+    uint64_t deferred_flushes;    // [Lazy] 문맥 교환 때 처리한 지연 flush 횟수
+    uint64_t deferred_flush_entries;
+    uint64_t pwc_hits;            // Page Walk Cache 에서 시작 테이블을 찾은 Walk 수
+    uint64_t pwc_misses;          // (PWC 가 있을 때) Root 부터 걸은 Walk 수
+    uint64_t walk_mem_refs;       // Page Walk 의 PTE 읽기 수 (PWC 가 건너뛴 단계 제외)
+    uint64_t walk_levels_skipped; // PWC 덕분에 읽지 않은 단계 수
+    uint64_t tlb_huge_hits;       // Superpage 엔트리로 Hit 한 첫 TLB 조회 (tlb_hits 에 포함)
+    uint64_t sp_reservations;     // 영역의 첫 Fault 로 예약한 블록 수
+    uint64_t sp_reservations_broken; // 빈 프레임이 없어 해제한 예약 수
+    uint64_t sp_promotions;
+    uint64_t sp_demotions;        // Superpage 의 페이지가 Victim 이 되어 강등한 횟수
+    uint64_t sp_pages_migrated;   // 승격 때 블록 안으로 복사해 옮긴 페이지 수
+    uint64_t sp_pages_filled;     // 승격 때 채운 비상주 페이지 수 (Swap-in 또는 0 페이지)
+    uint64_t prefetch_issued;     // prefetch 로 적재 / 매핑한 페이지 수
+    uint64_t prefetch_reads;      // 그중 스왑 장치에서 읽은 수 (비동기로 보고 cycle 에 넣지 않음)
+    uint64_t prefetch_useful;     // 내보내기 전에 접근된 prefetch 페이지 수
+    uint64_t prefetch_wasted;     // 한 번도 접근되지 않고 내보낸 prefetch 페이지 수
+    uint64_t prefetch_wasted_bytes;
+    uint64_t pt_tables_freed;     // [pt_reclaim] 유효 엔트리가 없어져 해제한 PD2 / PT 프레임 수
+    uint64_t pt_bytes_reclaimed;  // 그만큼 돌려받은 메모리
+    uint64_t pt_tables_peak;      // 동시에 할당되어 있던 테이블 프레임 수의 최댓값 (Root 포함)
+    uint64_t tier_slow_accesses;  // [Tier] 느린 계층 프레임에서 처리한 데이터 접근 수 (나머지는 DRAM)
+    uint64_t tier_promotions;     // 느린 계층 -> DRAM 으로 옮긴 페이지 수
+    uint64_t tier_demotions;      // 자리를 내주고 DRAM -> 느린 계층으로 옮긴 페이지 수
+
+    // 지연 시간 모델 (geo.lat_*). 합 = 총 cycle, 총 cycle / accesses = AMAT
+    uint64_t cycles_tlb;          // TLB 조회 (L1, L1 Miss 면 L2 까지)
+    uint64_t cycles_walk;         // PWC 조회 + PTE 읽기
+    uint64_t cycles_fault;        // Page Fault 처리 (스왑 I/O 제외)
+    uint64_t cycles_swap;         // 스왑 장치 I/O (Swap-in + Dirty write-back)
+    uint64_t cycles_data;         // 변환 후 데이터 접근 (프레임 계층의 지연)
+    uint64_t cycles_migrate;      // [Tier] 승격 / 강등의 페이지 복사
+} Stats;
+
+// 프로세스별 카운터 (ProcessTable 이 pid 마다 하나씩 소유)
+typedef struct {
+    uint64_t accesses;
+    uint64_t tlb_misses;
+    uint64_t page_faults;
+    uint64_t evictions;           // 이 프로세스의 페이지가 Victim 이 된 횟수
+    uint64_t switches_in;         // 이 프로세스로 문맥 교환된 횟수
+} ProcessStats;
+
+// 코어별 카운터 (Core 가 소유)
+typedef struct {
+    uint64_t accesses;
+    uint64_t tlb_misses;
+    uint64_t page_faults;
+    uint64_t shootdown_ipis;      // 이 코어가 받은 IPI
+    uint64_t remote_invalidations; // 그 IPI 로 지워진 이 코어의 변환 수
+} CoreStats;
+
+static inline uint64_t stats_total_cycles(const Stats *st) {
+    return st->cycles_tlb + st->cycles_walk + st->cycles_fault + st->cycles_swap + st->cycles_data +
+           st->cycles_migrate;
+}
+
+// 시계열 출력 상태 (window 번째 접근마다 CSV 한 줄)
+typedef struct {
+    FILE *fp;
+    uint64_t window;
+    uint64_t left;   // 다음 행을 쓰는 접근 시작까지 남은 수 (0 = 비활성)
+    Stats prev;      // 직전 window 끝 시점의 카운터
+} StatsSeries;
+
+// 시계열 CSV 열기 (window == 0 이면 비활성)
+void stats_open_timeseries(StatsSeries *ts, const char *filename, uint64_t window);
+void stats_close_timeseries(StatsSeries *ts, const Stats *st);
+void stats_write_window(StatsSeries *ts, const Stats *st);
+
+// 종료 시 요약 출력 (.csv 확장자면 CSV, 아니면 JSON / "stdout" 가능)
+// proc: pid 0 ~ num_procs-1 의 카운터 (NULL 가능). 프로세스가 둘 이상이면 JSON 에 "processes" 배열
+// core: 코어별 카운터 (NULL 가능). 코어가 둘 이상이면 JSON 에 "cores" 배열
+void stats_write_summary(const Stats *st, const ProcessStats *proc, int num_procs,
+                         const CoreStats *core, int num_cores,
+                         Policy policy, const char *filename);
+
+// 접근 1회 (main loop 에서 호출, 접근의 TLB 조회 / Fault 처리 전)
+// window 의 마지막 접근이 끝난 뒤에 기록하도록 다음 접근이 시작될 때 행을 씀 (left 는 window + 1 부터)
+static inline void stats_on_access(Stats *st, StatsSeries *ts) {
+    if (ts->left && --ts->left == 0) {
+        stats_write_window(ts, st);
+    }
+    st->accesses++;
+}
+
+#endif
@@ -0,0 +1,221 @@
+/* superpage.c */
+#include "superpage.h"
+#include "sim.h"
+#include "page_table.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+void init_superpages(SimContext *ctx) {
+    SuperpageState *sp = &ctx->sp;
+
+    destroy_superpages(ctx);
+    if (!ctx->geo.superpage) return;
+    sp->pages = 1 << ctx->geo.sp_bits;
+    sp->blocks = ctx->geo.num_frames / sp->pages;
+    sp->block = malloc(sizeof(SPBlock) * sp->blocks);
+    sp->moved = malloc(sizeof(uint64_t) * sp->pages);
+    if (!sp->block || !sp->moved) {
+        perror("malloc superpage blocks");
+        exit(1);
+    }
+    for (int b = 0; b < sp->blocks; b++) {
+        sp->block[b] = (SPBlock){ SP_NO_REGION, 0, -1, false };
+    }
+    vmap_init(&sp->region_block, (uint64_t)sp->blocks);
+}
+
+void destroy_superpages(SimContext *ctx) {
+    SuperpageState *sp = &ctx->sp;
+    if (sp->block) vmap_destroy(&sp->region_block);
+    free(sp->block);
+    free(sp->moved);
+    memset(sp, 0, sizeof(*sp));
+}
+
+static inline uint64_t region_of(const SimContext *ctx, uint64_t key) {
+    return key >> ctx->geo.sp_bits;
+}
+
+// 영역의 예약 블록 (없으면 NULL)
+static SPBlock* region_block(SimContext *ctx, uint64_t region, int *b) {
+    uint64_t v;
+    if (!vmap_get(&ctx->sp.region_block, region, &v)) return NULL;
+    *b = (int)v;
+    return &ctx->sp.block[v];
+}
+
+// key 의 Leaf PTE 위치 (승격 / 강등 중에는 하위 테이블이 모두 있음)
+static int leaf_pte(SimContext *ctx, uint64_t key, uint64_t *idx) {
+    const Geometry *geo = &ctx->geo;
+    int leaf = geo->levels - 1;
+    *idx = KEY_VPN(geo, key) & ((1ULL << geo->level_bits[leaf]) - 1);
+    return pt_table_at(ctx, key, leaf, false);
+}
+
+// 영역의 sp_level 단계 PTE 위치
+static int dir_pte(SimContext *ctx, uint64_t first_key, uint64_t *idx) {
+    const Geometry *geo = &ctx->geo;
+    *idx = GET_LEVEL_INDEX(geo, KEY_VPN(geo, first_key) << geo->offset_bits, geo->sp_level);
+    return pt_table_at(ctx, first_key, geo->sp_level, false);
+}
+
+int sp_alloc_page(SimContext *ctx, uint64_t key) {
+    SuperpageState *sp = &ctx->sp;
+    uint64_t region = region_of(ctx, key);
+    int b;
+    SPBlock *blk = region_block(ctx, region, &b);
+
+    // 영역의 첫 Fault: 빈 블록이 있으면 통째로 예약
+    if (!blk) {
+        int first = find_free_block(ctx, sp->pages);
+        if (first != -1) {
+            reserve_frames(ctx, first, sp->pages);
+            b = first / sp->pages;
+            blk = &sp->block[b];
+            *blk = (SPBlock){ region, 0, -1, false };
+            vmap_put(&sp->region_block, region, (uint64_t)b);
+            ctx->stats.sp_reservations++;
+        }
+    }
+    if (blk) {
+        int pfn = b * sp->pages + (int)(key & (uint64_t)(sp->pages - 1));
+        if (is_frame_reserved(ctx, pfn)) {
+            allocate_reserved_frame(ctx, pfn, key);
+            blk->resident++;
+            return pfn;
+        }
+    }
+    return allocate_free_frame(ctx, key, true);
+}
+
+int sp_try_promote(SimContext *ctx, uint64_t key) {
+    const Geometry *geo = &ctx->geo;
+    SuperpageState *sp = &ctx->sp;
+    uint64_t region = region_of(ctx, key);
+    int b;
+    SPBlock *blk = region_block(ctx, region, &b);
+    if (!blk || blk->promoted || (uint64_t)blk->resident * 100 < (uint64_t)geo->sp_promote * sp->pages) {
+        return -1;
+    }
+
+    int leaf = geo->levels - 1;
+    int base = b * sp->pages;
+    uint64_t first_key = region << geo->sp_bits;
+
+    // 1. 강등 때 다시 연결할 하위 테이블을 모두 갖춤
+    //    (테이블 할당 중 스왑 / 예약 해제가 일어날 수 있으므로 블록 검사는 그 다음)
+    for (int i = 0; i < sp->pages; i += 1 << geo->level_bits[leaf]) {
+        if (pt_table_at(ctx, first_key + i, leaf, true) == -1) return -1;
+    }
+    if (blk->region != region) return -1;
+    // [pt_reclaim] 뒤쪽 테이블 할당의 스왑 아웃이 앞에서 갖춘 테이블을 비워 해제했을 수 있음
+    if (ctx->pt.valid) {
+        for (int i = 0; i < sp->pages; i += 1 << geo->level_bits[leaf]) {
+            if (pt_table_at(ctx, first_key + i, leaf, false) == -1) return -1;
+        }
+    }
+
+    // 2. 모든 자리가 예약 상태(빈 자리)이거나 자기 페이지
+    for (int i = 0; i < sp->pages; i++) {
+        int pfn = base + i;
+        if (is_frame_reserved(ctx, pfn)) continue;
+        if (!is_frame_swappable(ctx, pfn) || get_frame_owner(ctx, pfn) != first_key + i) return -1;
+    }
+
+    // 3. 빈 자리 채우기: 블록 밖에 적재된 페이지는 복사해 옮기고 (Dirty 유지),
+    //    나머지는 스왑 장치의 사본 또는 0 페이지 (khugepaged 의 collapse 와 같음)
+    int moved = 0;
+    for (int i = 0; i < sp->pages; i++) {
+        int pfn = base + i;
+        uint64_t k = first_key + i;
+        uint64_t idx;
+        int table = leaf_pte(ctx, k, &idx);
+        uint64_t pte = read_pte(ctx, table, idx);
+
+        if (is_frame_reserved(ctx, pfn)) {
+            allocate_reserved_frame(ctx, pfn, k);
+            blk->resident++;
+            int old = IS_PTE_PRESENT(geo, pte) ? GET_PTE_PFN(geo, pte) : -1;
+            if (old != -1 && old != pfn && is_frame_swappable(ctx, old) && get_frame_owner(ctx, old) == k) {
+                memcpy(get_frame_ptr(ctx, pfn), get_frame_ptr(ctx, old), geo->page_size);
+                set_frame_dirty(ctx, pfn, is_frame_dirty(ctx, old));
+                release_frame(ctx, old);
+                sp->moved[moved++] = k;
+                ctx->stats.sp_pages_migrated++;
+            } else {
+                swap_read_page(ctx, k, pfn);
+                pte = 0;
+                ctx->stats.sp_pages_filled++;
+            }
+        }
+        write_pte(ctx, table, idx, CREATE_PTE(geo, pfn) | (pte & geo->pte_dirty_mask));
+    }
+
+    // 4. sp_level 단계 PTE 를 큰 페이지로 (가리키던 하위 테이블은 보관)
+    uint64_t dir_idx;
+    int dir = dir_pte(ctx, first_key, &dir_idx);
+    blk->table_pfn = GET_PTE_PFN(geo, read_pte(ctx, dir, dir_idx));
+    write_pte(ctx, dir, dir_idx, CREATE_PTE(geo, base) | geo->pte_huge_mask);
+    blk->promoted = true;
+    ctx->stats.sp_promotions++;
+
+    // 5. 떼어 낸 하위 테이블을 가리키는 PWC 엔트리, 옮긴 페이지의 옛 변환 제거
+    for (int c = 0; c < ctx->num_cores; c++) {
+        PWCState *pwc = &ctx->cores[c].pwc;
+        if (pwc->entries) pwc_invalidate(pwc, geo, first_key, geo->sp_level);
+    }
+    if (moved) tlb_shootdown(ctx, sp->moved, moved);
+    return base;
+}
+
+void sp_before_evict(SimContext *ctx, int pfn) {
+    const Geometry *geo = &ctx->geo;
+    SuperpageState *sp = &ctx->sp;
+    if (!sp->pages || pfn / sp->pages >= sp->blocks) return;
+    SPBlock *blk = &sp->block[pfn / sp->pages];
+    if (!blk->promoted) return;
+
+    // 하위 테이블 다시 연결 (Superpage 의 TLB 엔트리는 Victim 의 shootdown 이 함께 제거)
+    uint64_t first_key = blk->region << geo->sp_bits;
+    uint64_t dir_idx;
+    int dir = dir_pte(ctx, first_key, &dir_idx);
+    uint64_t huge = read_pte(ctx, dir, dir_idx);
+    write_pte(ctx, dir, dir_idx, CREATE_PTE(geo, blk->table_pfn));
+    blk->promoted = false;
+    blk->table_pfn = -1;
+    ctx->stats.sp_demotions++;
+
+    // 큰 페이지의 Dirty 는 어느 페이지가 쓰였는지 모르므로 모든 페이지에 물려줌
+    if (!IS_PTE_DIRTY(geo, huge)) return;
+    for (int i = 0; i < sp->pages; i++) {
+        uint64_t idx;
+        int table = leaf_pte(ctx, first_key + i, &idx);
+        write_pte(ctx, table, idx, read_pte(ctx, table, idx) | geo->pte_dirty_mask);
+    }
+}
+
+bool sp_hold_frame(SimContext *ctx, int pfn) {
+    SuperpageState *sp = &ctx->sp;
+    if (pfn / sp->pages >= sp->blocks) return false;
+    SPBlock *blk = &sp->block[pfn / sp->pages];
+
+    // 테이블로 쓰이던 프레임이나 다른 영역의 페이지는 일반 해제
+    if (blk->region == SP_NO_REGION || !is_frame_swappable(ctx, pfn) ||
+        region_of(ctx, get_frame_owner(ctx, pfn)) != blk->region) {
+        return false;
+    }
+    if (blk->resident > 0) blk->resident--;
+    return true;
+}
+
+void sp_break_reservation(SimContext *ctx, int pfn) {
+    SuperpageState *sp = &ctx->sp;
+    int b = pfn / sp->pages;
+    SPBlock *blk = &sp->block[b];
+
+    unreserve_frames(ctx, b * sp->pages, sp->pages);
+    if (blk->region != SP_NO_REGION) vmap_remove(&sp->region_block, blk->region);
+    *blk = (SPBlock){ SP_NO_REGION, 0, -1, false };
+    ctx->stats.sp_reservations_broken++;
+}
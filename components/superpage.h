@@ -0,0 +1,58 @@
+/* superpage.h */
+#ifndef SUPERPAGE_H
+#define SUPERPAGE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "../common.h"
+#include "vpn_map.h"
+
+// --- Superpage (큰 페이지, geo.superpage) ---
+// sp_level 단계 PTE 가 Huge 비트와 함께 2^sp_bits 페이지(= 영역)를 정렬된 연속 프레임(= 블록)에 직접 매핑
+//
+// 예약 기반 할당: 영역의 첫 Page Fault 때 빈 블록 하나를 통째로 예약하고,
+// 그 영역의 페이지는 블록 안의 자기 자리 (블록 첫 프레임 + 영역 안 인덱스) 에 적재
+// 승격: 자기 자리에 적재된 페이지가 sp_promote % 이상이 되면
+//   나머지 자리를 채우고 (스왑 장치의 사본 또는 0 페이지), 블록 밖에 있던 페이지는 복사해 옮긴 뒤
+//   sp_level 단계 PTE 를 큰 페이지로 바꿈. 원래 하위 테이블은 떼어 두었다가 (deposit) 강등 때 다시 연결
+// 강등: Superpage 의 페이지 하나가 Victim 이 되면 하위 테이블을 다시 연결하고 그 페이지만 내보냄
+//   (예약은 유지되므로 그 페이지가 다시 자기 자리에 들어오면 재승격)
+// 빈 프레임이 바닥나면 가장 낮은 예약 블록의 빈 자리를 일반 할당에 돌려줌 (그 영역은 더 이상 승격 불가)
+#define SP_NO_REGION UINT64_MAX
+
+typedef struct {
+    uint64_t region;      // 예약한 영역 (= 페이지 키 >> sp_bits, SP_NO_REGION = 예약 없음)
+    int resident;         // 자기 자리에 적재된 그 영역의 페이지 수
+    int table_pfn;        // 승격 중 떼어 둔 하위 테이블 (아니면 -1)
+    bool promoted;
+} SPBlock;
+
+typedef struct {
+    int pages;            // 블록 하나의 페이지 수 (0 = Superpage 없음)
+    int blocks;           // num_frames / pages (끝의 자투리 프레임은 예약하지 않음)
+    SPBlock *block;
+    VpnMap region_block;  // 영역 -> 블록 번호
+    uint64_t *moved;      // 승격 중 옮긴 페이지 키 (shootdown 묶음, pages 개)
+} SuperpageState;
+
+// init_memory 이후 호출
+void init_superpages(SimContext *ctx);
+void destroy_superpages(SimContext *ctx);
+
+// Page Fault 의 데이터 프레임 할당 (allocate_free_frame 대신)
+// 영역의 예약 블록에 자리가 있으면 그 자리, 없으면 새 블록을 예약하거나 일반 할당. 메모리가 차면 -1
+int sp_alloc_page(SimContext *ctx, uint64_t key);
+
+// Page Table 갱신 직후 호출: 승격 조건을 만족하면 승격하고 블록 첫 프레임, 아니면 -1
+int sp_try_promote(SimContext *ctx, uint64_t key);
+
+// Victim 을 내보내기 전 호출: 승격된 블록의 프레임이면 강등
+void sp_before_evict(SimContext *ctx, int pfn);
+
+// 해제되는 프레임이 자기 영역의 예약 자리면 true (memory.c 가 예약 상태로 되돌림)
+bool sp_hold_frame(SimContext *ctx, int pfn);
+
+// pfn 이 속한 예약 블록의 예약 해제 (빈 자리는 일반 할당으로)
+void sp_break_reservation(SimContext *ctx, int pfn);
+
+#endif
@@ -3,73 +3,616 @@
 #include "memory.h"
 #include "tlb.h"
 #include "page_table.h"
-#include "../common.h"
+#include "stats.h"
+#include "sim.h"
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 
-static int swap_rr_idx = 0; // RR Victim Pointer
+// --- 교체 정책 인터페이스 ---
+// 정책마다 필요한 이벤트만 구현 (NULL 이면 무시)
+// select_victim 은 Victim PFN 을 고르고 정책 자료구조에서 빼는 것까지 담당 (없으면 -1)
+typedef struct {
+    void (*init)(SimContext *ctx);
+    void (*on_fault)(SimContext *ctx, uint64_t vpn);
+    void (*on_load)(SimContext *ctx, int pfn, uint64_t vpn);
+    void (*on_unload)(SimContext *ctx, int pfn);
+    void (*on_access)(SimContext *ctx, int pfn);
+    int (*select_victim)(SimContext *ctx);
+} ReplacementOps;
 
-// [LRU] 각 프레임의 마지막 접근 시간 기록용 배열
-static uint64_t frame_last_access[NUM_FRAMES];
+// --- Ghost List ---
+static void ghost_init(GhostList *g, int capacity) {
+    if (capacity < 1) capacity = 1;
+    vmap_init(&g->index, capacity);
+    lru_init(&g->order, capacity);
+    g->vpn = malloc(sizeof(uint64_t) * capacity);
+    g->free_slots = malloc(sizeof(int) * capacity);
+    if (!g->vpn || !g->free_slots) {
+        perror("malloc ghost list");
+        exit(1);
+    }
+    for (int i = 0; i < capacity; i++) g->free_slots[i] = capacity - 1 - i;
+    g->free_count = capacity;
+    g->capacity = capacity;
+}
 
-// [Internal] 비트마스크 읽기 헬퍼 (memory.c의 Helper와 유사 역할)
-// 실제 구현은 memory.c의 physical_memory에 접근해야 하므로, 
-// memory.h에 선언된 check_swappable 함수나 매커니즘을 사용하는 것이 좋으나,
-// 여기서는 내부 static 함수로 구현합니다.
-static bool check_swappable(int pfn) {
-    int byte_idx = pfn / 8;
-    int bit_idx = pfn % 8;
-    return (physical_memory[byte_idx] >> bit_idx) & 1;
+static void ghost_destroy(GhostList *g) {
+    if (!g->capacity) return;
+    vmap_destroy(&g->index);
+    lru_destroy(&g->order);
+    free(g->vpn);
+    free(g->free_slots);
+    memset(g, 0, sizeof(*g));
 }
 
-// [LRU] 프레임 접근 시간 갱신
-void acknowledge_frame_access(int pfn) {
-    if (pfn >= 0 && pfn < NUM_FRAMES) {
-        frame_last_access[pfn] = g_time;
+static inline int ghost_size(const GhostList *g) {
+    return g->order.size;
+}
+
+static bool ghost_remove(GhostList *g, uint64_t vpn) {
+    uint64_t slot;
+    if (!vmap_get(&g->index, vpn, &slot)) return false;
+    vmap_remove(&g->index, vpn);
+    lru_remove(&g->order, (int)slot);
+    g->free_slots[g->free_count++] = (int)slot;
+    return true;
+}
+
+static void ghost_pop_oldest(GhostList *g) {
+    int slot = lru_head(&g->order);
+    if (slot != LRU_NIL) ghost_remove(g, g->vpn[slot]);
+}
+
+// 가득 차 있으면 가장 오래된 기록을 버림. 버렸으면 true
+static bool ghost_push(GhostList *g, uint64_t vpn) {
+    bool dropped = false;
+    ghost_remove(g, vpn); // 같은 VPN 은 하나만 (가장 최근 위치로)
+    if (g->free_count == 0) {
+        ghost_pop_oldest(g);
+        dropped = true;
     }
+    int slot = g->free_slots[--g->free_count];
+    g->vpn[slot] = vpn;
+    vmap_put(&g->index, vpn, (uint64_t)slot);
+    lru_push_tail(&g->order, slot);
+    return dropped;
+}
+
+// 큐의 head 를 꺼냄 (비었으면 -1)
+static int queue_pop(LRUList *q) {
+    int pfn = lru_head(q);
+    if (pfn == LRU_NIL) return -1;
+    lru_remove(q, pfn);
+    return pfn;
 }
 
-int swap_out() {
-    int victim_pfn = -1;
+// ------------------------------------------------------------
+// RR
+// ------------------------------------------------------------
+static int rr_select(SimContext *ctx) {
+    SwapState *s = &ctx->swap;
+    int num_frames = ctx->geo.num_frames;
 
-    if (g_policy == POLICY_RR) {
-        // --- Round Robin Policy ---
-        int checked_count = 0;
-        while (checked_count < NUM_FRAMES) {
-            int curr = swap_rr_idx;
-            swap_rr_idx = (swap_rr_idx + 1) % NUM_FRAMES;
-            checked_count++;
+    int checked_count = 0;
+    while (checked_count < num_frames) {
+        int curr = s->rr_idx;
+        s->rr_idx = (s->rr_idx + 1) % num_frames;
+        checked_count++;
 
-            if (check_swappable(curr)) {
-                victim_pfn = curr;
-                break;
-            }
+        if (is_frame_swappable(ctx, curr)) {
+            return curr;
+        }
+    }
+    return -1;
+}
+
+// ------------------------------------------------------------
+// LRU
+// ------------------------------------------------------------
+// 재할당된 프레임은 이전 접근 시간을 그대로 가지므로 정렬 위치에 삽입
+// prefetch 는 접근 전이므로 이전 시간 대신 Miss 시각 (head 에 넣으면 같은 묶음의 prefetch 끼리 서로 내보냄)
+static void lru_on_load(SimContext *ctx, int pfn, uint64_t vpn) {
+    (void)vpn;
+    SwapState *s = &ctx->swap;
+    if (s->load_prefetch) {
+        s->frame_last_access[pfn] = ctx->time;
+        lru_insert_sorted(&s->frame_lru, pfn, s->frame_last_access);
+    } else if (!lru_contains(&s->frame_lru, pfn)) {
+        lru_insert_sorted(&s->frame_lru, pfn, s->frame_last_access);
+    }
+}
+
+static void lru_on_unload(SimContext *ctx, int pfn) {
+    lru_remove(&ctx->swap.frame_lru, pfn);
+}
+
+static void lru_on_access(SimContext *ctx, int pfn) {
+    SwapState *s = &ctx->swap;
+    s->frame_last_access[pfn] = ctx->time;
+    if (lru_contains(&s->frame_lru, pfn)) {
+        lru_insert_sorted(&s->frame_lru, pfn, s->frame_last_access);
+    }
+}
+
+// Swappable한 프레임 중 last_access_time이 가장 작은 프레임 = 리스트 head (O(1))
+// (Victim 은 재할당될 때까지 리스트에 남겨둠: 기존 선형 탐색과 같은 순서 유지)
+static int lru_select(SimContext *ctx) {
+    int head = lru_head(&ctx->swap.frame_lru);
+    return head != LRU_NIL ? head : -1;
+}
+
+// ------------------------------------------------------------
+// CLOCK: 프레임 배열을 원형으로 돌며 참조 비트가 0 인 프레임 선택
+// ------------------------------------------------------------
+static void clock_on_load(SimContext *ctx, int pfn, uint64_t vpn) {
+    (void)vpn;
+    ctx->swap.frame_flags[pfn] = 0; // 첫 접근에서 참조 비트가 켜짐 (prefetch 는 접근 전까지 꺼진 채로)
+}
+
+static void clock_on_access(SimContext *ctx, int pfn) {
+    ctx->swap.frame_flags[pfn] |= FRAME_REF;
+}
+
+static int clock_select(SimContext *ctx) {
+    SwapState *s = &ctx->swap;
+    int num_frames = ctx->geo.num_frames;
+
+    // 한 바퀴 돌면서 참조 비트를 모두 지우므로 두 바퀴 안에 반드시 찾음
+    for (int step = 0; step < 2 * num_frames; step++) {
+        int curr = s->rr_idx;
+        s->rr_idx = (s->rr_idx + 1) % num_frames;
+        if (!is_frame_swappable(ctx, curr)) continue;
+
+        if (s->frame_flags[curr] & FRAME_REF) {
+            s->frame_flags[curr] &= ~FRAME_REF; // second chance
+            continue;
+        }
+        return curr;
+    }
+    return -1;
+}
+
+// ------------------------------------------------------------
+// 2Q (Johnson & Shasha): 처음 들어온 페이지는 FIFO A1in,
+// A1in 에서 밀려난 뒤 다시 참조되면(A1out 에 기록) LRU Am 으로
+// ------------------------------------------------------------
+#define Q_A1IN 0
+#define Q_AM   1
+
+static void twoq_init(SimContext *ctx) {
+    SwapState *s = &ctx->swap;
+    int n = ctx->geo.num_frames;
+    lru_init(&s->queue[Q_A1IN], n);
+    lru_init(&s->queue[Q_AM], n);
+    ghost_init(&s->ghost[0], s->capacity / 2); // Kout = c / 2
+}
+
+static void twoq_on_load(SimContext *ctx, int pfn, uint64_t vpn) {
+    SwapState *s = &ctx->swap;
+    // prefetch 는 A1out 기록이 있어도 A1in 으로 (Am 승격은 실제로 다시 Fault 날 때)
+    if (!s->load_prefetch && ghost_remove(&s->ghost[0], vpn)) {
+        lru_push_tail(&s->queue[Q_AM], pfn);
+    } else {
+        lru_push_tail(&s->queue[Q_A1IN], pfn);
+    }
+}
+
+static void twoq_on_unload(SimContext *ctx, int pfn) {
+    lru_remove(&ctx->swap.queue[Q_A1IN], pfn);
+    lru_remove(&ctx->swap.queue[Q_AM], pfn);
+}
+
+static void twoq_on_access(SimContext *ctx, int pfn) {
+    LRUList *am = &ctx->swap.queue[Q_AM];
+    if (lru_contains(am, pfn)) lru_push_tail(am, pfn); // A1in 안에서의 재참조는 무시
+}
+
+static int twoq_select(SimContext *ctx) {
+    SwapState *s = &ctx->swap;
+    int kin = s->capacity / 4 > 0 ? s->capacity / 4 : 1;
+
+    if (s->queue[Q_A1IN].size > kin || s->queue[Q_AM].size == 0) {
+        int pfn = queue_pop(&s->queue[Q_A1IN]);
+        if (pfn != -1) ghost_push(&s->ghost[0], get_frame_owner(ctx, pfn));
+        return pfn;
+    }
+    return queue_pop(&s->queue[Q_AM]);
+}
+
+// ------------------------------------------------------------
+// ARC (Megiddo & Modha): T1 (한 번 참조) / T2 (두 번 이상) 와 각각의 ghost B1 / B2
+// ghost hit 방향으로 T1 목표 크기 p 를 조정
+// ------------------------------------------------------------
+#define Q_T1 0
+#define Q_T2 1
+
+static void arc_init(SimContext *ctx) {
+    SwapState *s = &ctx->swap;
+    int n = ctx->geo.num_frames;
+    lru_init(&s->queue[Q_T1], n);
+    lru_init(&s->queue[Q_T2], n);
+    ghost_init(&s->ghost[0], s->capacity);
+    ghost_init(&s->ghost[1], s->capacity);
+}
+
+static void arc_on_fault(SimContext *ctx, uint64_t vpn) {
+    SwapState *s = &ctx->swap;
+    uint64_t slot;
+    int b1 = ghost_size(&s->ghost[0]), b2 = ghost_size(&s->ghost[1]);
+
+    s->fault_ghost = 0;
+    if (vmap_get(&s->ghost[0].index, vpn, &slot)) {
+        int delta = b1 ? (b2 / b1 > 1 ? b2 / b1 : 1) : 1;
+        s->target = s->target + delta < s->capacity ? s->target + delta : s->capacity;
+        s->fault_ghost = 1;
+    } else if (vmap_get(&s->ghost[1].index, vpn, &slot)) {
+        int delta = b2 ? (b1 / b2 > 1 ? b1 / b2 : 1) : 1;
+        s->target = s->target - delta > 0 ? s->target - delta : 0;
+        s->fault_ghost = 2;
+    }
+}
+
+static void arc_on_load(SimContext *ctx, int pfn, uint64_t vpn) {
+    SwapState *s = &ctx->swap;
+    // prefetch 는 ghost 기록이 있어도 T1 으로 (B1 / B2 hit 은 실제로 다시 Fault 날 때)
+    bool seen = !s->load_prefetch && (ghost_remove(&s->ghost[0], vpn) || ghost_remove(&s->ghost[1], vpn));
+    lru_push_tail(&s->queue[seen ? Q_T2 : Q_T1], pfn);
+    s->frame_flags[pfn] = FRAME_FRESH;
+    s->fault_ghost = 0;
+}
+
+static void arc_on_unload(SimContext *ctx, int pfn) {
+    lru_remove(&ctx->swap.queue[Q_T1], pfn);
+    lru_remove(&ctx->swap.queue[Q_T2], pfn);
+}
+
+static void arc_on_access(SimContext *ctx, int pfn) {
+    SwapState *s = &ctx->swap;
+    if (s->frame_flags[pfn] & FRAME_FRESH) {
+        s->frame_flags[pfn] &= ~FRAME_FRESH; // Page Fault 를 일으킨 접근
+        return;
+    }
+    if (lru_contains(&s->queue[Q_T1], pfn)) lru_remove(&s->queue[Q_T1], pfn);
+    lru_push_tail(&s->queue[Q_T2], pfn);
+}
+
+// REPLACE(x, p)
+static int arc_select(SimContext *ctx) {
+    SwapState *s = &ctx->swap;
+    LRUList *t1 = &s->queue[Q_T1], *t2 = &s->queue[Q_T2];
+    GhostList *b1 = &s->ghost[0], *b2 = &s->ghost[1];
+    int c = s->capacity;
+
+    bool from_t1 = t1->size > 0 &&
+                   ((s->fault_ghost == 2 && t1->size == s->target) || t1->size > s->target);
+    if (!from_t1 && t2->size == 0) from_t1 = true;
+
+    int pfn = queue_pop(from_t1 ? t1 : t2);
+    if (pfn == -1) return -1;
+
+    // ghost 크기 제한: |T1| + |B1| <= c, 전체 <= 2c
+    if (from_t1) {
+        ghost_push(b1, get_frame_owner(ctx, pfn));
+        while (t1->size + ghost_size(b1) > c && ghost_size(b1) > 0) ghost_pop_oldest(b1);
+    } else {
+        ghost_push(b2, get_frame_owner(ctx, pfn));
+    }
+    while (t1->size + t2->size + ghost_size(b1) + ghost_size(b2) > 2 * c) {
+        ghost_pop_oldest(ghost_size(b2) > 0 ? b2 : b1);
+    }
+    return pfn;
+}
+
+// ------------------------------------------------------------
+// CLOCK-Pro (Jiang, Chen & Zhang): 재참조 거리로 hot / cold 구분
+// cold 페이지는 test 기간 동안 재참조되면 hot 으로 승격
+// test 기간 중에 내보낸 cold 페이지는 ghost 에 남겨두고, 다시 fault 나면 hot 으로 적재
+// 하나의 clock 대신 cold / hot clock 을 따로 두어 각 hand 가 자기 페이지만 훑도록 함
+// (list head = hand 위치, second chance 는 tail 로 이동)
+// 비상주 test 페이지는 hand_test 대신 크기 c 의 FIFO 로 만료시킴
+// ------------------------------------------------------------
+#define Q_COLD 0
+#define Q_HOT  1
+
+static void clockpro_init(SimContext *ctx) {
+    SwapState *s = &ctx->swap;
+    int n = ctx->geo.num_frames;
+    lru_init(&s->queue[Q_COLD], n);
+    lru_init(&s->queue[Q_HOT], n);
+    ghost_init(&s->ghost[0], s->capacity);
+    s->target = 1; // m_c: cold 목표 수 (ghost hit 마다 증가, test 만료마다 감소)
+}
+
+// hand_hot: hot 페이지 하나를 cold 로 강등 (참조 비트가 켜진 hot 은 비트만 지우고 통과)
+static void clockpro_run_hot_hand(SimContext *ctx) {
+    SwapState *s = &ctx->swap;
+    LRUList *hot = &s->queue[Q_HOT];
+
+    for (int step = 0; step <= hot->size; step++) {
+        int pfn = lru_head(hot);
+        if (pfn == LRU_NIL) return;
+
+        uint8_t *f = &s->frame_flags[pfn];
+        if (*f & FRAME_REF) {
+            *f &= ~FRAME_REF;
+            lru_push_tail(hot, pfn);
+            continue;
         }
-    } 
-    else if (g_policy == POLICY_LRU) {
-        // --- LRU Policy ---
-        // Swappable한 프레임 중 last_access_time이 가장 작은 프레임 탐색
-        uint64_t min_time = UINT64_MAX;
-        
-        for (int i = 0; i < NUM_FRAMES; i++) {
-            if (check_swappable(i)) {
-                if (frame_last_access[i] < min_time) {
-                    min_time = frame_last_access[i];
-                    victim_pfn = i;
-                }
+        lru_remove(hot, pfn);
+        *f &= ~FRAME_HOT;
+        lru_push_tail(&s->queue[Q_COLD], pfn);
+        return;
+    }
+}
+
+// hot 페이지 수를 m_h = c - m_c 이하로 유지
+static void clockpro_balance(SimContext *ctx) {
+    SwapState *s = &ctx->swap;
+    while (s->queue[Q_HOT].size > 0 && s->queue[Q_HOT].size > s->capacity - s->target) {
+        clockpro_run_hot_hand(ctx);
+    }
+}
+
+static void clockpro_on_fault(SimContext *ctx, uint64_t vpn) {
+    SwapState *s = &ctx->swap;
+    s->fault_ghost = 0;
+    if (ghost_remove(&s->ghost[0], vpn)) {
+        if (s->target < s->capacity - 1) s->target++;
+        s->fault_ghost = 1;
+    }
+}
+
+static void clockpro_on_load(SimContext *ctx, int pfn, uint64_t vpn) {
+    (void)vpn;
+    SwapState *s = &ctx->swap;
+    if (s->load_prefetch) {
+        // prefetch: test 기간 없는 cold 페이지. hand 가 오기 전에 접근되면 참조 비트로 test 기간을 얻음
+        s->frame_flags[pfn] = 0;
+        lru_push_tail(&s->queue[Q_COLD], pfn);
+        return;
+    }
+    if (s->fault_ghost) {
+        s->frame_flags[pfn] = FRAME_FRESH | FRAME_HOT;
+        lru_push_tail(&s->queue[Q_HOT], pfn);
+    } else {
+        s->frame_flags[pfn] = FRAME_FRESH | FRAME_TEST;
+        lru_push_tail(&s->queue[Q_COLD], pfn);
+    }
+    s->fault_ghost = 0;
+    clockpro_balance(ctx);
+}
+
+static void clockpro_on_unload(SimContext *ctx, int pfn) {
+    SwapState *s = &ctx->swap;
+    lru_remove(&s->queue[Q_COLD], pfn);
+    lru_remove(&s->queue[Q_HOT], pfn);
+    s->frame_flags[pfn] = 0;
+}
+
+static void clockpro_on_access(SimContext *ctx, int pfn) {
+    uint8_t *f = &ctx->swap.frame_flags[pfn];
+    if (*f & FRAME_FRESH) *f &= ~FRAME_FRESH;
+    else *f |= FRAME_REF;
+}
+
+// hand_cold: 참조 비트가 꺼진 cold 페이지를 내보냄
+static int clockpro_select(SimContext *ctx) {
+    SwapState *s = &ctx->swap;
+    LRUList *cold = &s->queue[Q_COLD];
+
+    while (1) {
+        // cold 페이지가 없으면 hot 하나를 강등
+        if (cold->size == 0) {
+            clockpro_run_hot_hand(ctx);
+            if (cold->size == 0) return -1;
+        }
+
+        int pfn = lru_head(cold);
+        uint8_t *f = &s->frame_flags[pfn];
+        if (*f & FRAME_REF) {
+            *f &= ~FRAME_REF;
+            if (*f & FRAME_TEST) {
+                // test 기간 중 재참조 -> hot 승격
+                lru_remove(cold, pfn);
+                *f = (*f & ~FRAME_TEST) | FRAME_HOT;
+                lru_push_tail(&s->queue[Q_HOT], pfn);
+                clockpro_balance(ctx);
+            } else {
+                *f |= FRAME_TEST; // 새 test 기간 시작
+                lru_push_tail(cold, pfn);
             }
+            continue;
+        }
+
+        // Victim: test 기간 중이면 비상주 test 페이지로 기록
+        lru_remove(cold, pfn);
+        if ((*f & FRAME_TEST) && ghost_push(&s->ghost[0], get_frame_owner(ctx, pfn))) {
+            // 가장 오래된 test 기간이 재참조 없이 끝남 -> cold 목표 감소
+            if (s->target > 1) s->target--;
+        }
+        *f = 0;
+        return pfn;
+    }
+}
+
+// ------------------------------------------------------------
+// OPT (Belady): 다음 사용 시점이 가장 먼 프레임 (힙 top, fault 당 O(log n))
+// ------------------------------------------------------------
+static void opt_init(SimContext *ctx) {
+    heap_init(&ctx->swap.opt_heap, ctx->geo.num_frames);
+}
+
+// prefetch 는 다음 사용 시점을 모르므로 가장 먼저 내보낼 대상 (첫 접근 때 갱신)
+static void opt_on_load(SimContext *ctx, int pfn, uint64_t vpn) {
+    (void)vpn;
+    heap_update(&ctx->swap.opt_heap, pfn, ctx->swap.load_prefetch ? NEXT_USE_NEVER : sim_next_use(ctx));
+}
+
+static void opt_on_unload(SimContext *ctx, int pfn) {
+    heap_remove(&ctx->swap.opt_heap, pfn);
+}
+
+static void opt_on_access(SimContext *ctx, int pfn) {
+    heap_update(&ctx->swap.opt_heap, pfn, sim_next_use(ctx));
+}
+
+static int opt_select(SimContext *ctx) {
+    IndexHeap *h = &ctx->swap.opt_heap;
+    int pfn = heap_top(h);
+    if (pfn != -1) heap_remove(h, pfn);
+    return pfn;
+}
+
+static const ReplacementOps policy_ops[POLICY_COUNT] = {
+    [POLICY_RR]        = { NULL, NULL, NULL, NULL, NULL, rr_select },
+    [POLICY_LRU]       = { NULL, NULL, lru_on_load, lru_on_unload, lru_on_access, lru_select },
+    [POLICY_CLOCK]     = { NULL, NULL, clock_on_load, NULL, clock_on_access, clock_select },
+    [POLICY_CLOCK_PRO] = { clockpro_init, clockpro_on_fault, clockpro_on_load, clockpro_on_unload,
+                           clockpro_on_access, clockpro_select },
+    [POLICY_2Q]        = { twoq_init, NULL, twoq_on_load, twoq_on_unload, twoq_on_access, twoq_select },
+    [POLICY_ARC]       = { arc_init, arc_on_fault, arc_on_load, arc_on_unload, arc_on_access, arc_select },
+    [POLICY_OPT]       = { opt_init, NULL, opt_on_load, opt_on_unload, opt_on_access, opt_select },
+};
+
+void init_swap(SimContext *ctx) {
+    SwapState *s = &ctx->swap;
+    int num_frames = ctx->geo.num_frames;
+
+    destroy_swap(ctx);
+    s->frame_last_access = calloc(num_frames, sizeof(uint64_t));
+    s->frame_flags = calloc(num_frames, sizeof(uint8_t));
+    s->reclaim_keys = malloc(sizeof(uint64_t) * ctx->geo.reclaim_batch);
+    if (!s->frame_last_access || !s->frame_flags || !s->reclaim_keys) {
+        perror("malloc frame_last_access");
+        exit(1);
+    }
+    lru_init(&s->frame_lru, num_frames);
+    s->capacity = num_frames - (ctx->geo.root_pfn + 1);
+    swapdev_init(&s->device, ctx->geo.page_size);
+
+    const ReplacementOps *ops = &policy_ops[ctx->policy];
+    if (ops->init) ops->init(ctx);
+}
+
+void destroy_swap(SimContext *ctx) {
+    SwapState *s = &ctx->swap;
+    free(s->frame_last_access);
+    free(s->frame_flags);
+    free(s->reclaim_keys);
+    if (s->frame_lru.capacity) lru_destroy(&s->frame_lru);
+    for (int i = 0; i < 2; i++) {
+        if (s->queue[i].capacity) lru_destroy(&s->queue[i]);
+        ghost_destroy(&s->ghost[i]);
+    }
+    if (s->opt_heap.capacity) heap_destroy(&s->opt_heap);
+    swapdev_destroy(&s->device);
+    memset(s, 0, sizeof(*s));
+}
+
+void swap_note_fault(SimContext *ctx, uint64_t vpn) {
+    const ReplacementOps *ops = &policy_ops[ctx->policy];
+    if (ops->on_fault) ops->on_fault(ctx, vpn);
+}
+
+// 테이블 프레임은 교체 대상이 아니므로 무시
+// (테이블 할당 중 방금 적재한 데이터 프레임이 Victim 이 되면 그 VPN 의 매핑이 테이블 프레임을 가리킬 수 있음)
+bool acknowledge_frame_access(SimContext *ctx, int pfn) {
+    const ReplacementOps *ops = &policy_ops[ctx->policy];
+    if (pfn < 0 || pfn >= ctx->geo.num_frames || !is_frame_swappable(ctx, pfn)) return false;
+    if (ops->on_access) ops->on_access(ctx, pfn);
+    if (ctx->tier.heat) ctx->tier.heat[pfn]++;
+    if (!ctx->pf.unused || !ctx->pf.unused[pfn]) return false;
+    ctx->pf.unused[pfn] = 0;
+    ctx->stats.prefetch_useful++;
+    return true;
+}
+
+void swap_exchange_frames(SimContext *ctx, int a, int b) {
+    SwapState *s = &ctx->swap;
+    uint64_t t = s->frame_last_access[a];
+    s->frame_last_access[a] = s->frame_last_access[b];
+    s->frame_last_access[b] = t;
+    uint8_t f = s->frame_flags[a];
+    s->frame_flags[a] = s->frame_flags[b];
+    s->frame_flags[b] = f;
+
+    lru_exchange(&s->frame_lru, a, b);
+    for (int i = 0; i < 2; i++) {
+        if (s->queue[i].capacity) lru_exchange(&s->queue[i], a, b);
+    }
+    if (s->opt_heap.capacity) heap_exchange(&s->opt_heap, a, b);
+}
+
+void notify_swappable_change(SimContext *ctx, int pfn, bool swappable) {
+    const ReplacementOps *ops = &policy_ops[ctx->policy];
+    if (ctx->pf.unused) ctx->pf.unused[pfn] = swappable && ctx->swap.load_prefetch;
+    if (swappable) {
+        if (ops->on_load) ops->on_load(ctx, pfn, get_frame_owner(ctx, pfn));
+    } else {
+        if (ops->on_unload) ops->on_unload(ctx, pfn);
+    }
+}
+
+// reclaim_batch 개까지 Victim 을 한 번에 회수하고 TLB shootdown 은 묶음당 1회
+// (batch 1 이면 기존과 같이 Victim 하나, 프레임은 재할당될 때까지 교체 정책에 남음)
+// 묶음 회수에서는 뒤의 Victim 선정이 앞의 Victim 을 다시 고르지 않도록 Swappable 비트를 바로 끔
+int swap_out(SimContext *ctx) {
+    PROF_ENTER(PROF_EVICT);
+    int batch = ctx->geo.reclaim_batch;
+    uint64_t *keys = ctx->swap.reclaim_keys;
+
+    int first_pfn = -1, n = 0;
+    for (; n < batch; n++) {
+        int victim_pfn = policy_ops[ctx->policy].select_victim(ctx);
+        if (victim_pfn == -1) break;
+
+        ctx->stats.swap_outs++;
+        ctx->stats.frame_evictions[ctx->policy]++;
+
+        // Victim 처리 (다른 프로세스의 페이지일 수 있으므로 키의 pid 기준)
+        uint64_t victim_key = get_frame_owner(ctx, victim_pfn);
+        ctx->proc.stats[KEY_PID(&ctx->geo, victim_key)].evictions++;
+        sp_before_evict(ctx, victim_pfn); // Superpage 의 페이지면 먼저 강등
+        if (ctx->pf.unused && ctx->pf.unused[victim_pfn]) {
+            ctx->pf.unused[victim_pfn] = 0; // 한 번도 쓰지 않고 내보내는 prefetch
+            ctx->stats.prefetch_wasted++;
+            ctx->stats.prefetch_wasted_bytes += ctx->geo.page_size;
+        }
+
+        // 쓰기 이후 내보내는 페이지만 스왑 장치에 기록 (Clean 이면 장치의 사본이나 0 페이지와 같음)
+        if (invalidate_pt_mapping(ctx, victim_key)) {
+            swapdev_write(&ctx->swap.device, victim_key, get_frame_ptr(ctx, victim_pfn));
+            ctx->stats.writebacks++;
+            ctx->stats.writeback_bytes += ctx->geo.page_size;
+            ctx->stats.cycles_swap += ctx->geo.lat_swap;
+        } else {
+            ctx->stats.clean_evictions++;
+            ctx->stats.writeback_avoided_bytes += ctx->geo.page_size;
         }
+        if (batch > 1) release_frame(ctx, victim_pfn);
+        else free_frame(ctx, victim_pfn);
+
+        keys[n] = victim_key;
+        if (first_pfn == -1) first_pfn = victim_pfn;
     }
+    tlb_shootdown(ctx, keys, n);
 
-    if (victim_pfn == -1) {
+    if (first_pfn == -1) {
         fprintf(stderr, "Error: No swappable frames found! Memory deadlock.\n");
-        return -1;
     }
+    PROF_EXIT(PROF_EVICT);
+    return first_pfn;
+}
 
-    // Victim 처리
-    uint16_t victim_vpn = get_frame_owner(victim_pfn);
-    invalidate_tlb_by_vpn(victim_vpn);
-    invalidate_pt_mapping(victim_vpn);
-    free_frame(victim_pfn);
+bool swap_read_page(SimContext *ctx, uint64_t key, int pfn) {
+    if (!swapdev_read(&ctx->swap.device, key, get_frame_ptr(ctx, pfn))) return false;
+    ctx->stats.swap_ins++;
+    ctx->stats.swap_in_bytes += ctx->geo.page_size;
+    ctx->stats.cycles_swap += ctx->geo.lat_swap;
+    return true;
+}
 
-    return victim_pfn;
-}
\ No newline at end of file
+void swap_in(SimContext *ctx, uint64_t key, int pfn) {
+    if (!swap_read_page(ctx, key, pfn)) ctx->stats.zero_fills++;
+}
@@ -3,11 +3,88 @@
 #define SWAP_H
 
 #include <stdint.h>
+#include <stdbool.h>
+#include "../common.h"
+#include "lru_list.h"
+#include "vpn_map.h"
+#include "index_heap.h"
+#include "swap_device.h"
+
+// 프레임별 상태 비트 (SwapState.frame_flags, 프레임당 1 byte)
+#define FRAME_REF   0x01  // 참조 비트 (CLOCK, CLOCK-Pro) - 하드웨어 Accessed 비트에 해당
+#define FRAME_FRESH 0x02  // 적재 직후 아직 접근 전 (첫 접근은 재참조로 치지 않음)
+#define FRAME_HOT   0x04  // [CLOCK-Pro] hot 페이지
+#define FRAME_TEST  0x08  // [CLOCK-Pro] test 기간 중인 cold 페이지
+
+// 최근에 내보낸 페이지의 VPN 기록 (2Q A1out, ARC B1/B2, CLOCK-Pro 비상주 cold 페이지)
+// slot 배열 + 순서 리스트 + VPN -> slot 맵. head 가 가장 오래된 기록
+typedef struct {
+    VpnMap index;      // vpn -> slot
+    uint64_t *vpn;     // slot -> vpn
+    LRUList order;
+    int *free_slots;
+    int free_count;
+    int capacity;
+} GhostList;
+
+// 스왑(교체 정책) 상태 (SimContext 에 포함)
+typedef struct {
+    int rr_idx;                   // RR Victim Pointer / CLOCK, CLOCK-Pro 의 cold hand
+    uint64_t *frame_last_access;  // [LRU] 각 프레임의 마지막 접근 시간
+    // [LRU] Swappable 프레임을 (last_access, pfn) 순으로 연결한 리스트
+    // head 가 곧 Victim 이므로 swap_out 에서 전체 프레임을 훑지 않아도 됨
+    // 멤버십은 비트마스크의 Swappable 비트와 항상 일치하도록 유지
+    LRUList frame_lru;
+
+    // 근사 / scan-resistant 정책 (CLOCK, CLOCK-Pro, 2Q, ARC)
+    uint8_t *frame_flags;         // FRAME_* 비트
+    int capacity;                 // 데이터 프레임 수 상한 c (= 전체 - 예약 프레임)
+    LRUList queue[2];             // 2Q: A1in / Am, ARC: T1 / T2, CLOCK-Pro: cold / hot clock
+    GhostList ghost[2];           // 2Q: A1out, ARC: B1 / B2, CLOCK-Pro: 비상주 test 페이지
+    int target;                   // ARC: p (T1 목표 크기), CLOCK-Pro: m_c (cold 목표 수)
+    int fault_ghost;              // 처리 중인 Page Fault 의 VPN 이 있던 ghost (0 = 없음, 1 / 2)
+    bool load_prefetch;           // 지금 적재하는 페이지가 prefetch (참조된 적 없는 페이지로 취급)
+
+    // [OPT] 상주 데이터 프레임을 다음 사용 시점으로 정렬한 최대 힙 (top = Victim)
+    IndexHeap opt_heap;
+
+    // 묶음 회수의 Victim 키 (geo.reclaim_batch 칸, init_swap 에서 한 번 할당. 체크포인트 대상 아님)
+    uint64_t *reclaim_keys;
+
+    // Victim 내용을 저장하는 스왑 장치 (Dirty Victim 만 기록)
+    SwapDevice device;
+} SwapState;
+
+// 스왑 모듈 상태 초기화 (init_memory 보다 먼저 호출)
+void init_swap(SimContext *ctx);
+void destroy_swap(SimContext *ctx);
 
 // 메모리가 부족할 때 Victim을 선정하고 스왑 아웃 수행
-int swap_out();
+// Dirty Victim 은 스왑 장치에 기록, Clean Victim 은 기록 없이 버림
+int swap_out(SimContext *ctx);
+
+// Page Fault 로 새로 받은 프레임(0 으로 채워짐)에 key 페이지 내용 적재
+// 스왑 장치에 사본이 있으면 읽고(Swap-in), 없으면 0 으로 둠 (처음 접근하는 페이지)
+void swap_in(SimContext *ctx, uint64_t key, int pfn);
+
+// 스왑 장치에 key 의 사본이 있으면 pfn 에 읽고 true (Swap-in 통계 포함), 없으면 false
+bool swap_read_page(SimContext *ctx, uint64_t key, int pfn);
+
+// 데이터 페이지 Page Fault 시작 시 호출 (프레임 할당 / 스왑 전)
+// ghost 기록이 있는 정책은 여기서 적응 (ARC 의 p, CLOCK-Pro 의 m_c)
+void swap_note_fault(SimContext *ctx, uint64_t vpn);
+
+// 데이터 프레임 접근 (TLB Hit) 시 호출: LRU 는 시간 기록, CLOCK 계열은 참조 비트
+// 반환값: prefetch 로 적재된 페이지의 첫 접근이면 true (prefetch_useful 에 포함)
+bool acknowledge_frame_access(SimContext *ctx, int pfn);
+
+// 프레임의 Swappable 비트가 바뀔 때 memory.c 에서 호출
+// true: 데이터 페이지 적재 (frame_owner 는 이미 설정됨), false: 테이블/예약 프레임으로 사용
+void notify_swappable_change(SimContext *ctx, int pfn, bool swappable);
 
-// [LRU] 프레임 접근 시 시간 기록
-void acknowledge_frame_access(int pfn);
+// 프레임 a 와 b 의 교체 정책 상태를 맞바꿈 (exchange_frames 에서 호출, b 는 빈 프레임일 수 있음)
+// 시간 / 플래그 / 리스트와 큐의 위치 / OPT 힙의 key 가 페이지를 따라가므로 정책에는 옮기기 전과 같은 페이지
+// (ghost 는 VPN 기준이라 그대로, RR / CLOCK 의 hand 는 프레임 위치라 그대로)
+void swap_exchange_frames(SimContext *ctx, int a, int b);
 
-#endif
\ No newline at end of file
+#endif
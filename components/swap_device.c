@@ -0,0 +1,85 @@
+/* swap_device.c */
+#include "swap_device.h"
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+void swapdev_init(SwapDevice *dev, uint64_t page_size) {
+    memset(dev, 0, sizeof(*dev));
+    dev->fd = -1;
+    dev->page_size = page_size;
+    vmap_init(&dev->slot, 1024);
+}
+
+static void close_file(SwapDevice *dev) {
+    if (dev->tmp) fclose(dev->tmp);
+    else if (dev->fd >= 0) close(dev->fd);
+    dev->tmp = NULL;
+    dev->fd = -1;
+}
+
+void swapdev_destroy(SwapDevice *dev) {
+    if (!dev->slot.keys) return; // swapdev_init 전 (0 으로 채운 상태의 fd 0 은 닫지 않음)
+    close_file(dev);
+    vmap_destroy(&dev->slot);
+    memset(dev, 0, sizeof(*dev));
+    dev->fd = -1;
+}
+
+int swapdev_open(SwapDevice *dev, const char *path) {
+    int fd = open(path, O_RDWR | O_CREAT | O_TRUNC, 0600);
+    if (fd < 0) {
+        perror("open swap file");
+        return -1;
+    }
+    // 이전 파일의 slot 은 더 이상 유효하지 않음
+    close_file(dev);
+    vmap_clear(&dev->slot);
+    dev->slots = 0;
+    dev->fd = fd;
+    return 0;
+}
+
+// 파일을 지정하지 않았으면 첫 쓰기 때 익명 임시 파일 (닫으면 삭제됨)
+static void ensure_open(SwapDevice *dev) {
+    if (dev->fd >= 0) return;
+    dev->tmp = tmpfile();
+    if (!dev->tmp) {
+        perror("tmpfile swap");
+        exit(1);
+    }
+    dev->fd = fileno(dev->tmp);
+}
+
+// 페이지 하나를 끝까지 읽고 쓰기 (짧은 I/O 는 이어서, 실패는 치명적 오류)
+static void page_io(SwapDevice *dev, uint64_t slot, uint8_t *page, bool write) {
+    off_t off = (off_t)(slot * dev->page_size);
+    size_t done = 0;
+    while (done < dev->page_size) {
+        ssize_t n = write ? pwrite(dev->fd, page + done, dev->page_size - done, off + done)
+                          : pread(dev->fd, page + done, dev->page_size - done, off + done);
+        if (n <= 0) {
+            perror(write ? "pwrite swap" : "pread swap");
+            exit(1);
+        }
+        done += (size_t)n;
+    }
+}
+
+void swapdev_write(SwapDevice *dev, uint64_t key, const uint8_t *page) {
+    ensure_open(dev);
+    uint64_t slot;
+    if (!vmap_get(&dev->slot, key, &slot)) {
+        slot = dev->slots++;
+        vmap_put(&dev->slot, key, slot);
+    }
+    page_io(dev, slot, (uint8_t *)page, true);
+}
+
+bool swapdev_read(SwapDevice *dev, uint64_t key, uint8_t *page) {
+    uint64_t slot;
+    if (!vmap_get(&dev->slot, key, &slot)) return false;
+    page_io(dev, slot, page, false);
+    return true;
+}
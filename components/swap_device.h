@@ -0,0 +1,35 @@
+/* swap_device.h */
+#ifndef SWAP_DEVICE_H
+#define SWAP_DEVICE_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "vpn_map.h"
+
+// --- 스왑 장치 (로컬 파일) ---
+// 스왑 아웃된 페이지의 실제 내용을 page_size 단위 slot 에 pread / pwrite
+// 페이지 키 PAGE_KEY(pid, vpn) 마다 slot 하나를 처음 쓸 때 할당하고 계속 유지 (swap cache)
+//   -> Swap-in 후 다시 쓰지 않은(Clean) 페이지는 내보낼 때 쓰기 없이 slot 의 사본을 그대로 사용
+// 파일을 지정하지 않으면 첫 쓰기 때 익명 임시 파일(tmpfile)을 만듦
+typedef struct {
+    int fd;               // -1 = 아직 열지 않음
+    FILE *tmp;            // 익명 임시 파일 (fd 의 소유자, 지정 파일이면 NULL)
+    uint64_t page_size;
+    VpnMap slot;          // 페이지 키 -> slot 번호
+    uint64_t slots;       // 할당한 slot 수 (파일 크기 = slots * page_size)
+} SwapDevice;
+
+void swapdev_init(SwapDevice *dev, uint64_t page_size);
+void swapdev_destroy(SwapDevice *dev);
+
+// 스왑 파일 지정 (새로 만들거나 비움). 성공 0, 실패 -1
+int swapdev_open(SwapDevice *dev, const char *path);
+
+// 페이지 내용을 key 의 slot 에 기록
+void swapdev_write(SwapDevice *dev, uint64_t key, const uint8_t *page);
+
+// key 의 slot 이 있으면 page 에 읽고 true, 한 번도 기록된 적 없으면 false (page 는 그대로)
+bool swapdev_read(SwapDevice *dev, uint64_t key, uint8_t *page);
+
+#endif
@@ -0,0 +1,218 @@
+/* sweep.c */
+#include "sweep.h"
+#include "sim.h"
+#include "trace.h"
+#include "geometry.h"
+#include "thread_pool.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+typedef struct {
+    // 입력
+    const char *trace_name;
+    const Trace *trace;
+    const uint32_t *next_use;  // [OPT] 트레이스별로 한 번 만들어 공유 (OPT 가 없으면 NULL)
+    Geometry geo;
+    Policy policy;
+
+    // 결과
+    Stats stats;
+    double elapsed;
+    int failed;
+} SweepJob;
+
+// "a,b,c" -> 토큰 배열 (str 은 strdup 된 사본, 호출자가 free)
+static int split_list(char *str, char ***out) {
+    int n = 0, cap = 8;
+    char **items = malloc(sizeof(char*) * cap);
+    for (char *tok = strtok(str, ","); tok; tok = strtok(NULL, ",")) {
+        if (n == cap) {
+            cap *= 2;
+            items = realloc(items, sizeof(char*) * cap);
+        }
+        items[n++] = tok;
+    }
+    *out = items;
+    return n;
+}
+
+static int parse_counts(const char *list, int fallback, int **out) {
+    if (!list) {
+        *out = malloc(sizeof(int));
+        (*out)[0] = fallback;
+        return 1;
+    }
+    char *copy = strdup(list);
+    char **items;
+    int n = split_list(copy, &items);
+    *out = malloc(sizeof(int) * (n ? n : 1));
+    for (int i = 0; i < n; i++) {
+        char *end;
+        long v = strtol(items[i], &end, 0);
+        if (*end != '\0' || v < 1) {
+            fprintf(stderr, "Sweep: invalid size '%s'\n", items[i]);
+            n = -1;
+            break;
+        }
+        (*out)[i] = (int)v;
+    }
+    free(items);
+    free(copy);
+    return n;
+}
+
+static void run_job(void *arg) {
+    SweepJob *job = arg;
+    SimContext *ctx = malloc(sizeof(SimContext));
+
+    struct timespec t_start, t_end;
+    clock_gettime(CLOCK_MONOTONIC, &t_start);
+
+    sim_init(ctx, &job->geo, job->policy);
+    sim_set_future(ctx, job->next_use, job->trace->count);
+    job->failed = sim_run_trace(ctx, job->trace) != 0;
+    job->stats = ctx->stats;
+    sim_destroy(ctx);
+    free(ctx);
+
+    clock_gettime(CLOCK_MONOTONIC, &t_end);
+    job->elapsed = (t_end.tv_sec - t_start.tv_sec) + (t_end.tv_nsec - t_start.tv_nsec) / 1e9;
+}
+
+static double ratio(uint64_t a, uint64_t b) {
+    return b ? (double)a / b : 0.0;
+}
+
+int run_sweep(const Geometry *base, const SweepSpec *spec, const char *csv_path) {
+    int ret = -1;
+    char *trace_copy = strdup(spec->traces);
+    char *policy_copy = spec->policies ? strdup(spec->policies) : NULL;
+    char **trace_names = NULL, **policy_items = NULL;
+    int *tlb_sizes = NULL, *frame_counts = NULL;
+    Policy *policies = NULL;
+    Trace *traces = NULL;
+    uint32_t **next_use = NULL;
+    SweepJob *jobs = NULL;
+    int num_loaded = 0;
+
+    int num_traces = split_list(trace_copy, &trace_names);
+    int num_policies = POLICY_COUNT;
+    policies = malloc(sizeof(Policy) * POLICY_COUNT);
+    if (policy_copy) {
+        num_policies = split_list(policy_copy, &policy_items);
+        policies = realloc(policies, sizeof(Policy) * (num_policies ? num_policies : 1));
+        for (int i = 0; i < num_policies; i++) {
+            if (policy_parse(policy_items[i], &policies[i]) != 0) {
+                fprintf(stderr, "Sweep: unknown policy '%s'\n", policy_items[i]);
+                goto out;
+            }
+        }
+    } else {
+        for (int i = 0; i < POLICY_COUNT; i++) policies[i] = (Policy)i;
+    }
+    int num_tlb = parse_counts(spec->tlb_sizes, base->tlb_size, &tlb_sizes);
+    int num_frames = parse_counts(spec->frame_counts, base->num_frames, &frame_counts);
+    if (num_traces < 1 || num_policies < 1 || num_tlb < 1 || num_frames < 1) {
+        goto out;
+    }
+
+    // 트레이스는 한 번만 로드 (바이너리는 mmap, 텍스트는 한 번 파싱)
+    traces = calloc(num_traces, sizeof(Trace));
+    for (; num_loaded < num_traces; num_loaded++) {
+        if (trace_load(&traces[num_loaded], trace_names[num_loaded]) != 0) goto out;
+    }
+
+    // [OPT] 다음 사용 인덱스도 트레이스당 한 번 (VPN 분해는 TLB / 프레임 수와 무관)
+    bool use_opt = false;
+    for (int p = 0; p < num_policies; p++) use_opt |= sim_uses_opt(base, policies[p]);
+    next_use = calloc(num_traces, sizeof(uint32_t*));
+    for (int t = 0; use_opt && t < num_traces; t++) {
+        next_use[t] = build_next_use(base, &traces[t]);
+        if (!next_use[t]) goto out;
+    }
+
+    size_t num_jobs = (size_t)num_traces * num_policies * num_tlb * num_frames;
+    jobs = calloc(num_jobs, sizeof(SweepJob));
+    size_t j = 0;
+    for (int t = 0; t < num_traces; t++)
+    for (int p = 0; p < num_policies; p++)
+    for (int s = 0; s < num_tlb; s++)
+    for (int f = 0; f < num_frames; f++, j++) {
+        SweepJob *job = &jobs[j];
+        job->trace_name = trace_names[t];
+        job->trace = &traces[t];
+        job->next_use = next_use[t];
+        job->policy = policies[p];
+        job->geo = *base;
+        job->geo.tlb_size = tlb_sizes[s];
+        job->geo.mem_size = (uint64_t)frame_counts[f] * base->page_size;
+        if (geometry_finalize(&job->geo) != 0) {
+            fprintf(stderr, "Sweep: invalid configuration tlb=%d frames=%d\n",
+                    tlb_sizes[s], frame_counts[f]);
+            goto out;
+        }
+    }
+
+    ThreadPool pool;
+    pool_init(&pool, spec->threads);
+    for (j = 0; j < num_jobs; j++) pool_submit(&pool, run_job, &jobs[j]);
+
+    struct timespec t_start, t_end;
+    clock_gettime(CLOCK_MONOTONIC, &t_start);
+    pool_run(&pool);
+    clock_gettime(CLOCK_MONOTONIC, &t_end);
+    double elapsed = (t_end.tv_sec - t_start.tv_sec) + (t_end.tv_nsec - t_start.tv_nsec) / 1e9;
+
+    size_t stolen = 0;
+    for (int w = 0; w < pool.num_workers; w++) stolen += pool.queues[w].stolen;
+    fprintf(stderr, "[Sweep] %zu runs on %d threads in %.3f s (%zu stolen)\n",
+            num_jobs, pool.num_workers, elapsed, stolen);
+    pool_destroy(&pool);
+
+    FILE *fp = strcmp(csv_path, "stdout") == 0 ? stdout : fopen(csv_path, "w");
+    if (!fp) {
+        perror("fopen sweep csv");
+        goto out;
+    }
+    fprintf(fp, "trace,policy,tlb_size,frames,accesses,tlb_misses,tlb_miss_rate,"
+                "page_faults,page_fault_rate,swap_outs,table_frame_allocs,cycles,amat,completed,elapsed_s\n");
+    // 메모리가 너무 작아 중간에 멈춘 실행은 completed=0 으로 남기고 나머지는 계속
+    size_t failed = 0;
+    for (j = 0; j < num_jobs; j++) {
+        const SweepJob *job = &jobs[j];
+        const Stats *st = &job->stats;
+        failed += job->failed;
+        fprintf(fp, "%s,%s,%d,%d,%llu,%llu,%.6f,%llu,%.6f,%llu,%llu,%llu,%.3f,%d,%.6f\n",
+                job->trace_name, policy_name(job->policy), job->geo.tlb_size, job->geo.num_frames,
+                (unsigned long long)st->accesses,
+                (unsigned long long)st->tlb_misses, ratio(st->tlb_misses, st->accesses),
+                (unsigned long long)st->pt_misses, ratio(st->pt_misses, st->accesses),
+                (unsigned long long)st->swap_outs, (unsigned long long)st->table_frame_allocs,
+                (unsigned long long)stats_total_cycles(st), ratio(stats_total_cycles(st), st->accesses),
+                !job->failed, job->elapsed);
+    }
+    if (fp != stdout) fclose(fp);
+    if (failed) {
+        fprintf(stderr, "[Sweep] %zu runs stopped early (out of swappable frames)\n", failed);
+    }
+    ret = 0;
+
+out:
+    for (int i = 0; i < num_loaded; i++) {
+        trace_close(&traces[i]);
+        if (next_use) free(next_use[i]);
+    }
+    free(next_use);
+    free(traces);
+    free(jobs);
+    free(tlb_sizes);
+    free(frame_counts);
+    free(policies);
+    free(policy_items);
+    free(trace_names);
+    free(policy_copy);
+    free(trace_copy);
+    return ret;
+}
@@ -0,0 +1,21 @@
+/* sweep.h */
+#ifndef SWEEP_H
+#define SWEEP_H
+
+#include "../common.h"
+
+// --- 파라미터 스윕 ---
+// 트레이스 x 정책 x TLB 크기 x 프레임 수 조합을 독립 SimContext 로 병렬 실행
+// 각 트레이스는 한 번만 메모리에 올려서 모든 작업이 읽기 전용으로 공유
+typedef struct {
+    const char *traces;       // 콤마 구분 트레이스 파일 목록
+    const char *policies;     // 콤마 구분 정책 목록 (NULL 이면 전체)
+    const char *tlb_sizes;    // 콤마 구분 TLB 엔트리 수 (NULL 이면 geometry 값)
+    const char *frame_counts; // 콤마 구분 프레임 수 (NULL 이면 geometry 값)
+    int threads;              // 워커 수 (<= 0 이면 CPU 수)
+} SweepSpec;
+
+// 모든 조합을 실행하고 작업 순서대로 한 CSV 에 기록. 성공 0, 실패 -1
+int run_sweep(const Geometry *base, const SweepSpec *spec, const char *csv_path);
+
+#endif
@@ -0,0 +1,126 @@
+/* thread_pool.c */
+#include "thread_pool.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <unistd.h>
+
+typedef struct {
+    ThreadPool *pool;
+    int id;
+} WorkerArg;
+
+void pool_init(ThreadPool *pool, int num_workers) {
+    if (num_workers <= 0) {
+        long n = sysconf(_SC_NPROCESSORS_ONLN);
+        num_workers = n > 0 ? (int)n : 1;
+    }
+    pool->num_workers = num_workers;
+    pool->num_tasks = 0;
+    pool->queues = calloc((size_t)num_workers, sizeof(WorkerQueue));
+    if (!pool->queues) {
+        perror("Failed to allocate thread pool");
+        exit(1);
+    }
+    for (int i = 0; i < num_workers; i++) {
+        pthread_mutex_init(&pool->queues[i].lock, NULL);
+    }
+}
+
+void pool_destroy(ThreadPool *pool) {
+    for (int i = 0; i < pool->num_workers; i++) {
+        pthread_mutex_destroy(&pool->queues[i].lock);
+        free(pool->queues[i].tasks);
+    }
+    free(pool->queues);
+    pool->queues = NULL;
+}
+
+void pool_submit(ThreadPool *pool, TaskFn fn, void *arg) {
+    WorkerQueue *q = &pool->queues[pool->num_tasks % pool->num_workers];
+    if (q->bottom == q->cap) {
+        q->cap = q->cap ? q->cap * 2 : 16;
+        q->tasks = realloc(q->tasks, q->cap * sizeof(Task));
+        if (!q->tasks) {
+            perror("Failed to grow task queue");
+            exit(1);
+        }
+    }
+    q->tasks[q->bottom++] = (Task){ fn, arg };
+    pool->num_tasks++;
+}
+
+// 자기 deque 의 bottom 에서 꺼냄 (LIFO)
+static bool pop_bottom(WorkerQueue *q, Task *out) {
+    bool ok = false;
+    pthread_mutex_lock(&q->lock);
+    if (q->top < q->bottom) {
+        *out = q->tasks[--q->bottom];
+        ok = true;
+    }
+    pthread_mutex_unlock(&q->lock);
+    return ok;
+}
+
+// 다른 워커 deque 의 top 에서 훔침 (FIFO 쪽, 주인과 반대편이라 경합이 적음)
+static bool steal_top(WorkerQueue *q, Task *out) {
+    bool ok = false;
+    pthread_mutex_lock(&q->lock);
+    if (q->top < q->bottom) {
+        *out = q->tasks[q->top++];
+        ok = true;
+    }
+    pthread_mutex_unlock(&q->lock);
+    return ok;
+}
+
+static void* worker_main(void *p) {
+    WorkerArg *wa = p;
+    ThreadPool *pool = wa->pool;
+    WorkerQueue *own = &pool->queues[wa->id];
+    Task task;
+
+    while (1) {
+        if (pop_bottom(own, &task)) {
+            task.fn(task.arg);
+            own->executed++;
+            continue;
+        }
+
+        // 자기 작업이 없으면 이웃부터 차례로 훔치기 시도
+        bool found = false;
+        for (int k = 1; k < pool->num_workers && !found; k++) {
+            WorkerQueue *victim = &pool->queues[(wa->id + k) % pool->num_workers];
+            found = steal_top(victim, &task);
+        }
+        if (!found) break; // 작업이 정적이므로 모든 deque 가 비면 종료
+
+        task.fn(task.arg);
+        own->executed++;
+        own->stolen++;
+    }
+    return NULL;
+}
+
+void pool_run(ThreadPool *pool) {
+    int n = pool->num_workers;
+    pthread_t *threads = malloc(sizeof(pthread_t) * n);
+    WorkerArg *args = malloc(sizeof(WorkerArg) * n);
+    if (!threads || !args) {
+        perror("Failed to start thread pool");
+        exit(1);
+    }
+
+    for (int i = 0; i < n; i++) args[i] = (WorkerArg){ pool, i };
+    for (int i = 1; i < n; i++) {
+        if (pthread_create(&threads[i], NULL, worker_main, &args[i]) != 0) {
+            perror("pthread_create");
+            exit(1);
+        }
+    }
+    worker_main(&args[0]);
+    for (int i = 1; i < n; i++) pthread_join(threads[i], NULL);
+
+    free(threads);
+    free(args);
+}
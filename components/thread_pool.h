@@ -0,0 +1,46 @@
+/* thread_pool.h */
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <stddef.h>
+#include <pthread.h>
+
+// --- Work-Stealing Thread Pool ---
+// 작업 목록을 미리 정해두고(정적) 한 번에 실행하는 용도 (파라미터 스윕)
+// 작업은 워커별 deque 에 round-robin 으로 나눠 담고,
+// 워커는 자기 deque 의 bottom 에서 꺼내다가 비면 다른 워커의 top 에서 훔쳐옴
+// -> 트레이스/크기별로 실행 시간이 크게 달라도 코어가 놀지 않음
+typedef void (*TaskFn)(void *arg);
+
+typedef struct {
+    TaskFn fn;
+    void *arg;
+} Task;
+
+typedef struct {
+    pthread_mutex_t lock;
+    Task *tasks;
+    size_t top;       // 도둑이 가져가는 쪽
+    size_t bottom;    // 주인이 꺼내는 쪽 (top <= i < bottom 이 남은 작업)
+    size_t cap;
+    size_t executed;  // 이 워커가 실행한 작업 수
+    size_t stolen;    // 그 중 다른 워커에게서 훔친 작업 수
+} WorkerQueue;
+
+typedef struct {
+    int num_workers;
+    WorkerQueue *queues;
+    size_t num_tasks;
+} ThreadPool;
+
+// num_workers <= 0 이면 온라인 CPU 수 사용
+void pool_init(ThreadPool *pool, int num_workers);
+void pool_destroy(ThreadPool *pool);
+
+// 실행 전에 작업 추가 (pool_run 도중에는 호출 불가)
+void pool_submit(ThreadPool *pool, TaskFn fn, void *arg);
+
+// 모든 작업이 끝날 때까지 실행 (호출 스레드도 워커 0 으로 참여)
+void pool_run(ThreadPool *pool);
+
+#endif
@@ -0,0 +1,129 @@
+/* tier.c */
+#include "tier.h"
+#include "sim.h"
+#include "page_table.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+void init_tiers(SimContext *ctx) {
+    TierState *t = &ctx->tier;
+    const Geometry *geo = &ctx->geo;
+
+    destroy_tiers(ctx);
+    if (!geo->slow_mem_size) return;
+    t->heat = calloc(geo->num_frames, sizeof(uint32_t));
+    t->order = malloc(sizeof(uint64_t) * geo->num_frames);
+    t->moved = malloc(sizeof(uint64_t) * geo->tier_batch * 2);
+    if (!t->heat || !t->order || !t->moved) {
+        perror("malloc tiers");
+        exit(1);
+    }
+    t->next_epoch = geo->tier_epoch;
+}
+
+void destroy_tiers(SimContext *ctx) {
+    TierState *t = &ctx->tier;
+    free(t->heat);
+    free(t->order);
+    free(t->moved);
+    memset(t, 0, sizeof(*t));
+}
+
+// 데이터 프레임 pfn 을 매핑한 Leaf PTE 위치 (매핑이 그 프레임을 가리키지 않으면 -1)
+static int mapping_of(SimContext *ctx, int pfn, uint64_t *idx) {
+    const Geometry *geo = &ctx->geo;
+    int leaf = geo->levels - 1;
+    uint64_t key = get_frame_owner(ctx, pfn);
+    int table = pt_table_at(ctx, key, leaf, false);
+    if (table == -1) return -1;
+    *idx = KEY_VPN(geo, key) & ((1ULL << geo->level_bits[leaf]) - 1);
+    uint64_t pte = read_pte(ctx, table, *idx);
+    return IS_PTE_PRESENT(geo, pte) && GET_PTE_PFN(geo, pte) == pfn ? table : -1;
+}
+
+// 데이터 페이지 a 와 b (데이터 페이지 또는 빈 프레임) 의 자리를 맞바꿈
+// 내용, Dirty (Leaf PTE 의 비트 또는 프레임별 Dirty), 교체 정책 상태 (exchange_frames), heat, prefetch 표시가 페이지를 따라감
+// 옮긴 키를 moved 에 채우고 그 수 반환 (매핑을 찾지 못한 페이지가 있으면 옮기지 않고 0)
+static int exchange(SimContext *ctx, int a, int b, bool b_used, uint64_t *moved) {
+    const Geometry *geo = &ctx->geo;
+    TierState *t = &ctx->tier;
+    int p[2] = { a, b };
+    int n = b_used ? 2 : 1;
+    uint64_t key[2], idx[2], pte[2];
+    int table[2];
+
+    for (int i = 0; i < n; i++) {
+        table[i] = mapping_of(ctx, p[i], &idx[i]);
+        if (table[i] == -1) return 0;
+        key[i] = get_frame_owner(ctx, p[i]);
+        pte[i] = read_pte(ctx, table[i], idx[i]);
+    }
+    exchange_frames(ctx, a, b);
+    for (int i = 0; i < n; i++) {
+        int dst = p[1 - i];
+        write_pte(ctx, table[i], idx[i], CREATE_PTE(geo, dst) | (pte[i] & geo->pte_dirty_mask));
+        ctx->stats.cycles_migrate += tier_latency(geo, p[i]) + tier_latency(geo, dst);
+    }
+    uint32_t heat = t->heat[a];
+    t->heat[a] = b_used ? t->heat[b] : 0;
+    t->heat[b] = heat;
+    if (ctx->pf.unused) {
+        uint8_t unused = ctx->pf.unused[a];
+        ctx->pf.unused[a] = b_used ? ctx->pf.unused[b] : 0;
+        ctx->pf.unused[b] = unused;
+    }
+    memcpy(moved, key, sizeof(uint64_t) * n);
+    return n;
+}
+
+static int cmp_u64(const void *x, const void *y) {
+    uint64_t a = *(const uint64_t *)x, b = *(const uint64_t *)y;
+    return a < b ? -1 : a > b;
+}
+
+#define ORDER_PFN(v)  ((int)((v) & 0xffffffffu))
+#define ORDER_HEAT(v) ((uint32_t)((v) >> 32))
+
+void tier_migrate(SimContext *ctx) {
+    const Geometry *geo = &ctx->geo;
+    TierState *t = &ctx->tier;
+    t->next_epoch = ctx->time + geo->tier_epoch;
+
+    // 1. 후보: 느린 계층의 뜨거운 페이지 (order 앞쪽), DRAM 의 데이터 페이지 (order 뒤쪽)
+    int hot = 0, cold = 0;
+    for (int pfn = geo->fast_frames; pfn < geo->num_frames; pfn++) {
+        if (t->heat[pfn] >= (uint32_t)geo->tier_hot && is_frame_swappable(ctx, pfn)) {
+            t->order[hot++] = (uint64_t)t->heat[pfn] << 32 | (uint32_t)pfn;
+        }
+    }
+    uint64_t *cold_order = t->order + hot;
+    for (int pfn = geo->root_pfn + 1; pfn < geo->fast_frames && hot; pfn++) {
+        if (is_frame_swappable(ctx, pfn)) cold_order[cold++] = (uint64_t)t->heat[pfn] << 32 | (uint32_t)pfn;
+    }
+    qsort(t->order, hot, sizeof(uint64_t), cmp_u64);
+    qsort(cold_order, cold, sizeof(uint64_t), cmp_u64);
+
+    // 2. 뜨거운 것부터: DRAM 빈 프레임, 없으면 더 차가운 DRAM 페이지와 맞바꿈
+    int moved = 0, c = 0;
+    for (int h = hot - 1; h >= 0 && hot - 1 - h < geo->tier_batch; h--) {
+        int src = ORDER_PFN(t->order[h]);
+        int dst = find_free_frame_in(ctx, geo->root_pfn + 1, geo->fast_frames);
+        int n;
+        if (dst != -1) {
+            n = exchange(ctx, src, dst, false, t->moved + moved);
+        } else {
+            if (c == cold || ORDER_HEAT(cold_order[c]) >= ORDER_HEAT(t->order[h])) break;
+            dst = ORDER_PFN(cold_order[c++]);
+            n = exchange(ctx, src, dst, true, t->moved + moved);
+            if (n) ctx->stats.tier_demotions++;
+        }
+        if (!n) continue;
+        ctx->stats.tier_promotions++;
+        moved += n;
+    }
+    if (moved) tlb_shootdown(ctx, t->moved, moved);
+
+    // 3. 노화
+    for (int pfn = 0; pfn < geo->num_frames; pfn++) t->heat[pfn] >>= 1;
+}
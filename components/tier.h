@@ -0,0 +1,38 @@
+/* tier.h */
+#ifndef TIER_H
+#define TIER_H
+
+#include <stdint.h>
+#include "../common.h"
+
+// --- 2계층 메모리 (geo.slow_mem_size) ---
+// PFN 0 ~ fast_frames-1 이 DRAM, 그 뒤 slow_mem_size 만큼이 느린 계층 (CXL / NVM)
+// 새 페이지는 가장 낮은 빈 프레임에 들어가므로 DRAM 이 차면 느린 계층으로 넘치고, 둘 다 차면 스왑
+// acknowledge_frame_access (TLB Hit 로 끝나는 모든 데이터 접근) 가 프레임별 heat 를 셈
+// tier_epoch 접근마다:
+//   1. 느린 계층에서 heat >= tier_hot 인 페이지를 뜨거운 순서로 최대 tier_batch 개 승격
+//      (DRAM 에 빈 프레임이 있으면 그리로, 없으면 그보다 차가운 DRAM 페이지와 자리를 맞바꿈 = 강등)
+//   2. 모든 heat 를 절반으로 (오래된 접근일수록 덜 반영)
+// 옮긴 페이지는 내용 / Dirty / heat 와 교체 정책 상태 (LRU 시간, 큐 위치, OPT 다음 사용 시점 등) 를 유지
+// (exchange_frames: 정책에는 계층 분할과 무관하게 같은 페이지 집합), 옛 변환은 TLB shootdown
+// 데이터 접근은 프레임 계층의 지연 (lat_mem / lat_slow), 페이지 하나 옮기기 = 원본 + 대상 접근 1회씩
+typedef struct {
+    uint32_t *heat;       // 프레임별 최근 접근 빈도 (느린 계층이 없으면 NULL)
+    uint64_t next_epoch;  // 다음 승격 / 강등 시점 (ctx->time)
+    uint64_t *order;      // 후보 정렬용 (heat << 32 | PFN)
+    uint64_t *moved;      // 이번에 옮긴 페이지 키 (shootdown 한 번에)
+} TierState;
+
+// init_memory 이후 호출
+void init_tiers(SimContext *ctx);
+void destroy_tiers(SimContext *ctx);
+
+// 프레임 접근 1회의 데이터 지연 (단일 계층이면 항상 lat_mem)
+static inline int tier_latency(const Geometry *geo, int pfn) {
+    return pfn < geo->fast_frames ? geo->lat_mem : geo->lat_slow;
+}
+
+// 승격 / 강등 한 번 (접근 시작에서 ctx->time >= next_epoch 일 때 호출)
+void tier_migrate(SimContext *ctx);
+
+#endif
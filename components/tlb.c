@@ -1,91 +1,345 @@
 /* components/tlb.c */
 #include "tlb.h"
 #include "log.h"
+#include "stats.h"
+#include "sim.h"
 #include <stdio.h>
-#include "../common.h" // g_policy, g_time 외부 변수 참조
-
-// 전역 변수 선언
-TLB_Entry tlb[TLB_SIZE];
-int tlb_rr_idx = 0; // RR 교체 포인터
-
-// 1. TLB 초기화
-void init_tlb() {
-    for (int i = 0; i < TLB_SIZE; i++) {
-        tlb[i].valid = false;
-        tlb[i].vpn = 0;
-        tlb[i].pfn = 0;
-        tlb[i].last_access_time = 0; // [LRU] 초기화
-    }
-    tlb_rr_idx = 0;
-}
-
-// 2. TLB 검색 (Lookup)
-int search_tlb(uint16_t vpn) {
-    for (int i = 0; i < TLB_SIZE; i++) {
-        // Valid하고 VPN이 일치하면 Hit!
-        if (tlb[i].valid && tlb[i].vpn == vpn) {
-            log_tlb_hit(vpn, tlb[i].pfn);
-            
-            // [LRU] Hit 발생 시 접근 시간 갱신 (RR일 땐 무시됨)
-            if (g_policy == POLICY_LRU) {
-                tlb[i].last_access_time = g_time;
-            }
-            return tlb[i].pfn;
-        }
-    }
+#include <stdlib.h>
+#include <string.h>
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
+// 태그 TLB_SIMD_LANES 개를 한 번에 비교해서 일치한 lane 의 비트마스크를 반환
+// set 시작은 항상 32-byte 정렬 (init_level 의 aligned_alloc + stride)
+static inline unsigned match_lanes(const uint64_t *tags, uint64_t tag) {
+#if defined(__AVX2__)
+    __m256i key = _mm256_set1_epi64x((long long)tag);
+    __m256i eq = _mm256_cmpeq_epi64(_mm256_load_si256((const __m256i *)tags), key);
+    return (unsigned)_mm256_movemask_pd(_mm256_castsi256_pd(eq));
+#elif defined(__SSE2__)
+    // SSE2 에는 64-bit 비교가 없으므로 32-bit 비교 후 상/하위 결과를 AND
+    __m128i key = _mm_set1_epi64x((long long)tag);
+    __m128i lo = _mm_cmpeq_epi32(_mm_load_si128((const __m128i *)tags), key);
+    __m128i hi = _mm_cmpeq_epi32(_mm_load_si128((const __m128i *)(tags + 2)), key);
+    lo = _mm_and_si128(lo, _mm_shuffle_epi32(lo, _MM_SHUFFLE(2, 3, 0, 1)));
+    hi = _mm_and_si128(hi, _mm_shuffle_epi32(hi, _MM_SHUFFLE(2, 3, 0, 1)));
+    return (unsigned)(_mm_movemask_pd(_mm_castsi128_pd(lo)) |
+                      (_mm_movemask_pd(_mm_castsi128_pd(hi)) << 2));
+#elif defined(__aarch64__)
+    uint64x2_t key = vdupq_n_u64(tag);
+    uint64x2_t lo = vceqq_u64(vld1q_u64(tags), key);
+    uint64x2_t hi = vceqq_u64(vld1q_u64(tags + 2), key);
+    return (unsigned)((vgetq_lane_u64(lo, 0) & 1) | (vgetq_lane_u64(lo, 1) & 2) |
+                      (vgetq_lane_u64(hi, 0) & 4) | (vgetq_lane_u64(hi, 1) & 8));
+#else
+    unsigned m = 0;
+    for (int i = 0; i < TLB_SIMD_LANES; i++) m |= (unsigned)(tags[i] == tag) << i;
+    return m;
+#endif
+}
 
-    log_tlb_miss(vpn);
+// set 안에서 tag 와 일치하는 가장 낮은 way (없으면 -1)
+static inline int match_way(const TLBLevel *lv, const uint64_t *tags, uint64_t tag) {
+    for (int w = 0; w < lv->stride; w += TLB_SIMD_LANES) {
+        unsigned m = match_lanes(tags + w, tag);
+        if (m) return w + __builtin_ctz(m);
+    }
     return -1;
 }
 
-// 3. TLB 업데이트 (Replacement)
-void update_tlb(uint16_t vpn, uint16_t pfn) {
-    int target_idx = -1;
+static inline uint64_t* set_tags(const TLBLevel *lv, int set) {
+    return lv->tag + (size_t)set * lv->stride;
+}
+
+// 접근 기록: [LRU] 시간 갱신 + 리스트 위치 이동, [OPT] 다음 사용 시점 갱신 (RR 은 없음)
+static inline void touch_way(SimContext *ctx, TLBState *t, TLBLevel *lv, int set, int way) {
+    if (lv->policy == POLICY_LRU) {
+        uint64_t *time = lv->time + (size_t)set * lv->stride;
+        time[way] = t->clock;
+        lru_insert_sorted(&lv->lru[set], way, time);
+    } else if (lv->policy == POLICY_OPT) {
+        heap_update(&lv->heap[set], way, sim_next_use(ctx));
+    }
+}
+
+static void init_level(TLBLevel *lv, int size, int ways, Policy policy) {
+    lv->ways = ways ? ways : size;
+    lv->sets = size / lv->ways;
+    lv->stride = (lv->ways + TLB_SIMD_LANES - 1) / TLB_SIMD_LANES * TLB_SIMD_LANES;
+    lv->set_mask = (uint64_t)lv->sets - 1;
+    lv->policy = policy;
 
-    // A. 빈 공간이 있는지 먼저 확인
-    for (int i = 0; i < TLB_SIZE; i++) {
-        if (!tlb[i].valid) {
-            target_idx = i;
-            break;
+    size_t slots = (size_t)lv->sets * lv->stride;
+    lv->tag = aligned_alloc(TLB_SIMD_LANES * sizeof(uint64_t), slots * sizeof(uint64_t));
+    lv->pfn = calloc(slots, sizeof(uint32_t));
+    lv->time = calloc(slots, sizeof(uint64_t));
+    lv->rr_idx = calloc(lv->sets, sizeof(int));
+    lv->lru = calloc(lv->sets, sizeof(LRUList));
+    lv->heap = policy == POLICY_OPT ? calloc(lv->sets, sizeof(IndexHeap)) : NULL;
+    if (!lv->tag || !lv->pfn || !lv->time || !lv->rr_idx || !lv->lru ||
+        (policy == POLICY_OPT && !lv->heap)) {
+        perror("malloc tlb");
+        exit(1);
+    }
+
+    for (int s = 0; s < lv->sets; s++) {
+        uint64_t *tags = set_tags(lv, s);
+        for (int w = 0; w < lv->stride; w++) {
+            tags[w] = w < lv->ways ? TLB_TAG_INVALID : TLB_TAG_PAD;
         }
+        lru_init(&lv->lru[s], lv->ways);
+        if (lv->heap) heap_init(&lv->heap[s], lv->ways);
+    }
+}
+
+static void destroy_level(TLBLevel *lv) {
+    if (lv->lru) {
+        for (int s = 0; s < lv->sets; s++) lru_destroy(&lv->lru[s]);
+    }
+    if (lv->heap) {
+        for (int s = 0; s < lv->sets; s++) heap_destroy(&lv->heap[s]);
     }
+    free(lv->tag);
+    free(lv->pfn);
+    free(lv->time);
+    free(lv->rr_idx);
+    free(lv->lru);
+    free(lv->heap);
+}
+
+// way 비우기 (교체 정책의 리스트 / 힙에서도 제거)
+static void drop_way(TLBLevel *lv, int set, int way) {
+    set_tags(lv, set)[way] = TLB_TAG_INVALID;
+    lru_remove(&lv->lru[set], way);
+    if (lv->heap) heap_remove(&lv->heap[set], way);
+}
+
+// 한 단계에 (tag, pfn) 삽입: 빈 way 가 있으면 가장 낮은 way, 없으면 정책에 따라 Victim
+static void fill_level(SimContext *ctx, TLBState *t, TLBLevel *lv, uint64_t tag, int pfn) {
+    int set = (int)(tag & lv->set_mask);
+    uint64_t *tags = set_tags(lv, set);
+
+    // A. 빈 공간이 있는지 먼저 확인 (가장 낮은 way)
+    int way = match_way(lv, tags, TLB_TAG_INVALID);
 
     // B. 빈 공간이 없다면 교체 정책에 따라 Victim 선정
-    if (target_idx == -1) {
-        if (g_policy == POLICY_RR) {
+    if (way == -1) {
+        t->evictions[lv->policy]++;
+
+        if (lv->policy == POLICY_LRU) {
+            // [LRU] last_access_time이 가장 작은 way = 리스트 head (O(1))
+            way = lru_head(&lv->lru[set]);
+        } else if (lv->policy == POLICY_OPT) {
+            // [OPT] 다음 사용이 가장 늦은 way = 힙 top (O(log ways))
+            way = heap_top(&lv->heap[set]);
+        } else {
             // Round-Robin 방식
-            target_idx = tlb_rr_idx;
-            tlb_rr_idx = (tlb_rr_idx + 1) % TLB_SIZE;
-        } 
-        else if (g_policy == POLICY_LRU) {
-            // [LRU] last_access_time이 가장 작은 엔트리 찾기
-            uint64_t min_time = UINT64_MAX;
-            for (int i = 0; i < TLB_SIZE; i++) {
-                if (tlb[i].last_access_time < min_time) {
-                    min_time = tlb[i].last_access_time;
-                    target_idx = i;
-                }
-            }
+            way = lv->rr_idx[set];
+            lv->rr_idx[set] = (way + 1) % lv->ways;
         }
     }
 
     // C. 엔트리 업데이트
-    tlb[target_idx].vpn = vpn;
-    tlb[target_idx].pfn = pfn;
-    tlb[target_idx].valid = true;
-    
+    tags[way] = tag;
+    lv->pfn[(size_t)set * lv->stride + way] = (uint32_t)pfn;
+
     // [LRU] 새로운 엔트리가 들어왔으므로 현재 시간으로 갱신
-    if (g_policy == POLICY_LRU) {
-        tlb[target_idx].last_access_time = g_time;
+    touch_way(ctx, t, lv, set, way);
+}
+
+// 1. TLB 초기화 (ctx->cores 를 만든 뒤, 코어마다 같은 구성)
+void init_tlb(SimContext *ctx) {
+    const Geometry *geo = &ctx->geo;
+
+    destroy_tlb(ctx);
+    for (int c = 0; c < ctx->num_cores; c++) {
+        TLBState *t = &ctx->cores[c].tlb;
+        t->levels = geo->l2_tlb_size ? 2 : 1;
+        for (int l = 0; l < t->levels; l++) {
+            int size = l == 0 ? geo->tlb_size : geo->l2_tlb_size;
+            int ways = l == 0 ? geo->tlb_ways : geo->l2_tlb_ways;
+            Policy policy = geo->tlb_policy[l] >= 0 ? (Policy)geo->tlb_policy[l] : ctx->policy;
+            // 프레임 전용 정책(CLOCK, 2Q 등)에서는 TLB 를 LRU 로 (하드웨어의 pseudo-LRU 에 해당)
+            if (policy != POLICY_RR && policy != POLICY_OPT) policy = POLICY_LRU;
+            init_level(&t->level[l], size, ways, policy);
+        }
+        t->last_hit_level = -1;
+        t->sp_bits = geo->superpage ? geo->sp_bits : 0;
+        // 다중 코어에서는 병렬 단계에서도 안전하도록 코어 로컬에 세고 직렬 단계에서 합침
+        t->evictions = ctx->num_cores > 1 ? ctx->cores[c].tlb_evictions : ctx->stats.tlb_evictions;
+    }
+    ctx->tlb = &ctx->cores[ctx->core].tlb;
+}
+
+void destroy_tlb(SimContext *ctx) {
+    for (int c = 0; c < ctx->num_cores; c++) {
+        TLBState *t = &ctx->cores[c].tlb;
+        for (int l = 0; l < t->levels; l++) destroy_level(&t->level[l]);
+        memset(t, 0, sizeof(*t));
+    }
+}
+
+// 2. TLB 검색 (Lookup): L1 -> L2 순서, L2 Hit 이면 L1 으로 채움
+// 로그에는 pid 를 뺀 VPN 만 기록 (단일 프로세스 로그와 동일)
+int search_tlb(SimContext *ctx, uint64_t key) {
+    return tlb_lookup(ctx, ctx->tlb, key);
+}
+
+static inline uint64_t huge_tag(const TLBState *t, uint64_t key) {
+    return (key >> t->sp_bits) | TLB_TAG_HUGE;
+}
+
+int tlb_lookup(SimContext *ctx, TLBState *t, uint64_t key) {
+    for (int l = 0; l < t->levels; l++) {
+        TLBLevel *lv = &t->level[l];
+        uint64_t tag = key;
+        int set = (int)(tag & lv->set_mask);
+        int way = match_way(lv, set_tags(lv, set), tag);
+        if (way == -1 && t->sp_bits) {
+            // 기본 페이지 엔트리가 없으면 key 를 덮는 Superpage 엔트리
+            tag = huge_tag(t, key);
+            set = (int)(tag & lv->set_mask);
+            way = match_way(lv, set_tags(lv, set), tag);
+        }
+        if (way == -1) continue;
+
+        int entry_pfn = (int)lv->pfn[(size_t)set * lv->stride + way];
+        bool huge = tag != key;
+        int pfn = huge ? entry_pfn + (int)(key & ((1ULL << t->sp_bits) - 1)) : entry_pfn;
+        log_tlb_hit(&ctx->log, KEY_VPN(&ctx->geo, key), pfn);
+
+        // [LRU] Hit 발생 시 접근 시간 갱신 (RR일 땐 무시됨)
+        touch_way(ctx, t, lv, set, way);
+        for (int upper = l - 1; upper >= 0; upper--) {
+            fill_level(ctx, t, &t->level[upper], tag, entry_pfn);
+        }
+        t->last_hit_level = l;
+        t->last_hit_huge = huge;
+        return pfn;
+    }
+
+    t->last_hit_level = -1;
+    log_tlb_miss(&ctx->log, KEY_VPN(&ctx->geo, key));
+    return -1;
+}
+
+// 3. TLB 업데이트 (Replacement): Page Walk 결과를 모든 단계에 채움
+void update_tlb(SimContext *ctx, uint64_t key, int pfn) {
+    TLBState *t = ctx->tlb;
+    for (int l = 0; l < t->levels; l++) {
+        fill_level(ctx, t, &t->level[l], key, pfn);
     }
+    log_tlb_update(&ctx->log, KEY_VPN(&ctx->geo, key), pfn);
+}
 
-    log_tlb_update(vpn, pfn);
+void update_tlb_huge(SimContext *ctx, uint64_t key, int huge_pfn) {
+    TLBState *t = ctx->tlb;
+    uint64_t tag = huge_tag(t, key);
+    for (int l = 0; l < t->levels; l++) {
+        fill_level(ctx, t, &t->level[l], tag, huge_pfn);
+    }
+    log_tlb_update(&ctx->log, KEY_VPN(&ctx->geo, key), huge_pfn + (int)(key & ((1ULL << t->sp_bits) - 1)));
 }
 
-void invalidate_tlb_by_vpn(uint16_t vpn) {
-    for (int i = 0; i < TLB_SIZE; i++) {
-        if (tlb[i].valid && tlb[i].vpn == vpn) {
-            tlb[i].valid = false;
+// 반환값: 엔트리가 있었던 단계 수
+static int invalidate_tag(TLBState *t, uint64_t tag) {
+    int dropped = 0;
+    for (int l = 0; l < t->levels; l++) {
+        TLBLevel *lv = &t->level[l];
+        int set = (int)(tag & lv->set_mask);
+        int way = match_way(lv, set_tags(lv, set), tag);
+        if (way != -1) {
+            drop_way(lv, set, way);
+            dropped++;
         }
     }
-}
\ No newline at end of file
+    return dropped;
+}
+
+// key 의 기본 페이지 엔트리와 key 를 덮는 Superpage 엔트리
+static int invalidate_key(TLBState *t, uint64_t key) {
+    int dropped = invalidate_tag(t, key);
+    if (t->sp_bits) dropped += invalidate_tag(t, huge_tag(t, key));
+    return dropped;
+}
+
+// 태그의 pid (Superpage 태그는 영역 번호에서)
+static inline int tag_pid(const Geometry *geo, uint64_t tag) {
+    if (tag & TLB_TAG_HUGE) return (int)((tag & ~TLB_TAG_HUGE) >> (geo->vpn_bits - geo->sp_bits));
+    return KEY_PID(geo, tag);
+}
+
+void invalidate_tlb_by_vpn(SimContext *ctx, uint64_t key) {
+    invalidate_key(ctx->tlb, key);
+}
+
+// pid < 0 이면 전체
+static uint64_t flush_entries(const Geometry *geo, TLBState *t, int pid) {
+    uint64_t dropped = 0;
+    for (int l = 0; l < t->levels; l++) {
+        TLBLevel *lv = &t->level[l];
+        for (int s = 0; s < lv->sets; s++) {
+            const uint64_t *tags = set_tags(lv, s);
+            for (int w = 0; w < lv->ways; w++) {
+                if (tags[w] == TLB_TAG_INVALID) continue;
+                if (pid >= 0 && tag_pid(geo, tags[w]) != pid) continue;
+                drop_way(lv, s, w);
+                dropped++;
+            }
+            if (pid < 0) lv->rr_idx[s] = 0;
+        }
+    }
+    return dropped;
+}
+
+uint64_t flush_tlb(SimContext *ctx) {
+    return flush_entries(&ctx->geo, ctx->tlb, -1);
+}
+
+uint64_t flush_tlb_pid(SimContext *ctx, TLBState *t, int pid) {
+    return flush_entries(&ctx->geo, t, pid);
+}
+
+// [Shootdown] 현재 코어는 로컬 invalidate (IPI 없음)
+// SYNC: 다른 모든 코어에 IPI 1회씩 (묶음 전체를 한 메시지로)
+// LAZY: 그 pid 를 실행 중인 코어에만 IPI. 예전에 실행했던 코어(cpumask)는 stale 표시만 하고
+//       다음에 그 pid 로 문맥 교환할 때 pid 의 엔트리를 모두 버림 (process_switch)
+void tlb_shootdown(SimContext *ctx, const uint64_t *keys, int n) {
+    const Geometry *geo = &ctx->geo;
+    for (int i = 0; i < n; i++) invalidate_key(ctx->tlb, keys[i]);
+    if (ctx->num_cores == 1 || n == 0) return;
+
+    ProcessTable *pt = &ctx->proc;
+    bool sent = false;
+    for (int c = 0; c < ctx->num_cores; c++) {
+        if (c == ctx->core) continue;
+        Core *core = &ctx->cores[c];
+        uint64_t bit = 1ULL << c;
+        bool ipi = geo->shootdown == SHOOTDOWN_SYNC;
+
+        for (int i = 0; i < n; i++) {
+            int pid = KEY_PID(geo, keys[i]);
+            if (geo->shootdown == SHOOTDOWN_LAZY) {
+                if (!(pt->cpumask[pid] & bit)) continue;  // 이 코어의 TLB 에는 pid 엔트리가 없음
+                if (core->pid != pid) {
+                    pt->stale_mask[pid] |= bit;
+                    continue;
+                }
+                ipi = true;
+            }
+            if (invalidate_key(&core->tlb, keys[i])) {
+                ctx->stats.remote_invalidations++;
+                core->stats.remote_invalidations++;
+            }
+        }
+        if (ipi) {
+            ctx->stats.shootdown_ipis++;
+            core->stats.shootdown_ipis++;
+            sent = true;
+        }
+    }
+    if (sent) ctx->stats.shootdowns++;
+}
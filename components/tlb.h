@@ -3,22 +3,71 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include "../common.h"
+#include "lru_list.h"
+#include "index_heap.h"
 
-// TLB 엔트리 구조체
+// --- TLB 계층 (L1 / 선택적 L2) ---
+// 각 단계는 set-associative (set 1개 = fully associative, 기본값)
+// 엔트리는 struct-of-arrays: 태그(VPN) 배열만 따로 두어 한 set 의 태그를
+// SIMD 비교 몇 번으로 검사 (valid 비트 대신 빈 way 는 TLB_TAG_INVALID 태그)
+// 태그는 페이지 키 PAGE_KEY(pid, vpn) = ASID 태그 TLB (set 은 키 하위 비트 = VPN 하위 비트)
+// Superpage 엔트리는 같은 배열에 섞여 들어감: 태그 = (키 >> sp_bits) | TLB_TAG_HUGE, pfn = 블록 첫 프레임
+// 조회는 기본 페이지 태그 다음 Superpage 태그 순서 (크기별로 set 을 한 번씩)
+#define TLB_TAG_INVALID UINT64_MAX        // 빈 way (페이지 키는 최대 62비트라 겹치지 않음)
+#define TLB_TAG_PAD     (UINT64_MAX - 1)  // SIMD 폭 맞춤용 패딩 way (절대 일치하지 않음)
+#define TLB_TAG_HUGE    (1ULL << 62)      // Superpage 엔트리 표시
+#define TLB_SIMD_LANES  4                 // 비교 한 번에 검사하는 태그 수 (256-bit)
+
+typedef struct {
+    int sets;
+    int ways;
+    int stride;                 // set 당 슬롯 수 (ways 를 TLB_SIMD_LANES 배수로 올림)
+    uint64_t set_mask;          // set = vpn & set_mask
+    Policy policy;
+
+    uint64_t *tag;              // [sets * stride] 페이지 키 태그 (32-byte 정렬)
+    uint32_t *pfn;              // [sets * stride]
+    uint64_t *time;             // [LRU] 마지막 접근 시간 (lru_insert_sorted 의 key)
+    int *rr_idx;                // set 별 RR 교체 포인터
+    LRUList *lru;               // [LRU] set 별 리스트 (way 인덱스, head = Victim)
+    IndexHeap *heap;            // [OPT] set 별 다음 사용 시점 최대 힙 (top = Victim)
+} TLBLevel;
+
+// 코어 하나의 TLB 상태 (크기/연관도/정책은 geo 에서)
+// 코어마다 하나씩 (Core.tlb), ctx->tlb 는 지금 선택된 코어의 것
 typedef struct {
-    uint16_t vpn;           // VPN (상위 9비트)
-    uint16_t pfn;           // PFN (하위 7비트)
-    bool valid;             // 유효 비트
-    uint64_t last_access_time; // [LRU] 마지막 접근 시간
-} TLB_Entry;
-
-// TLB 관련 상수
-#define TLB_SIZE 16
-
-// 함수 프로토타입
-void init_tlb();
-int search_tlb(uint16_t vpn);
-void update_tlb(uint16_t vpn, uint16_t pfn);
-void invalidate_tlb_by_vpn(uint16_t vpn);
-
-#endif
\ No newline at end of file
+    int levels;                 // 1 또는 2
+    TLBLevel level[TLB_LEVELS];
+    int last_hit_level;         // 직전 search_tlb 결과 (0 = L1, 1 = L2, -1 = Miss)
+    bool last_hit_huge;         // 직전 Hit 이 Superpage 엔트리였는지
+    int sp_bits;                // Superpage 엔트리가 덮는 VPN 비트 수 (0 = 기본 페이지만)
+    uint64_t clock;             // [LRU] 이 TLB 가 본 접근 수 (단일 코어에서는 ctx->time 과 같음)
+    uint64_t *evictions;        // 정책별 교체 횟수를 더할 곳 (단일 코어: ctx->stats, 다중 코어: 코어 로컬)
+} TLBState;
+
+// 함수 프로토타입 (init / destroy 는 ctx->cores 전체)
+void init_tlb(SimContext *ctx);
+void destroy_tlb(SimContext *ctx);
+int search_tlb(SimContext *ctx, uint64_t key);
+void update_tlb(SimContext *ctx, uint64_t key, int pfn);
+
+// Superpage 매핑의 Page Walk 결과: key 가 속한 영역 전체를 엔트리 하나로 (huge_pfn = 블록 첫 프레임)
+void update_tlb_huge(SimContext *ctx, uint64_t key, int huge_pfn);
+void invalidate_tlb_by_vpn(SimContext *ctx, uint64_t key);
+
+// 특정 코어의 TLB 조회 (다중 코어의 병렬 단계: 다른 코어 / 공유 상태는 건드리지 않음)
+int tlb_lookup(SimContext *ctx, TLBState *t, uint64_t key);
+
+// 모든 단계의 엔트리를 비움 (ASID 없는 TLB 의 문맥 교환). 반환값: 버린 유효 엔트리 수
+uint64_t flush_tlb(SimContext *ctx);
+
+// pid 의 엔트리만 비움 (lazy shootdown 의 지연된 flush). 반환값: 버린 유효 엔트리 수
+uint64_t flush_tlb_pid(SimContext *ctx, TLBState *t, int pid);
+
+// 스왑 아웃된 페이지들의 변환 제거: 현재 코어는 바로, 다른 코어는 geo.shootdown 방식의 IPI
+// 키를 덮는 Superpage 엔트리도 함께 제거 (INVLPG 와 같음)
+// keys 한 묶음이 shootdown 1회 (reclaim_batch)
+void tlb_shootdown(SimContext *ctx, const uint64_t *keys, int n);
+
+#endif
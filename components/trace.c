@@ -0,0 +1,414 @@
+/* trace.c */
+#include "trace.h"
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+// [Binary] mmap 으로 파일 전체를 매핑하고 헤더 검증
+static int open_binary(Trace *t, int fd, size_t file_len) {
+    if (file_len < sizeof(TraceHeader)) {
+        fprintf(stderr, "Invalid binary trace: file too small.\n");
+        return -1;
+    }
+
+    void *map = mmap(NULL, file_len, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (map == MAP_FAILED) {
+        perror("mmap trace");
+        return -1;
+    }
+    // 순차 접근이므로 커널 readahead 힌트
+    madvise(map, file_len, MADV_SEQUENTIAL);
+
+    TraceHeader hdr;
+    memcpy(&hdr, map, sizeof(hdr));
+
+    uint8_t w = hdr.addr_bytes;
+    if (hdr.version != TRACE_VERSION || !(w == 1 || w == 2 || w == 4 || w == 8)) {
+        fprintf(stderr, "Invalid binary trace header (version %u, addr_bytes %u).\n",
+                hdr.version, w);
+        munmap(map, file_len);
+        return -1;
+    }
+    if ((file_len - sizeof(TraceHeader)) / w < hdr.count) {
+        fprintf(stderr, "Invalid binary trace: truncated (%llu records expected).\n",
+                (unsigned long long)hdr.count);
+        munmap(map, file_len);
+        return -1;
+    }
+
+    // pid 배열은 레코드 영역 끝을 2-byte 로 올린 위치부터
+    if (hdr.flags & TRACE_FLAG_PID) {
+        uint64_t pid_off = sizeof(TraceHeader) + (hdr.count * w + 1) / 2 * 2;
+        if (pid_off > file_len || (file_len - pid_off) / sizeof(uint16_t) < hdr.count) {
+            fprintf(stderr, "Invalid binary trace: truncated pid array.\n");
+            munmap(map, file_len);
+            return -1;
+        }
+        t->pids = (const uint16_t *)((const uint8_t *)map + pid_off);
+    }
+
+    // 쓰기 비트맵은 pid 배열(없으면 2-byte 로 올린 레코드 영역) 바로 뒤
+    if (hdr.flags & TRACE_FLAG_WRITE) {
+        uint64_t write_off = sizeof(TraceHeader) + (hdr.count * w + 1) / 2 * 2;
+        if (hdr.flags & TRACE_FLAG_PID) write_off += hdr.count * sizeof(uint16_t);
+        if (write_off > file_len || file_len - write_off < (hdr.count + 7) / 8) {
+            fprintf(stderr, "Invalid binary trace: truncated write bitmap.\n");
+            munmap(map, file_len);
+            return -1;
+        }
+        t->writes = (const uint8_t *)map + write_off;
+    }
+
+    t->format = TRACE_BINARY;
+    t->map = map;
+    t->map_len = file_len;
+    t->records = (const uint8_t *)map + sizeof(TraceHeader);
+    t->addr_bytes = w;
+    t->count = hdr.count;
+    return 0;
+}
+
+// [Text] 주소 하나 읽기. "@pid" 표시는 건너뛰며 t->pid 만 바꾸고, "pid:addr" 는 둘 다 설정
+// 주소 앞의 "W:" / "R:" 는 t->write. 기존 트레이스(주소만 있음)는 pid 0, 읽기 그대로
+static bool read_text_record(Trace *t, uint64_t *va) {
+    char tok[64];
+    while (fscanf(t->fp, "%63s", tok) == 1) {
+        char *end;
+        char *addr = tok;
+        if (tok[0] == '@') {
+            unsigned long pid = strtoul(tok + 1, &end, 10);
+            if (end == tok + 1 || *end || pid > TRACE_MAX_PID) return false;
+            t->pid = (uint16_t)pid;
+            continue;
+        }
+        // ':' 앞의 필드는 접근 종류 (R / W) 또는 pid
+        t->write = false;
+        char *colon;
+        while ((colon = strchr(addr, ':'))) {
+            *colon = '\0';
+            if (strcasecmp(addr, "W") == 0 || strcasecmp(addr, "R") == 0) {
+                t->write = (addr[0] | 0x20) == 'w';
+            } else {
+                unsigned long pid = strtoul(addr, &end, 10);
+                if (end == addr || *end || pid > TRACE_MAX_PID) return false;
+                t->pid = (uint16_t)pid;
+            }
+            addr = colon + 1;
+        }
+        *va = strtoull(addr, &end, 16);
+        return end != addr && *end == '\0';
+    }
+    return false;
+}
+
+// [Text] 기존 포맷 (Fallback)
+static int open_text(Trace *t, const char *path) {
+    t->fp = fopen(path, "r");
+    if (!t->fp) {
+        perror("Failed to open input file");
+        return -1;
+    }
+
+    int total_accesses = 0;
+    // 첫 줄: 총 접근 횟수 읽기
+    if (fscanf(t->fp, "%d", &total_accesses) != 1) {
+        fprintf(stderr, "Invalid input file format.\n");
+        fclose(t->fp);
+        t->fp = NULL;
+        return -1;
+    }
+
+    t->format = TRACE_TEXT;
+    t->count = (uint64_t)total_accesses;
+    return 0;
+}
+
+// [Stream] 파이프 / 표준 입력: 헤더만 읽고 레코드는 trace_next 가 TRACE_STREAM_CHUNK 개씩
+// pid 배열 / 쓰기 비트맵은 모든 레코드 뒤에 있어서 순서대로 읽으면서는 쓸 수 없음
+static int open_stream(Trace *t, int fd, bool is_stdin) {
+    FILE *fp = is_stdin ? stdin : fdopen(fd, "rb");
+    if (!fp) {
+        perror("fdopen trace");
+        close(fd);
+        return -1;
+    }
+    t->fp = fp;
+
+    TraceHeader hdr;
+    if (fread(&hdr, sizeof(hdr), 1, fp) != 1 || memcmp(hdr.magic, TRACE_MAGIC, sizeof(hdr.magic)) != 0) {
+        fprintf(stderr, "Only binary traces can be read from a pipe or standard input.\n");
+        return -1;
+    }
+    uint8_t w = hdr.addr_bytes;
+    if (hdr.version != TRACE_VERSION || !(w == 1 || w == 2 || w == 4 || w == 8)) {
+        fprintf(stderr, "Invalid binary trace header (version %u, addr_bytes %u).\n",
+                hdr.version, w);
+        return -1;
+    }
+    if (hdr.flags & (TRACE_FLAG_PID | TRACE_FLAG_WRITE)) {
+        fprintf(stderr, "Binary traces with pid or write arrays cannot be streamed; use a file.\n");
+        return -1;
+    }
+
+    t->buf = malloc(TRACE_STREAM_CHUNK * sizeof(uint64_t));
+    t->raw = malloc(TRACE_STREAM_CHUNK * (size_t)w);
+    if (!t->buf || !t->raw) {
+        fprintf(stderr, "Out of memory for the trace stream buffer.\n");
+        return -1;
+    }
+    t->format = TRACE_STREAM;
+    t->addr_bytes = w;
+    t->count = hdr.count;
+    return 0;
+}
+
+// [Synth] "gen:" 뒤의 spec 으로 생성기 준비
+static int open_synth(Trace *t, const char *spec) {
+    t->gen = malloc(sizeof(Workload));
+    if (!t->gen || workload_init(t->gen, spec) != 0) {
+        free(t->gen);
+        t->gen = NULL;
+        return -1;
+    }
+    t->buf = malloc(TRACE_STREAM_CHUNK * sizeof(uint64_t));
+    if (!t->buf) {
+        fprintf(stderr, "Out of memory for the trace stream buffer.\n");
+        return -1;
+    }
+    t->format = TRACE_SYNTH;
+    t->addr_bytes = sizeof(uint64_t);
+    t->count = t->gen->count;
+    return 0;
+}
+
+// [Stream / Synth] 다음 묶음 채우기. 더 없으면 false
+static bool refill(Trace *t) {
+    uint64_t want = t->count - t->fetched;
+    if (want > TRACE_STREAM_CHUNK) want = TRACE_STREAM_CHUNK;
+    if (want == 0) return false;
+
+    size_t got;
+    if (t->gen) {
+        got = workload_fill(t->gen, t->buf, (size_t)want);
+    } else {
+        // little-endian 호스트 가정: 하위 addr_bytes 바이트를 그대로
+        got = fread(t->raw, t->addr_bytes, (size_t)want, t->fp);
+        for (size_t i = 0; i < got; i++) {
+            uint64_t v = 0;
+            memcpy(&v, t->raw + i * t->addr_bytes, t->addr_bytes);
+            t->buf[i] = v;
+        }
+        if (got < want) {
+            fprintf(stderr, "Binary trace stream ended after %llu of %llu records.\n",
+                    (unsigned long long)(t->fetched + got), (unsigned long long)t->count);
+        }
+    }
+    t->fetched += got;
+    t->buf_len = got;
+    t->buf_pos = 0;
+    return got > 0;
+}
+
+// 텍스트 파일 / 파이프 / 생성기 해제 (trace_load 가 다 읽은 뒤에도 사용)
+static void close_source(Trace *t) {
+    if (t->fp && t->fp != stdin) fclose(t->fp);
+    t->fp = NULL;
+    if (t->gen) workload_destroy(t->gen);
+    free(t->gen);
+    t->gen = NULL;
+    free(t->buf);
+    t->buf = NULL;
+    free(t->raw);
+    t->raw = NULL;
+}
+
+int trace_open(Trace *t, const char *path) {
+    memset(t, 0, sizeof(*t));
+
+    size_t prefix = strlen(TRACE_GEN_PREFIX);
+    if (strncmp(path, TRACE_GEN_PREFIX, prefix) == 0) {
+        int ret = open_synth(t, path + prefix);
+        if (ret != 0) close_source(t);
+        return ret;
+    }
+
+    bool is_stdin = strcmp(path, "-") == 0;
+    int fd = is_stdin ? STDIN_FILENO : open(path, O_RDONLY);
+    if (fd < 0) {
+        perror("Failed to open input file");
+        return -1;
+    }
+
+    struct stat st;
+    if (is_stdin || (fstat(fd, &st) == 0 && !S_ISREG(st.st_mode))) {
+        int ret = open_stream(t, fd, is_stdin);
+        if (ret != 0) close_source(t);
+        return ret;
+    }
+
+    char magic[4] = {0};
+    bool is_binary = fstat(fd, &st) == 0 && st.st_size >= (off_t)sizeof(magic) &&
+                     read(fd, magic, sizeof(magic)) == sizeof(magic) &&
+                     memcmp(magic, TRACE_MAGIC, sizeof(magic)) == 0;
+
+    int ret;
+    if (is_binary) {
+        ret = open_binary(t, fd, (size_t)st.st_size);
+    } else {
+        ret = open_text(t, path);
+    }
+    close(fd); // mmap 은 fd 를 닫아도 유지됨
+    return ret;
+}
+
+int trace_load(Trace *t, const char *path) {
+    if (trace_open(t, path) != 0) return -1;
+    if (t->records) return 0; // 바이너리는 이미 mmap 되어 있음
+
+    // pid 배열은 0 이 아닌 pid 가 처음 나올 때 만듦 (단일 프로세스 트레이스는 NULL 유지)
+    uint64_t cap = t->count > 0 ? t->count : 1024;
+    uint64_t n = 0;
+    uint64_t *vas = malloc(cap * sizeof(uint64_t));
+    uint16_t *pids = NULL;
+    uint8_t *writes = NULL;
+    uint64_t va;
+    bool oom = !vas;
+    while (!oom && trace_next(t, &va)) {
+        if (n == cap) {
+            cap *= 2;
+            uint64_t *grown = realloc(vas, cap * sizeof(uint64_t));
+            uint16_t *grown_pids = pids ? realloc(pids, cap * sizeof(uint16_t)) : NULL;
+            uint8_t *grown_writes = writes ? realloc(writes, (cap + 7) / 8) : NULL;
+            if (grown) vas = grown;
+            if (grown_pids) pids = grown_pids;
+            if (grown_writes) {
+                writes = grown_writes;
+                memset(writes + (n + 7) / 8, 0, (cap + 7) / 8 - (n + 7) / 8);
+            }
+            if (!grown || (pids && !grown_pids) || (writes && !grown_writes)) {
+                oom = true;
+                break;
+            }
+        }
+        if (t->pid && !pids) {
+            pids = calloc(cap, sizeof(uint16_t));
+            if (!pids) {
+                oom = true;
+                break;
+            }
+        }
+        // 쓰기 비트맵도 첫 쓰기 접근에서 만듦
+        if (t->write && !writes) {
+            writes = calloc((cap + 7) / 8, 1);
+            if (!writes) {
+                oom = true;
+                break;
+            }
+        }
+        if (pids) pids[n] = t->pid;
+        if (t->write) writes[n / 8] |= (uint8_t)(1u << (n % 8));
+        vas[n++] = va;
+    }
+    close_source(t);
+    t->pos = 0;
+    t->pid = 0;
+    t->write = false;
+    if (oom) {
+        free(vas);
+        free(pids);
+        free(writes);
+        fprintf(stderr, "Out of memory while loading trace.\n");
+        return -1;
+    }
+
+    t->owned = vas;
+    t->owned_pids = pids;
+    t->pids = pids;
+    t->owned_writes = writes;
+    t->writes = writes;
+    t->records = (const uint8_t *)vas;
+    t->addr_bytes = sizeof(uint64_t);
+    t->count = n;
+    return 0;
+}
+
+bool trace_next(Trace *t, uint64_t *va) {
+    if (t->records) {
+        if (t->pos >= t->count) return false;
+
+        // 고정 폭 레코드: 파싱 없이 바로 복사 (little-endian 호스트 가정)
+        *va = trace_get(t, t->pos);
+        t->pid = (uint16_t)trace_get_pid(t, t->pos);
+        t->write = trace_get_write(t, t->pos);
+        t->pos++;
+        return true;
+    }
+
+    if (t->buf) {
+        if (t->buf_pos == t->buf_len && !refill(t)) return false;
+        *va = t->buf[t->buf_pos++];
+        t->pos++;
+        return true;
+    }
+
+    if (!read_text_record(t, va)) return false;
+    t->pos++;
+    return true;
+}
+
+bool trace_skip(Trace *t, uint64_t n) {
+    if (t->records) {
+        uint64_t left = t->count - t->pos;
+        t->pos += n < left ? n : left;
+        return n <= left;
+    }
+
+    // 생성기는 난수 상태만 옮김 (이미 채워 둔 묶음부터 소비)
+    if (t->gen) {
+        uint64_t buffered = t->buf_len - t->buf_pos;
+        if (n <= buffered) {
+            t->buf_pos += n;
+            t->pos += n;
+            return true;
+        }
+        t->buf_pos = t->buf_len;
+        t->pos += buffered;
+        n -= buffered;
+        uint64_t before = t->gen->pos;
+        bool ok = workload_skip(t->gen, n);
+        t->fetched += t->gen->pos - before;
+        t->pos += t->gen->pos - before;
+        return ok;
+    }
+
+    // 텍스트는 pid 표기가 이후 레코드에 이어지고 파이프는 되돌아갈 수 없으므로 하나씩 읽어야 함
+    uint64_t va;
+    for (uint64_t i = 0; i < n; i++) {
+        if (!trace_next(t, &va)) return false;
+    }
+    return true;
+}
+
+void trace_close(Trace *t) {
+    if (t->format == TRACE_BINARY && t->map) {
+        munmap(t->map, t->map_len);
+    }
+    close_source(t);
+    free(t->owned);
+    free(t->owned_pids);
+    free(t->owned_writes);
+    memset(t, 0, sizeof(*t));
+}
+
+const char* trace_format_name(const Trace *t) {
+    switch (t->format) {
+        case TRACE_BINARY: return "binary(mmap)";
+        case TRACE_STREAM: return "binary(stream)";
+        case TRACE_SYNTH:  return "synthetic";
+        default:           return "text";
+    }
+}
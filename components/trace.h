@@ -0,0 +1,125 @@
+/* trace.h */
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "workload.h"
+
+// --- 바이너리 트레이스 포맷 ---
+// | Header (16 Bytes) | Record 0 | Record 1 | ... | (TRACE_FLAG_PID: pid 0 | pid 1 | ...) | (TRACE_FLAG_WRITE: 비트맵) |
+// Record는 addr_bytes 폭의 little-endian 주소 (파싱 없이 그대로 읽음)
+// 다중 프로세스 트레이스는 레코드 뒤에 레코드별 pid (uint16) 배열이 따라옴
+// 쓰기 접근이 있는 트레이스는 그 뒤에 레코드당 1 bit (레코드 i = byte i/8 의 bit i%8, 1 = 쓰기)
+#define TRACE_MAGIC "MTRC"
+#define TRACE_VERSION 1
+#define TRACE_FLAG_PID 0x01
+#define TRACE_FLAG_WRITE 0x02
+
+typedef struct {
+    char magic[4];       // "MTRC"
+    uint16_t version;    // TRACE_VERSION
+    uint8_t addr_bytes;  // 레코드 하나의 주소 폭 (1, 2, 4, 8)
+    uint8_t flags;       // TRACE_FLAG_*
+    uint64_t count;      // 총 접근 횟수
+} TraceHeader;
+
+// --- 텍스트 트레이스의 프로세스 표기 ---
+// "@3"       : 문맥 교환 표시. 이후 주소는 pid 3 의 접근 (pid 는 10진수)
+// "3:0x1a8"  : 한 줄에 pid 와 주소를 함께 (이후 주소의 pid 도 3)
+// 표기가 없으면 모두 pid 0. 첫 줄의 접근 횟수에는 표시 줄을 세지 않음
+//
+// --- 접근 종류 ---
+// "W:0x1a8", "3:W:0x1a8" : 쓰기 (R: 은 읽기, 표기가 없으면 읽기)
+#define TRACE_MAX_PID UINT16_MAX
+
+// --- 파일이 아닌 입력 ---
+// "-" 또는 파이프 / FIFO: 바이너리 포맷을 순서대로 읽음 (mmap 불가, pid 배열 / 쓰기 비트맵 없는 것만)
+//   예) trace_gen zipf:n=1G | simulator -f - ...
+// "gen:<spec>": 합성 워크로드를 그 자리에서 생성 (workload.h, 모두 pid 0 / 읽기)
+#define TRACE_GEN_PREFIX "gen:"
+#define TRACE_STREAM_CHUNK 4096  // 파이프 / 생성기에서 한 번에 채우는 레코드 수
+
+typedef enum {
+    TRACE_TEXT,   // 기존 hex 텍스트 (첫 줄: 접근 횟수, 이후 한 줄에 주소 하나)
+    TRACE_BINARY, // mmap 으로 읽는 바이너리 포맷
+    TRACE_STREAM, // 파이프로 읽는 바이너리 포맷
+    TRACE_SYNTH   // 합성 워크로드
+} TraceFormat;
+
+typedef struct {
+    TraceFormat format;
+    uint64_t count;          // 헤더에 기록된 총 접근 횟수
+    uint64_t pos;            // 지금까지 읽은 레코드 수
+
+    // TRACE_TEXT
+    FILE *fp;
+
+    // TRACE_BINARY (또는 trace_load 로 메모리에 올린 텍스트)
+    void *map;
+    size_t map_len;
+    const uint8_t *records;  // 첫 레코드 위치 (NULL 이면 텍스트 스트리밍)
+    uint8_t addr_bytes;
+    uint64_t *owned;         // trace_load 가 텍스트를 파싱해 만든 8-byte 레코드 배열
+
+    // 다중 프로세스
+    const uint16_t *pids;    // 레코드별 pid (NULL 이면 모두 pid 0 이거나 텍스트 스트리밍)
+    uint16_t *owned_pids;
+    uint16_t pid;            // trace_next 가 마지막으로 돌려준 레코드의 pid
+
+    // 쓰기 접근
+    const uint8_t *writes;   // 레코드별 쓰기 비트맵 (NULL 이면 모두 읽기이거나 텍스트 스트리밍)
+    uint8_t *owned_writes;
+    bool write;              // trace_next 가 마지막으로 돌려준 레코드가 쓰기인지
+
+    // TRACE_STREAM / TRACE_SYNTH: TRACE_STREAM_CHUNK 개씩 채워 두고 하나씩 꺼냄
+    uint64_t *buf;
+    size_t buf_len;
+    size_t buf_pos;
+    uint64_t fetched;        // buf 에 채운 누적 레코드 수
+    uint8_t *raw;            // [STREAM] 파이프에서 읽은 레코드 (addr_bytes 폭)
+    Workload *gen;           // [SYNTH]
+} Trace;
+
+// 파일 앞부분의 magic 으로 포맷을 판별해서 연다 ("-" / 파이프 / "gen:<spec>" 도 가능). 성공 0, 실패 -1
+int trace_open(Trace *t, const char *path);
+
+// 트레이스 전체를 메모리에 올린다 (바이너리: mmap 그대로, 텍스트 / 파이프 / 생성기: 한 번 읽어 둠)
+// 이후 trace_get 으로 여러 스레드가 읽기 전용으로 공유할 수 있음. 성공 0, 실패 -1
+int trace_load(Trace *t, const char *path);
+
+// 다음 주소를 읽는다 (그 주소의 pid 는 t->pid, 쓰기 여부는 t->write). 더 이상 없으면 false
+bool trace_next(Trace *t, uint64_t *va);
+
+// 다음 n 개 레코드를 건너뜀 (체크포인트 복원: 바이너리 / 메모리에 올린 트레이스 / 생성기는 바로 이동)
+// 남은 레코드가 n 개보다 적으면 끝까지 가서 false
+bool trace_skip(Trace *t, uint64_t n);
+
+// i 번째 레코드 (trace_load 이후 또는 바이너리 트레이스에서만 사용)
+static inline uint64_t trace_get(const Trace *t, uint64_t i) {
+    const uint8_t *rec = t->records + i * t->addr_bytes;
+    switch (t->addr_bytes) {
+        case 1: return rec[0];
+        case 2: { uint16_t v; __builtin_memcpy(&v, rec, 2); return v; }
+        case 4: { uint32_t v; __builtin_memcpy(&v, rec, 4); return v; }
+        default: { uint64_t v; __builtin_memcpy(&v, rec, 8); return v; }
+    }
+}
+
+// i 번째 레코드의 pid
+static inline int trace_get_pid(const Trace *t, uint64_t i) {
+    return t->pids ? t->pids[i] : 0;
+}
+
+// i 번째 레코드가 쓰기 접근인지
+static inline bool trace_get_write(const Trace *t, uint64_t i) {
+    return t->writes && ((t->writes[i / 8] >> (i % 8)) & 1);
+}
+
+void trace_close(Trace *t);
+
+const char* trace_format_name(const Trace *t);
+
+#endif
@@ -0,0 +1,104 @@
+/* vpn_map.c */
+#include "vpn_map.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static inline uint64_t hash_key(uint64_t k) {
+    // splitmix64 finalizer
+    k ^= k >> 30; k *= 0xbf58476d1ce4e5b9ULL;
+    k ^= k >> 27; k *= 0x94d049bb133111ebULL;
+    k ^= k >> 31;
+    return k;
+}
+
+static void alloc_table(VpnMap *m, uint64_t capacity) {
+    m->capacity = capacity;
+    m->size = 0;
+    m->keys = malloc(sizeof(uint64_t) * capacity);
+    m->values = malloc(sizeof(uint64_t) * capacity);
+    m->used = calloc(capacity, sizeof(bool));
+    if (!m->keys || !m->values || !m->used) {
+        perror("malloc vpn map");
+        exit(1);
+    }
+}
+
+void vmap_init(VpnMap *m, uint64_t expected) {
+    uint64_t cap = 16;
+    while (cap < expected * 2) cap <<= 1; // load factor <= 0.5
+    alloc_table(m, cap);
+}
+
+void vmap_destroy(VpnMap *m) {
+    free(m->keys);
+    free(m->values);
+    free(m->used);
+    memset(m, 0, sizeof(*m));
+}
+
+void vmap_clear(VpnMap *m) {
+    memset(m->used, 0, sizeof(bool) * m->capacity);
+    m->size = 0;
+}
+
+static void grow(VpnMap *m) {
+    VpnMap old = *m;
+    alloc_table(m, old.capacity * 2);
+    for (uint64_t i = 0; i < old.capacity; i++) {
+        if (old.used[i]) vmap_put(m, old.keys[i], old.values[i]);
+    }
+    vmap_destroy(&old);
+}
+
+bool vmap_get(const VpnMap *m, uint64_t key, uint64_t *value) {
+    uint64_t mask = m->capacity - 1;
+    for (uint64_t i = hash_key(key) & mask; m->used[i]; i = (i + 1) & mask) {
+        if (m->keys[i] == key) {
+            if (value) *value = m->values[i];
+            return true;
+        }
+    }
+    return false;
+}
+
+void vmap_put(VpnMap *m, uint64_t key, uint64_t value) {
+    if ((m->size + 1) * 2 > m->capacity) grow(m);
+
+    uint64_t mask = m->capacity - 1;
+    uint64_t i = hash_key(key) & mask;
+    while (m->used[i]) {
+        if (m->keys[i] == key) {
+            m->values[i] = value;
+            return;
+        }
+        i = (i + 1) & mask;
+    }
+    m->used[i] = true;
+    m->keys[i] = key;
+    m->values[i] = value;
+    m->size++;
+}
+
+bool vmap_remove(VpnMap *m, uint64_t key) {
+    uint64_t mask = m->capacity - 1;
+    uint64_t i = hash_key(key) & mask;
+    while (m->used[i] && m->keys[i] != key) i = (i + 1) & mask;
+    if (!m->used[i]) return false;
+
+    // backward shift: 뒤따르는 클러스터를 빈 칸 쪽으로 당김
+    uint64_t hole = i;
+    for (uint64_t j = (i + 1) & mask; m->used[j]; j = (j + 1) & mask) {
+        uint64_t home = hash_key(m->keys[j]) & mask;
+        // home 이 (hole, j] 구간 밖이면 hole 로 이동 가능
+        bool between = (hole <= j) ? (home > hole && home <= j) : (home > hole || home <= j);
+        if (!between) {
+            m->keys[hole] = m->keys[j];
+            m->values[hole] = m->values[j];
+            hole = j;
+        }
+    }
+    m->used[hole] = false;
+    m->size--;
+    return true;
+}
@@ -0,0 +1,28 @@
+/* vpn_map.h */
+#ifndef VPN_MAP_H
+#define VPN_MAP_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// --- VPN(64-bit key) -> 64-bit value 해시맵 ---
+// open addressing + linear probing, 삭제는 backward shift (tombstone 없음)
+// 주소 공간이 커서 VPN 으로 직접 인덱싱할 수 없는 곳에서 사용
+typedef struct {
+    uint64_t *keys;
+    uint64_t *values;
+    bool *used;
+    uint64_t capacity; // 2의 거듭제곱
+    uint64_t size;
+} VpnMap;
+
+void vmap_init(VpnMap *m, uint64_t expected);
+void vmap_destroy(VpnMap *m);
+void vmap_clear(VpnMap *m);
+
+// 있으면 true 와 함께 *value 채움
+bool vmap_get(const VpnMap *m, uint64_t key, uint64_t *value);
+void vmap_put(VpnMap *m, uint64_t key, uint64_t value);
+bool vmap_remove(VpnMap *m, uint64_t key);
+
+#endif
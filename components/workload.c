@@ -0,0 +1,363 @@
+/* workload.c */
+#include "workload.h"
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+static const char *kind_names[WORKLOAD_KINDS] = { "uniform", "zipf", "stride", "loop", "phase" };
+
+// 접근 하나가 쓰는 난수 개수 (workload_skip 이 상태를 바로 옮길 수 있도록 고정)
+static const int draws_per_access[WORKLOAD_KINDS] = { 1, 2, 0, 1, 2 };
+
+// --- splitmix64 ---
+#define GOLDEN 0x9E3779B97F4A7C15ULL
+
+static inline uint64_t mix64(uint64_t z) {
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+static inline uint64_t next64(uint64_t *state) {
+    return mix64(*state += GOLDEN);
+}
+
+// [0, n) 범위로 (n <= 2^32, 상위 32 bit 사용 - 하위 bit 는 오프셋 / alias 동전에 씀)
+static inline uint64_t scale32(uint64_t r, uint64_t n) {
+    return ((r >> 32) * n) >> 32;
+}
+
+// "4096", "64K", "1M", "1G" (2^10 단위)
+static bool parse_count(const char *s, uint64_t *out) {
+    char *end;
+    uint64_t v = strtoull(s, &end, 0);
+    if (end == s) return false;
+    switch (*end) {
+        case 'k': case 'K': v <<= 10; end++; break;
+        case 'm': case 'M': v <<= 20; end++; break;
+        case 'g': case 'G': v <<= 30; end++; break;
+        case 't': case 'T': v <<= 40; end++; break;
+        default: break;
+    }
+    if (*end != '\0') return false;
+    *out = v;
+    return true;
+}
+
+// 0 ~ n-1 을 섞은 순서 (Fisher-Yates, 접근 난수와 별도의 흐름)
+static uint32_t *shuffled(uint64_t n, uint64_t seed) {
+    uint32_t *perm = malloc(n * sizeof(uint32_t));
+    if (!perm) return NULL;
+    for (uint64_t i = 0; i < n; i++) perm[i] = (uint32_t)i;
+    uint64_t state = mix64(seed ^ 0x5EED5EED5EED5EEDULL);
+    for (uint64_t i = n - 1; i > 0; i--) {
+        uint64_t j = scale32(next64(&state), i + 1);
+        uint32_t tmp = perm[i];
+        perm[i] = perm[j];
+        perm[j] = tmp;
+    }
+    return perm;
+}
+
+// 순위 k (1 ~ n) 의 가중치 1/k^s 로 Vose alias table 을 만들고, 순위를 섞은 페이지 번호로 바꿔 둠
+static AliasEntry *build_alias(uint64_t n, double s, uint64_t seed) {
+    AliasEntry *table = malloc(n * sizeof(AliasEntry));
+    double *q = malloc(n * sizeof(double));
+    uint32_t *work = malloc(n * sizeof(uint32_t)); // 앞쪽은 small 스택, 뒤쪽은 large 스택
+    uint32_t *perm = shuffled(n, seed);
+    if (!table || !q || !work || !perm) {
+        free(table);
+        table = NULL;
+        goto out;
+    }
+
+    double sum = 0.0;
+    for (uint64_t k = 0; k < n; k++) {
+        q[k] = s == 0.0 ? 1.0 : pow((double)(k + 1), -s);
+        sum += q[k];
+    }
+    uint64_t small = 0, large = n;
+    for (uint64_t k = 0; k < n; k++) {
+        q[k] *= (double)n / sum;
+        if (q[k] < 1.0) work[small++] = (uint32_t)k;
+        else work[--large] = (uint32_t)k;
+    }
+
+    while (small > 0 && large < n) {
+        uint32_t l = work[--small];
+        uint32_t g = work[large++];
+        double p = q[l] * 4294967296.0;
+        table[l].prob = p >= 4294967295.0 ? UINT32_MAX : (uint32_t)p;
+        table[l].vpn = perm[l];
+        table[l].alias = perm[g];
+        q[g] = (q[g] + q[l]) - 1.0;
+        if (q[g] < 1.0) work[small++] = g;
+        else work[--large] = g;
+    }
+    // 남은 칸은 (반올림 오차 포함) 확률 1
+    while (small > 0) {
+        uint32_t k = work[--small];
+        table[k] = (AliasEntry){ UINT32_MAX, perm[k], perm[k] };
+    }
+    while (large < n) {
+        uint32_t k = work[large++];
+        table[k] = (AliasEntry){ UINT32_MAX, perm[k], perm[k] };
+    }
+
+out:
+    free(q);
+    free(work);
+    free(perm);
+    return table;
+}
+
+// 동전 결과는 예측할 수 없으므로 분기 대신 마스크로 고름
+static inline uint64_t alias_pick(const AliasEntry *table, uint64_t n, uint64_t r) {
+    const AliasEntry *e = &table[scale32(r, n)];
+    uint32_t keep = -(uint32_t)((uint32_t)r < e->prob);
+    return (e->vpn & keep) | (e->alias & ~keep);
+}
+
+int workload_init(Workload *w, const char *spec) {
+    memset(w, 0, sizeof(*w));
+    w->count = 10000;
+    w->pages = 512;
+    w->page_size = 8;
+    w->seed = 1;
+    w->s = 1.0;
+
+    char *buf = strdup(spec);
+    int ret = 0;
+    char *save = NULL;
+    char *tok = strtok_r(buf, ":", &save);
+    int k;
+    for (k = 0; tok && k < WORKLOAD_KINDS; k++) {
+        if (strcmp(tok, kind_names[k]) == 0) break;
+    }
+    if (!tok || k == WORKLOAD_KINDS) {
+        fprintf(stderr, "Unknown workload '%s' (uniform, zipf, stride, loop, phase)\n", tok ? tok : "");
+        free(buf);
+        return -1;
+    }
+    w->kind = (WorkloadKind)k;
+
+    bool stride_given = false, phase_given = false, ws_given = false;
+    while (ret == 0 && (tok = strtok_r(NULL, ":", &save))) {
+        char *eq = strchr(tok, '=');
+        bool ok = eq != NULL;
+        if (ok) {
+            *eq = '\0';
+            const char *key = tok, *val = eq + 1;
+            if (strcmp(key, "n") == 0) {
+                ok = parse_count(val, &w->count);
+            } else if (strcmp(key, "pages") == 0) {
+                ok = parse_count(val, &w->pages);
+            } else if (strcmp(key, "page") == 0) {
+                ok = parse_count(val, &w->page_size);
+            } else if (strcmp(key, "base") == 0) {
+                ok = parse_count(val, &w->base);
+            } else if (strcmp(key, "seed") == 0) {
+                ok = parse_count(val, &w->seed);
+            } else if (strcmp(key, "s") == 0) {
+                char *end;
+                w->s = strtod(val, &end);
+                ok = end != val && *end == '\0' && w->s >= 0.0;
+            } else if (strcmp(key, "stride") == 0) {
+                ok = parse_count(val, &w->stride);
+                stride_given = true;
+            } else if (strcmp(key, "phase") == 0) {
+                ok = parse_count(val, &w->phase);
+                phase_given = true;
+            } else if (strcmp(key, "ws") == 0) {
+                ok = parse_count(val, &w->ws);
+                ws_given = true;
+            } else {
+                fprintf(stderr, "Unknown workload key '%s'\n", key);
+                ret = -1;
+                break;
+            }
+        }
+        if (!ok) {
+            fprintf(stderr, "Invalid workload value '%s'\n", eq ? eq + 1 : tok);
+            ret = -1;
+        }
+    }
+    free(buf);
+    if (ret != 0) return -1;
+
+    if (!stride_given) w->stride = w->page_size;
+    if (!phase_given) w->phase = w->count >= 8 ? w->count / 8 : 1;
+    if (!ws_given) w->ws = w->pages >= 8 ? w->pages / 8 : 1;
+
+    // 페이지 번호는 32 bit (alias table / 방문 순서), 오프셋은 난수 하위 32 bit
+    if (w->pages == 0 || w->pages > (1ULL << 32)) {
+        fprintf(stderr, "Workload: pages must be 1 ~ 4G\n");
+        return -1;
+    }
+    if (w->page_size == 0 || (w->page_size & (w->page_size - 1)) || w->page_size > (1ULL << 32)) {
+        fprintf(stderr, "Workload: page must be a power of two up to 4G\n");
+        return -1;
+    }
+    if (w->pages > (UINT64_MAX - w->base) / w->page_size) {
+        fprintf(stderr, "Workload: base + pages * page overflows 64 bits\n");
+        return -1;
+    }
+    if (w->kind == WORKLOAD_PHASE && (w->phase == 0 || w->ws == 0 || w->ws > w->pages)) {
+        fprintf(stderr, "Workload: phase needs phase > 0 and 0 < ws <= pages\n");
+        return -1;
+    }
+    w->rng = w->seed;
+
+    if (w->kind == WORKLOAD_ZIPF || w->kind == WORKLOAD_PHASE) {
+        w->table_size = w->kind == WORKLOAD_ZIPF ? w->pages : w->ws;
+        w->table = build_alias(w->table_size, w->s, w->seed);
+        if (!w->table) {
+            fprintf(stderr, "Workload: out of memory for the alias table (%llu entries)\n",
+                    (unsigned long long)w->table_size);
+            return -1;
+        }
+    } else if (w->kind == WORKLOAD_LOOP) {
+        w->order = shuffled(w->pages, w->seed);
+        if (!w->order) {
+            fprintf(stderr, "Workload: out of memory for the loop order (%llu pages)\n",
+                    (unsigned long long)w->pages);
+            return -1;
+        }
+    }
+    return 0;
+}
+
+void workload_destroy(Workload *w) {
+    free(w->table);
+    free(w->order);
+    memset(w, 0, sizeof(*w));
+}
+
+// [phase] 단계 p 의 작업 집합 시작 페이지 (상태 없이 seed 와 p 로만 정함)
+static inline uint64_t phase_start(const Workload *w, uint64_t p) {
+    return mix64(w->seed ^ mix64(p + 1)) % w->pages;
+}
+
+// [zipf / phase] alias table 에서 n 개를 뽑아 start 만큼 민 페이지 (footprint 안에서 순환) 의 주소로
+// 캐시에 들어가지 않는 테이블은 칸 읽기가 miss 이므로 ALIAS_BLOCK 개의 난수를 먼저 만들어
+// 칸을 prefetch 한 뒤 고름 (접근마다 난수 2개 - 칸 + 동전, 오프셋 - 를 쓰는 순서는 같음)
+#define ALIAS_BLOCK 32
+#define ALIAS_CACHED_BYTES (256 << 10)
+
+static void alias_fill(const Workload *w, uint64_t *rng, uint64_t *va, size_t n, uint64_t start) {
+    const AliasEntry *table = w->table;
+    const uint64_t size = w->table_size, base = w->base, pages = w->pages, mask = w->page_size - 1;
+    const int shift = __builtin_ctzll(w->page_size);
+    uint64_t state = *rng;
+
+    if (size * sizeof(AliasEntry) <= ALIAS_CACHED_BYTES) {
+        for (size_t i = 0; i < n; i++) {
+            uint64_t vpn = start + alias_pick(table, size, next64(&state));
+            if (vpn >= pages) vpn -= pages;
+            va[i] = base + (vpn << shift) + (next64(&state) & mask);
+        }
+        *rng = state;
+        return;
+    }
+
+    for (size_t i = 0; i < n; i += ALIAS_BLOCK) {
+        size_t m = n - i < ALIAS_BLOCK ? n - i : ALIAS_BLOCK;
+        for (size_t j = 0; j < m; j++) {
+            uint64_t r = mix64(state + (2 * j + 1) * GOLDEN);
+            va[i + j] = r;
+            __builtin_prefetch(&table[scale32(r, size)]);
+        }
+        for (size_t j = 0; j < m; j++) {
+            uint64_t vpn = start + alias_pick(table, size, va[i + j]);
+            if (vpn >= pages) vpn -= pages;
+            va[i + j] = base + (vpn << shift) + (mix64(state + (2 * j + 2) * GOLDEN) & mask);
+        }
+        state += 2 * m * GOLDEN;
+    }
+    *rng = state;
+}
+
+size_t workload_fill(Workload *w, uint64_t *va, size_t n) {
+    if (w->count - w->pos < n) n = (size_t)(w->count - w->pos);
+
+    // 지역 변수로 옮겨 루프 안에서 메모리를 다시 읽지 않게
+    uint64_t rng = w->rng;
+    const uint64_t base = w->base, pages = w->pages, mask = w->page_size - 1;
+    const int shift = __builtin_ctzll(w->page_size);
+
+    switch (w->kind) {
+        case WORKLOAD_UNIFORM:
+            for (size_t i = 0; i < n; i++) {
+                uint64_t r = next64(&rng);
+                va[i] = base + (scale32(r, pages) << shift) + (r & mask);
+            }
+            break;
+        case WORKLOAD_ZIPF:
+            alias_fill(w, &rng, va, n, 0);
+            break;
+        case WORKLOAD_STRIDE: {
+            // footprint 안에서 순환: 위치는 pos 로 정해짐
+            uint64_t span = pages << shift;
+            uint64_t step = w->stride % span;
+            uint64_t off = (uint64_t)(((unsigned __int128)w->pos * step) % span);
+            for (size_t i = 0; i < n; i++) {
+                va[i] = base + off;
+                off += step;
+                if (off >= span) off -= span;
+            }
+            break;
+        }
+        case WORKLOAD_LOOP: {
+            const uint32_t *order = w->order;
+            uint64_t idx = w->pos % pages;
+            for (size_t i = 0; i < n; i++) {
+                va[i] = base + ((uint64_t)order[idx] << shift) + (next64(&rng) & mask);
+                if (++idx == pages) idx = 0;
+            }
+            break;
+        }
+        case WORKLOAD_PHASE: {
+            size_t i = 0;
+            while (i < n) {
+                uint64_t p = (w->pos + i) / w->phase;
+                uint64_t left = w->phase - (w->pos + i) % w->phase;
+                size_t len = left < n - i ? (size_t)left : n - i;
+                alias_fill(w, &rng, va + i, len, phase_start(w, p));
+                i += len;
+            }
+            break;
+        }
+        default:
+            n = 0;
+            break;
+    }
+
+    w->rng = rng;
+    w->pos += n;
+    return n;
+}
+
+bool workload_skip(Workload *w, uint64_t n) {
+    uint64_t left = w->count - w->pos;
+    uint64_t k = n < left ? n : left;
+    w->rng += GOLDEN * draws_per_access[w->kind] * k;
+    w->pos += k;
+    return n <= left;
+}
+
+uint64_t workload_limit(const Workload *w) {
+    return w->base + w->pages * w->page_size;
+}
+
+void workload_print(const Workload *w, FILE *fp) {
+    fprintf(fp, "[Workload] %s", kind_names[w->kind]);
+    if (w->kind == WORKLOAD_ZIPF || w->kind == WORKLOAD_PHASE) fprintf(fp, " s=%g", w->s);
+    if (w->kind == WORKLOAD_STRIDE) fprintf(fp, " stride=%llu", (unsigned long long)w->stride);
+    if (w->kind == WORKLOAD_PHASE) {
+        fprintf(fp, " ws=%llu pages every %llu accesses", (unsigned long long)w->ws,
+                (unsigned long long)w->phase);
+    }
+    fprintf(fp, ": %llu accesses over %llu pages of %llu bytes from 0x%llx, seed %llu\n",
+            (unsigned long long)w->count, (unsigned long long)w->pages,
+            (unsigned long long)w->page_size, (unsigned long long)w->base, (unsigned long long)w->seed);
+}
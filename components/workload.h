@@ -0,0 +1,74 @@
+/* workload.h */
+#ifndef WORKLOAD_H
+#define WORKLOAD_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+// --- 합성 워크로드 생성기 ---
+// testcase_generator/generator.py 의 분포를 파일 없이 바로 만들어 냄 (-f gen:<spec>, trace_gen)
+// spec: "<kind>[:key=value...]"  예) "zipf:s=0.99:pages=1M:page=4096:n=1G:seed=7"
+//   uniform: footprint 의 모든 페이지가 같은 확률
+//   zipf:    순위 k 의 확률 1/k^s, 순위 -> 페이지는 seed 로 섞음 (alias table 로 O(1) 추출)
+//   stride:  base 부터 stride 바이트씩, footprint 끝에서 처음으로 (오프셋도 고정)
+//   loop:    seed 로 섞은 footprint 전체 순서를 반복 (포인터 추적 같은 불규칙한 순환)
+//   phase:   phase 접근마다 footprint 안에서 ws 페이지짜리 작업 집합이 옮겨 감 (그 안은 zipf s)
+// 공통 key: n (접근 수, 기본 10000), pages (footprint, 기본 512), page (페이지 크기, 기본 8),
+//           base (시작 주소), seed (기본 1) -- 기본값은 generator.py 와 같은 12bit 트레이스
+// 크기는 "64K", "1M", "1G" 처럼 접미사 가능 (2^10 단위)
+// 난수는 splitmix64 (상태 = 카운터): 접근마다 쓰는 난수 개수가 고정이라 건너뛰기가 O(1)
+// 같은 spec 이면 몇 개씩 나눠 뽑든 항상 같은 주소 열
+typedef enum {
+    WORKLOAD_UNIFORM,
+    WORKLOAD_ZIPF,
+    WORKLOAD_STRIDE,
+    WORKLOAD_LOOP,
+    WORKLOAD_PHASE,
+    WORKLOAD_KINDS
+} WorkloadKind;
+
+// alias table 한 칸: 칸 i 를 고른 뒤 32-bit 난수 < prob 이면 vpn, 아니면 alias 쪽 vpn
+// (순위 -> 페이지 섞기를 미리 반영해 두어 추출에 메모리 접근 한 번)
+typedef struct {
+    uint32_t prob;
+    uint32_t vpn;
+    uint32_t alias;
+} AliasEntry;
+
+typedef struct {
+    WorkloadKind kind;
+    uint64_t count;       // 총 접근 수
+    uint64_t pages;       // footprint (페이지 수)
+    uint64_t page_size;   // 2의 거듭제곱
+    uint64_t base;        // footprint 시작 주소
+    uint64_t seed;
+    double s;             // [zipf / phase] 기울기 (0 = uniform)
+    uint64_t stride;      // [stride] 바이트 (기본 page)
+    uint64_t phase;       // [phase] 한 단계의 접근 수 (기본 n / 8)
+    uint64_t ws;          // [phase] 작업 집합 페이지 수 (기본 pages / 8)
+
+    uint64_t pos;         // 지금까지 만든 접근 수
+    uint64_t rng;         // splitmix64 상태
+    AliasEntry *table;    // [zipf / phase] alias table (zipf: pages 칸, phase: ws 칸)
+    uint64_t table_size;
+    uint32_t *order;      // [loop] 방문 순서
+} Workload;
+
+// spec 해석 + 테이블 준비. 성공 0, 실패 -1 (에러 메시지는 stderr)
+int workload_init(Workload *w, const char *spec);
+void workload_destroy(Workload *w);
+
+// 다음 주소 최대 n 개를 va 에 채움. 반환값은 채운 개수 (count 에 닿으면 n 보다 작음)
+size_t workload_fill(Workload *w, uint64_t *va, size_t n);
+
+// 다음 n 개를 만들지 않고 건너뜀 (O(1)). 남은 것보다 많으면 끝까지 가서 false
+bool workload_skip(Workload *w, uint64_t n);
+
+// 마지막 주소 + 1 (바이너리 레코드 폭을 정할 때)
+uint64_t workload_limit(const Workload *w);
+
+void workload_print(const Workload *w, FILE *fp);
+
+#endif
@@ -1,15 +1,32 @@
 import matplotlib.pyplot as plt
 import os
 import argparse
+import csv
 
 # 실험 시나리오
 SCENARIOS = ["uniform", "zipf_0.5", "zipf_1.0", "zipf_1.5"]
 LABELS = ["Uniform", "Zipf (s=0.5)", "Zipf (s=1.0)", "Zipf (s=1.5)"]
 COLORS = ['gray', 'orange', 'green', 'blue']
 
+def load_timeseries(ts_file):
+    """
+    시뮬레이터의 -w/-t 옵션으로 생성된 시계열 CSV에서 누적 TLB Miss Rate를 읽음
+    파일이 없으면 None (로그 파싱으로 대체)
+    """
+    if not os.path.exists(ts_file):
+        return None
+    x_data = []
+    y_data = []
+    with open(ts_file, 'r') as f:
+        for row in csv.DictReader(f):
+            x_data.append(int(row["accesses"]))
+            y_data.append(float(row["cumulative_tlb_miss_rate"]) * 100)
+    return x_data, y_data
+
 def get_cumulative_rates(log_file):
     """
     로그 파일을 읽어 시간(접근 횟수)에 따른 누적 TLB Miss Rate를 계산
+    재시도 "Access VA:" (같은 접근의 "PA:" 전 두 번째 이후) 는 세지 않음 (시계열 CSV 와 같은 기준)
     """
     total_access = 0
     tlb_miss_count = 0
@@ -18,19 +35,26 @@ def get_cumulative_rates(log_file):
     x_data = []
     y_data = []
     
+    new_access = True   # 다음 "Access VA:" 가 새 접근의 첫 시도인지
+    first_attempt = False
     try:
         with open(log_file, 'r') as f:
             for line in f:
                 if "Access VA:" in line:
-                    total_access += 1
+                    first_attempt = new_access
+                    new_access = False
+                    if first_attempt:
+                        total_access += 1
                 elif "TLB Miss:" in line:
-                    tlb_miss_count += 1
-                
-                # 100회 접근마다 기록 (또는 매번 기록)
-                if total_access > 0 and total_access % 100 == 0:
-                    miss_rate = (tlb_miss_count / total_access) * 100
-                    x_data.append(total_access)
-                    y_data.append(miss_rate)
+                    if first_attempt:
+                        tlb_miss_count += 1
+                elif line.startswith("PA:"):
+                    new_access = True
+                    # 100회 접근마다 기록 (접근이 끝나는 "PA:" 줄에서)
+                    if total_access % 100 == 0:
+                        miss_rate = (tlb_miss_count / total_access) * 100
+                        x_data.append(total_access)
+                        y_data.append(miss_rate)
                     
     except FileNotFoundError:
         print(f"[Warning] Log file '{log_file}' not found.")
@@ -42,8 +66,12 @@ def plot_time_series(log_dir):
     plt.figure(figsize=(12, 8))
     
     for i, scenario in enumerate(SCENARIOS):
-        log_path = os.path.join(log_dir, f"output_{scenario}")
-        x, y = get_cumulative_rates(log_path)
+        # 1순위: 시계열 CSV (simulator -w 100 -t timeseries_<scenario>.csv), 2순위: 로그 파싱
+        res = load_timeseries(os.path.join(log_dir, f"timeseries_{scenario}.csv"))
+        if res is None:
+            log_path = os.path.join(log_dir, f"output_{scenario}")
+            res = get_cumulative_rates(log_path)
+        x, y = res
         
         if x and y:
             plt.plot(x, y, label=LABELS[i], color=COLORS[i], linewidth=2)
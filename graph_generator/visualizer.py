@@ -1,6 +1,7 @@
 import matplotlib.pyplot as plt
 import os
 import argparse
+import json
 from collections import Counter
 
 # 실험 시나리오 이름 (파일 이름과 매칭)
@@ -29,9 +30,22 @@ def parse_access_frequency(input_file):
     
     return Counter(vpns)
 
+def load_stats_summary(stats_file):
+    """
+    시뮬레이터의 -s 옵션으로 생성된 JSON 요약을 읽어 (TLB Miss Rate, Page Fault Rate)를 반환합니다.
+    파일이 없으면 None (로그 파싱으로 대체)
+    """
+    if not os.path.exists(stats_file):
+        return None
+    with open(stats_file, 'r') as f:
+        stats = json.load(f)
+    return stats["tlb_miss_rate"] * 100, stats["page_fault_rate"] * 100
+
 def parse_metrics(log_file):
     """
     시뮬레이터 출력 로그 파일을 읽어 성능 지표(TLB Miss, Page Fault)를 계산합니다.
+    접근 하나는 "PA:" 줄로 끝나고, 그 전의 두 번째 이후 "Access VA:" 는 Fault / Walk 뒤의 재시도이므로
+    첫 시도만 세어 -s JSON 의 accesses / tlb_misses 와 같은 기준으로 맞춥니다.
     """
     stats = {
         "total_access": 0,
@@ -39,13 +53,21 @@ def parse_metrics(log_file):
         "pt_miss": 0 # Page Fault (Page Table Miss)
     }
     
+    new_access = True   # 다음 "Access VA:" 가 새 접근의 첫 시도인지
+    first_attempt = False
     try:
         with open(log_file, 'r') as f:
             for line in f:
                 if "Access VA:" in line:
-                    stats["total_access"] += 1
+                    first_attempt = new_access
+                    new_access = False
+                    if first_attempt:
+                        stats["total_access"] += 1
+                elif line.startswith("PA:"):
+                    new_access = True
                 elif "TLB Miss:" in line:
-                    stats["tlb_miss"] += 1
+                    if first_attempt:
+                        stats["tlb_miss"] += 1
                 elif "Page Table Miss:" in line:
                     stats["pt_miss"] += 1
     except FileNotFoundError:
@@ -102,8 +124,12 @@ def plot_performance_metrics(log_dir):
     page_fault_rates = []
     
     for scenario in SCENARIOS:
-        log_path = os.path.join(log_dir, f"output_{scenario}")
-        res = parse_metrics(log_path)
+        # 1순위: 요약 파일 (simulator -s stats_<scenario>.json), 2순위: 로그 파싱
+        stats_path = os.path.join(log_dir, f"stats_{scenario}.json")
+        res = load_stats_summary(stats_path)
+        if res is None:
+            log_path = os.path.join(log_dir, f"output_{scenario}")
+            res = parse_metrics(log_path)
         if res:
             tlb_miss_rates.append(res[0])
             page_fault_rates.append(res[1])
@@ -145,4 +171,4 @@ if __name__ == "__main__":
     print("Generating Graphs...")
     plot_access_frequency(args.input_dir)
     plot_performance_metrics(args.log_dir)
-    print("Done.")₩
\ No newline at end of file
+    print("Done.")
\ No newline at end of file
@@ -2,35 +2,182 @@
 #include <stdlib.h>
 #include <string.h>
 #include <unistd.h> // getopt
+#include <time.h>   // clock_gettime
 
 #include "common.h"
-#include "log.h"
-#include "memory.h"
-#include "tlb.h"
-#include "page_table.h"
-#include "swap.h"
-
-// 전역 변수 정의
-Policy g_policy = POLICY_RR; // 기본값 RR
-uint64_t g_time = 0;         // 시뮬레이션 시간
+#include "sim.h"
+#include "trace.h"
+#include "stats.h"
+#include "geometry.h"
+#include "stack_distance.h"
+#include "sweep.h"
 
 // 명령줄 인자 저장용 변수
 char *policy_str = NULL;
 char *input_file = NULL;
 char *output_file = NULL;
+char *level_str = NULL;
+bool binary_log = false;
+char *stats_file = NULL;
+char *timeseries_file = NULL;
+uint64_t stats_window = 0;
+char *geometry_str = NULL;
+char *mrc_file = NULL;
+char *sweep_file = NULL;
+char *tlb_sizes_str = NULL;
+char *frame_counts_str = NULL;
+int sweep_threads = 0;
+uint64_t core_quantum = 0;
+char *swap_file = NULL;
+char *checkpoint_file = NULL;
+char *restore_file = NULL;
+uint64_t stop_after = 0;
+char *sampling_spec = NULL;
+char *estimate_file = NULL;
+char *profile_mode = NULL;
 
 void print_usage(const char *prog_name) {
-    fprintf(stderr, "Usage: %s -p <policy> -f <input_file> -l <output_file>\n", prog_name);
-    fprintf(stderr, "  -p: replacement policy (RR or LRU)\n");
-    fprintf(stderr, "  -f: input test case file\n");
+    fprintf(stderr, "Usage: %s -p <policy> -f <input_file> -l <output_file> [-v <level>] [-b]\n"
+                    "          [-s <stats_file>] [-w <window> -t <timeseries_file>] [-g <geometry>] [-W <swap_file>]\n"
+                    "          [-R <checkpoint>] [-N <records>] [-C <checkpoint>]\n"
+                    "          [-P <period>,<window>[,<warmup>] [-E <estimate_file>]] [-X <time|perf>]\n"
+                    "       %s -D <mrc_csv> -f <input_file> [-g <geometry>]\n"
+                    "       %s -S <results_csv> -f <trace,...> [-p <policy,...>] [-T <tlb,...>]\n"
+                    "          [-M <frames,...>] [-j <threads>] [-g <geometry>]\n"
+                    "       %s -p <policy> -f <trace,...> -l <output_file> -g cores=<n>,... [-j <threads>] [-Q <quantum>]\n",
+            prog_name, prog_name, prog_name, prog_name);
+    fprintf(stderr, "  -p: replacement policy (RR, LRU, CLOCK, CLOCK-PRO, 2Q, ARC, OPT)\n");
+    fprintf(stderr, "      OPT loads the whole trace and builds a next-use index first\n");
+    fprintf(stderr, "      CLOCK / CLOCK-PRO / 2Q / ARC replace frames only; the TLB then uses LRU\n");
+    fprintf(stderr, "  -f: input test case file (hex text or binary trace)\n");
+    fprintf(stderr, "      '-' or a pipe: binary trace streamed in order (e.g. trace_gen zipf:n=1G | %s -f - ...)\n", prog_name);
+    fprintf(stderr, "      gen:<kind>[:key=value...]: synthetic workload generated in-process, no file\n");
+    fprintf(stderr, "      (uniform, zipf, stride, loop, phase; see trace_gen for the keys)\n");
+    fprintf(stderr, "      multiprocess text traces: '@<pid>' switches context, '<pid>:<addr>' tags one line\n");
+    fprintf(stderr, "      writes: 'W:<addr>' (or '<pid>:W:<addr>'); other lines are reads\n");
     fprintf(stderr, "  -l: output log file\n");
+    fprintf(stderr, "  -W: swap device file holding evicted dirty pages (default: anonymous temp file)\n");
+    fprintf(stderr, "  -C: save the full simulator state and trace position at the end of the run\n");
+    fprintf(stderr, "  -R: resume from a checkpoint (same geometry and policy) at its trace position\n");
+    fprintf(stderr, "  -N: stop once <records> trace records are done (counted from the trace start)\n");
+    fprintf(stderr, "      e.g. warm up once with -N 1000000 -C warm.ckpt, then branch runs with -R warm.ckpt\n");
+    fprintf(stderr, "  -P: sampled simulation: every <period> records, fast-forward (residency and\n");
+    fprintf(stderr, "      replacement only) and then simulate <window> records in detail, measuring\n");
+    fprintf(stderr, "      all but the first <warmup> (default window/10); prints whole-trace estimates\n");
+    fprintf(stderr, "      with 95%% confidence intervals. -s / -l then cover the detailed windows only\n");
+    fprintf(stderr, "  -E: write the sampling estimates (JSON, or CSV if the name ends in .csv)\n");
+    fprintf(stderr, "  -X: per-stage timing breakdown and latency histograms at exit (time), plus\n");
+    fprintf(stderr, "      hardware counters per stage via perf_event_open (perf, much slower)\n");
+    fprintf(stderr, "      needs a build with make PROFILE=1 (otherwise the stages are not instrumented)\n");
+    fprintf(stderr, "  -v: log level (none, summary, full). default: full\n");
+    fprintf(stderr, "  -b: write binary event records (decode with log_decode)\n");
+    fprintf(stderr, "  -s: write end-of-run counters (JSON, or CSV if the name ends in .csv)\n");
+    fprintf(stderr, "  -w: time series window in accesses (requires -t)\n");
+    fprintf(stderr, "  -t: time series CSV file, one row every <window> accesses\n");
+    fprintf(stderr, "  -g: memory geometry: preset (12bit, x86-32, x86-64, x86-64-5level)\n");
+    fprintf(stderr, "      and/or key=value list (va, page, levels, split, pte, mem, tlb)\n");
+    fprintf(stderr, "      TLB hierarchy: tlb_ways, l2tlb, l2tlb_ways, tlb_policy, l2tlb_policy\n");
+    fprintf(stderr, "      tlb_asid=0: untagged TLB, flushed on every context switch\n");
+    fprintf(stderr, "      multicore: cores, shootdown (sync, lazy), reclaim_batch\n");
+    fprintf(stderr, "      pwc=<n>: page walk cache, n entries per upper level (default 0 = off)\n");
+    fprintf(stderr, "      superpage=<k>: PTEs k levels above the leaf may map huge pages (default 0 = off)\n");
+    fprintf(stderr, "      sp_promote=<pct>: promote once pct%% of a region is resident (default 50)\n");
+    fprintf(stderr, "      prefetch=none|seq|stride|markov: map predicted pages on a fault (default none)\n");
+    fprintf(stderr, "      prefetch_depth=<n>: pages per fault (default 4), prefetch_table=<n>: markov entries (default 4096)\n");
+    fprintf(stderr, "      pt_reclaim=1: free page table frames once their last entry is unmapped\n");
+    fprintf(stderr, "      slow_mem=<size>: second, slower frame tier behind mem (default 0 = off), lat_slow=<cycles>\n");
+    fprintf(stderr, "      (default 300); every tier_epoch accesses (default 10000) up to tier_batch pages\n");
+    fprintf(stderr, "      (default 32) with at least tier_hot accesses (default 2) move to DRAM, colder pages move out\n");
+    fprintf(stderr, "      latency in cycles: lat_tlb, lat_l2tlb, lat_pwc, lat_mem, lat_fault, lat_swap\n");
+    fprintf(stderr, "      (default 1, 7, 2, 100, 2000, 200000; used for total cycles / AMAT only)\n");
+    fprintf(stderr, "      (ways 0 = fully associative, policy defaults to -p)\n");
+    fprintf(stderr, "      e.g. -g x86-64,mem=4G,tlb=64,tlb_ways=4,l2tlb=1536,l2tlb_ways=12\n");
+    fprintf(stderr, "      default: 12bit\n");
+    fprintf(stderr, "  -D: stack-distance mode: one pass over the trace, writes LRU TLB misses\n");
+    fprintf(stderr, "      and page faults for every TLB size / frame count (no simulation)\n");
+    fprintf(stderr, "      the TLB column ignores the shootdowns of swap-outs: it matches -p LRU exactly\n");
+    fprintf(stderr, "      only while no page is evicted (otherwise it undercounts the misses)\n");
+    fprintf(stderr, "  -S: sweep mode: run every trace x policy x TLB size x frame count\n");
+    fprintf(stderr, "      combination in parallel and write one CSV row per run\n");
+    fprintf(stderr, "      (-f / -p / -T / -M take comma lists, -j sets the worker count)\n");
+    fprintf(stderr, "  multicore (-g cores=<n>): -f takes one trace per core, -j threads run the\n");
+    fprintf(stderr, "      cores' TLB hits in parallel, -Q accesses per core per epoch (default %d)\n", CORE_QUANTUM);
+    fprintf(stderr, "      results do not depend on -j; per-access logs are not written\n");
+}
+
+// 종료 시 시계열 / 요약 출력
+static void write_results(SimContext *ctx, Policy policy) {
+    uint64_t cycles = stats_total_cycles(&ctx->stats);
+    fprintf(stderr, "[Latency] %llu cycles, AMAT %.2f cycles/access\n", (unsigned long long)cycles,
+            ctx->stats.accesses ? (double)cycles / ctx->stats.accesses : 0.0);
+    if (ctx->geo.pt_reclaim) {
+        const Stats *st = &ctx->stats;
+        fprintf(stderr, "[Page tables] %llu allocated, %llu freed (%llu bytes reclaimed), %llu live, peak %llu\n",
+                (unsigned long long)st->table_frame_allocs, (unsigned long long)st->pt_tables_freed,
+                (unsigned long long)st->pt_bytes_reclaimed,
+                (unsigned long long)(st->table_frame_allocs - st->pt_tables_freed),
+                (unsigned long long)st->pt_tables_peak);
+    }
+    if (ctx->geo.slow_mem_size) {
+        const Stats *st = &ctx->stats;
+        fprintf(stderr, "[Tier] %llu DRAM / %llu slow accesses, %llu promotions, %llu demotions, "
+                "effective access time %.2f cycles\n",
+                (unsigned long long)(st->accesses - st->tier_slow_accesses),
+                (unsigned long long)st->tier_slow_accesses, (unsigned long long)st->tier_promotions,
+                (unsigned long long)st->tier_demotions,
+                st->accesses ? (double)(st->cycles_data + st->cycles_migrate) / st->accesses : 0.0);
+    }
+    stats_close_timeseries(&ctx->series, &ctx->stats);
+    if (stats_file) {
+        CoreStats *cores = malloc(sizeof(CoreStats) * ctx->num_cores);
+        for (int c = 0; cores && c < ctx->num_cores; c++) cores[c] = ctx->cores[c].stats;
+        stats_write_summary(&ctx->stats, ctx->proc.stats, ctx->proc.count,
+                            cores, cores ? ctx->num_cores : 0, policy, stats_file);
+        free(cores);
+    }
+}
+
+// 다중 코어: -f 의 트레이스를 코어마다 하나씩 메모리에 올려 동시에 실행
+static int run_multicore(SimContext *ctx) {
+    int n = ctx->num_cores;
+    Trace *traces = calloc(n, sizeof(Trace));
+    char *list = strdup(input_file);
+    int loaded = 0, given = 0;
+    int status = EXIT_FAILURE;
+
+    for (char *tok = strtok(list, ","); tok; tok = strtok(NULL, ",")) {
+        if (given++ >= n) continue;
+        if (trace_load(&traces[loaded], tok) != 0) goto out;
+        loaded++;
+    }
+    if (given != n) {
+        fprintf(stderr, "Multicore: %d cores need %d traces (-f core0,core1,...), got %d\n", n, n, given);
+        goto out;
+    }
+
+    struct timespec t_start, t_end;
+    clock_gettime(CLOCK_MONOTONIC, &t_start);
+    if (sim_run_cores(ctx, traces, sweep_threads, core_quantum) == 0) status = EXIT_SUCCESS;
+    clock_gettime(CLOCK_MONOTONIC, &t_end);
+
+    double elapsed = (t_end.tv_sec - t_start.tv_sec) + (t_end.tv_nsec - t_start.tv_nsec) / 1e9;
+    uint64_t total = 0;
+    for (int c = 0; c < n; c++) total += traces[c].count;
+    fprintf(stderr, "[Trace] %d cores: %llu records in %.3f s (%.0f records/s)\n",
+            n, (unsigned long long)total, elapsed, elapsed > 0 ? total / elapsed : 0.0);
+
+out:
+    for (int c = 0; c < loaded; c++) trace_close(&traces[c]);
+    free(traces);
+    free(list);
+    return status;
 }
 
 int main(int argc, char *argv[]) {
     int opt;
 
     // 1. 명령줄 인자 파싱 (getopt 사용)
-    while ((opt = getopt(argc, argv, "p:f:l:")) != -1) {
+    while ((opt = getopt(argc, argv, "p:f:l:v:bs:w:t:g:D:S:T:M:j:Q:W:C:R:N:P:E:X:")) != -1) {
         switch (opt) {
             case 'p':
                 policy_str = optarg;
@@ -41,132 +188,294 @@ int main(int argc, char *argv[]) {
             case 'l':
                 output_file = optarg;
                 break;
+            case 'v':
+                level_str = optarg;
+                break;
+            case 'b':
+                binary_log = true;
+                break;
+            case 's':
+                stats_file = optarg;
+                break;
+            case 'w':
+                stats_window = strtoull(optarg, NULL, 0);
+                break;
+            case 't':
+                timeseries_file = optarg;
+                break;
+            case 'g':
+                geometry_str = optarg;
+                break;
+            case 'D':
+                mrc_file = optarg;
+                break;
+            case 'S':
+                sweep_file = optarg;
+                break;
+            case 'T':
+                tlb_sizes_str = optarg;
+                break;
+            case 'M':
+                frame_counts_str = optarg;
+                break;
+            case 'j':
+                sweep_threads = atoi(optarg);
+                break;
+            case 'Q':
+                core_quantum = strtoull(optarg, NULL, 0);
+                break;
+            case 'W':
+                swap_file = optarg;
+                break;
+            case 'C':
+                checkpoint_file = optarg;
+                break;
+            case 'R':
+                restore_file = optarg;
+                break;
+            case 'N':
+                stop_after = strtoull(optarg, NULL, 0);
+                break;
+            case 'P':
+                sampling_spec = optarg;
+                break;
+            case 'E':
+                estimate_file = optarg;
+                break;
+            case 'X':
+                profile_mode = optarg;
+                break;
             default:
                 print_usage(argv[0]);
                 exit(EXIT_FAILURE);
         }
     }
 
-    // 필수 인자 확인
-    if (!policy_str || !input_file || !output_file) {
+    // 필수 인자 확인 (-D / -S 모드는 정책/로그 불필요)
+    if (!input_file || (!mrc_file && !sweep_file && (!policy_str || !output_file)) ||
+        (stats_window > 0) != (timeseries_file != NULL)) {
         print_usage(argv[0]);
         exit(EXIT_FAILURE);
     }
 
-    // 정책 설정
-    if (strcmp(policy_str, "RR") == 0) {
-        g_policy = POLICY_RR;
-    } else if (strcmp(policy_str, "LRU") == 0) {
-        g_policy = POLICY_LRU;
+    if (profile_mode && strcmp(profile_mode, "time") != 0 && strcmp(profile_mode, "perf") != 0) {
+        print_usage(argv[0]);
+        exit(EXIT_FAILURE);
+    }
+#ifndef SIM_PROFILE
+    if (profile_mode) {
+        fprintf(stderr, "Error: -X needs a simulator built with make PROFILE=1 (run make clean first).\n");
+        exit(EXIT_FAILURE);
+    }
+#endif
+
+    SamplingState sampling;
+    if ((sampling_spec && sampling_parse(&sampling, sampling_spec) != 0) || (estimate_file && !sampling_spec)) {
+        print_usage(argv[0]);
+        exit(EXIT_FAILURE);
+    }
+
+    // 메모리 구조 설정
+    Geometry geo;
+    if (geometry_str) {
+        if (geometry_parse(&geo, geometry_str) != 0) {
+            exit(EXIT_FAILURE);
+        }
+        geometry_print(&geo, stderr);
     } else {
+        geometry_default(&geo);
+    }
+
+    // Sweep 모드: 정책 목록은 콤마 구분 (생략 시 전체 정책)
+    if (sweep_file) {
+        SweepSpec spec = {
+            .traces = input_file,
+            .policies = policy_str,
+            .tlb_sizes = tlb_sizes_str,
+            .frame_counts = frame_counts_str,
+            .threads = sweep_threads,
+        };
+        return run_sweep(&geo, &spec, sweep_file) == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+    // 정책 설정
+    Policy policy = POLICY_LRU;
+    if (policy_str && policy_parse(policy_str, &policy) != 0) {
         print_usage(argv[0]);
         exit(EXIT_FAILURE);
     }
 
-    // 2. 초기화 (로그, 메모리, TLB)
-    open_log_file(output_file);
-    init_memory();
-    init_tlb();
-    
-    // 3. 입력 파일 열기
-    FILE *fp = fopen(input_file, "r");
-    if (!fp) {
-        perror("Failed to open input file");
-        close_log_file();
+    // 로그 레벨 설정
+    int log_level = LOG_LEVEL_FULL;
+    if (level_str) {
+        if (strcmp(level_str, "none") == 0) {
+            log_level = LOG_LEVEL_NONE;
+        } else if (strcmp(level_str, "summary") == 0) {
+            log_level = LOG_LEVEL_SUMMARY;
+        } else if (strcmp(level_str, "full") == 0) {
+            log_level = LOG_LEVEL_FULL;
+        } else {
+            print_usage(argv[0]);
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    // Stack Distance 모드: 시뮬레이션 없이 한 번의 pass 로 크기별 곡선 출력
+    if (mrc_file) {
+        Trace trace;
+        if (trace_open(&trace, input_file) != 0) {
+            exit(EXIT_FAILURE);
+        }
+        int ret = run_stack_distance(&geo, &trace, mrc_file);
+        trace_close(&trace);
+        return ret == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+    // 바이너리 로그 피연산자 폭: 주소와 PFN 이 모두 들어가는 최소 바이트 수
+    int addr_bits = geo.va_bits > geo.pte_bytes * 8 ? geo.va_bits : geo.pte_bytes * 8;
+    int value_bytes = addr_bits <= 16 ? 2 : (addr_bits <= 32 ? 4 : 8);
+
+    // 2. 초기화 (메모리, TLB, 로그)
+    SimContext *ctx = sim_create(&geo, policy);
+    if (!ctx) {
+        perror("Failed to allocate simulator");
+        exit(EXIT_FAILURE);
+    }
+    open_log_file_ex(&ctx->log, output_file, log_level,
+                     binary_log ? LOG_FORMAT_BINARY : LOG_FORMAT_TEXT, value_bytes);
+    sim_set_batch_logging(ctx, true);
+    if (timeseries_file) {
+        stats_open_timeseries(&ctx->series, timeseries_file, stats_window);
+    }
+    if (swap_file && sim_set_swap_file(ctx, swap_file) != 0) {
+        sim_free(ctx);
         exit(EXIT_FAILURE);
     }
 
-    int total_accesses = 0;
-    // 첫 줄: 총 접근 횟수 읽기
-    if (fscanf(fp, "%d", &total_accesses) != 1) {
-        fprintf(stderr, "Invalid input file format.\n");
-        fclose(fp);
-        close_log_file();
+    if (ctx->num_cores > 1) {
+        if (checkpoint_file || restore_file || stop_after || sampling_spec || profile_mode) {
+            fprintf(stderr, "Error: -C / -R / -N / -P / -X need a single core (one trace position).\n");
+            sim_free(ctx);
+            exit(EXIT_FAILURE);
+        }
+        int status = run_multicore(ctx);
+        write_results(ctx, policy);
+        sim_free(ctx);
+        return status;
+    }
+
+    // 3. 입력 파일 열기 (바이너리 트레이스면 mmap, 아니면 텍스트 Fallback)
+    // [OPT] 다음 사용 인덱스를 만들려면 트레이스 전체가 메모리에 있어야 함
+    Trace trace;
+    uint32_t *next_use = NULL;
+    bool use_opt = sim_uses_opt(&geo, policy);
+    if ((use_opt ? trace_load(&trace, input_file) : trace_open(&trace, input_file)) != 0) {
+        sim_free(ctx);
         exit(EXIT_FAILURE);
     }
+    if (use_opt) {
+        next_use = build_next_use(&geo, &trace);
+        if (!next_use) {
+            trace_close(&trace);
+            sim_free(ctx);
+            exit(EXIT_FAILURE);
+        }
+        sim_set_future(ctx, next_use, trace.count);
+    }
+
+    // 체크포인트에서 이어가기: 상태를 덮어쓰고 트레이스를 저장 당시 위치로
+    uint64_t done = 0; // 처리한 트레이스 레코드 수
+    if (restore_file) {
+        bool ok = sim_load_checkpoint(ctx, restore_file, &done) == 0;
+        if (ok && !trace_skip(&trace, done)) {
+            fprintf(stderr, "Error: trace is shorter than the checkpoint position %llu.\n",
+                    (unsigned long long)done);
+            ok = false;
+        }
+        if (!ok) {
+            trace_close(&trace);
+            free(next_use);
+            sim_free(ctx);
+            exit(EXIT_FAILURE);
+        }
+        fprintf(stderr, "[Checkpoint] resumed from %s at record %llu\n", restore_file, (unsigned long long)done);
+    }
+    uint64_t start = done;
+    uint64_t limit = stop_after ? stop_after : UINT64_MAX;
+
+    // -X: 트레이스 읽기부터 마지막 변환까지를 단계별로 (OPT 인덱스 / 체크포인트 복원은 제외)
+    Profiler prof;
+    if (profile_mode) {
+        prof_init(&prof, strcmp(profile_mode, "perf") == 0);
+        prof_start(&prof);
+    }
 
-    // 4. Main Simulation Loop
-    uint32_t va_temp; // fscanf는 32bit로 읽음
+    struct timespec t_start, t_end;
+    clock_gettime(CLOCK_MONOTONIC, &t_start);
+
+    // 4. Main Simulation Loop (TRANSLATE_CHUNK 개씩 모아서 translate_batch)
+    // 묶음은 pid 가 같은 구간까지만: pending 은 아직 처리하지 않은 다음 레코드
+    // -N 의 위치에 닿으면 그 뒤 레코드는 읽지 않음 (체크포인트의 위치가 정확하도록)
+    static uint64_t va[TRANSLATE_CHUNK];
+    static uint8_t write[TRANSLATE_CHUNK];
+    int status = EXIT_SUCCESS;
+    uint64_t pending;
+    PROF_ENTER(PROF_TRACE);
+    bool have = done < limit && trace_next(&trace, &pending);
+    PROF_EXIT(PROF_TRACE);
     
-    // 파일에서 주소를 하나씩 읽음
-    while (fscanf(fp, "%x", &va_temp) == 1) {
-        uint16_t va = (uint16_t)va_temp;
-        uint16_t vpn = GET_FULL_VPN(va);
-        uint16_t offset = GET_OFFSET(va);
-
-        // [LRU] 시간 증가 (메모리 접근 1회 = 시간 1 흐름)
-        g_time++;
-
-        // State Machine Loop
-        while (1) {
-            // (1) Access VA 로그 출력
-            log_va_access(va);
-
-            // (2) TLB Lookup
-            int pfn = search_tlb(vpn); 
-
-            if (pfn != -1) {
-                // --- Case A: TLB Hit ---
-                // [LRU] 데이터 페이지 접근 시간 갱신
-                if (g_policy == POLICY_LRU) {
-                    acknowledge_frame_access(pfn);
-                }
-
-                // (4) PA 계산 및 출력
-                uint16_t pa = (pfn << 3) | offset;
-                log_pa_result(pa);
-                
-                break; // 처리 완료
-            } 
-            else {
-                // --- Case B: TLB Miss ---
-                
-                // (5) Page Table Lookup
-                PT_Result pt_res = walk_page_table(va); 
-
-                if (pt_res.hit) {
-                    // --- Case B-1: Page Table Hit ---
-                    update_tlb(vpn, pt_res.pfn);
-                    
-                    // [LRU] 여기서도 페이지 접근으로 칠 수 있지만, 
-                    // 루프를 돌아 TLB Hit가 될 때 acknowledge_frame_access가 호출되므로 
-                    // 여기서는 생략해도 무방하거나, 혹은 명시적으로 호출해도 됩니다.
-                    // 구조상 continue 후 TLB Hit에서 처리됩니다.
-                    
-                    continue; // Retry
-                } 
-                else {
-                    // --- Case B-2: Page Table Miss (Page Fault) ---
-                    
-                    // (6) Allocate Free Frame (or Swap)
-                    int new_pfn = allocate_free_frame(vpn, true); 
-                    
-                    if (new_pfn == -1) {
-                        // Memory Full -> Swap Out 발생
-                        new_pfn = swap_out(); 
-                        
-                        // 다시 할당 시도
-                        int retry_pfn = allocate_free_frame(vpn, true);
-                        if (retry_pfn == -1) {
-                            fprintf(stderr, "Critical Error: Memory allocation failed even after swap.\n");
-                            exit(1);
-                        }
-                        new_pfn = retry_pfn;
-                    }
-
-                    // (7) Update Page Table & TLB
-                    update_page_table(va, new_pfn);
-                    update_tlb(vpn, new_pfn);
-                    
-                    continue; // Retry
-                }
-            }
+    while (have && status == EXIT_SUCCESS) {
+        int pid = trace.pid;
+        if (sim_switch_process(ctx, pid) != 0) {
+            status = EXIT_FAILURE;
+            break;
         }
+        size_t n = 0;
+        do {
+            write[n] = trace.write; // trace.write 는 pending 레코드의 종류
+            va[n++] = pending;
+            PROF_ENTER(PROF_TRACE);
+            have = done + n < limit && trace_next(&trace, &pending);
+            PROF_EXIT(PROF_TRACE);
+        } while (have && trace.pid == pid && n < TRANSLATE_CHUNK);
+        size_t ok = sampling_spec ? sampling_run(ctx, &sampling, va, write, n)
+                                  : translate_batch_rw(ctx, va, write, NULL, n);
+        if (ok != n) status = EXIT_FAILURE;
+        done += n;
     }
 
     // 5. 종료 처리
-    fclose(fp);
-    close_log_file();
+    clock_gettime(CLOCK_MONOTONIC, &t_end);
+    if (profile_mode) {
+        prof_stop(&prof);
+        prof.accesses = done - start;
+    }
+    double elapsed = (t_end.tv_sec - t_start.tv_sec) + (t_end.tv_nsec - t_start.tv_nsec) / 1e9;
+    fprintf(stderr, "[Trace] %s: %llu records in %.3f s (%.0f records/s)\n",
+            trace_format_name(&trace), (unsigned long long)(done - start), elapsed,
+            elapsed > 0 ? (done - start) / elapsed : 0.0);
+
+    if (sampling_spec) {
+        sampling_print(&sampling, stderr);
+        if (estimate_file && sampling_write_summary(&sampling, estimate_file) != 0) status = EXIT_FAILURE;
+    }
+
+    if (checkpoint_file && status == EXIT_SUCCESS) {
+        if (sim_save_checkpoint(ctx, checkpoint_file, done) == 0) {
+            fprintf(stderr, "[Checkpoint] saved %s at record %llu\n", checkpoint_file, (unsigned long long)done);
+        } else {
+            status = EXIT_FAILURE;
+        }
+    }
+
+    trace_close(&trace);
+    free(next_use);
+    write_results(ctx, policy);
+    if (profile_mode) {
+        prof_print(&prof, stderr);
+        prof_destroy(&prof);
+    }
+    sim_free(ctx);
     
-    return 0;
-}
\ No newline at end of file
+    return status;
+}
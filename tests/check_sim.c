@@ -0,0 +1,240 @@
+/* tests/check_sim.c
+ * 시뮬레이터 불변식 검사 (make check)
+ *   shadow:     쓰기마다 (va -> 값) 을 따로 기억해 두고, 모든 접근에서 변환된 PA 의 프레임 내용과
+ *               Reverse Mapping 이 맞는지 확인 (스왑 장치 / 계층 이동 / 테이블 회수를 거쳐도 내용 보존)
+ *   checkpoint: 처음부터 끝까지 한 번에 돌린 결과와, 중간에 체크포인트를 저장하고 새 인스턴스에서
+ *               이어 돌린 결과의 변환 (PA) 과 카운터 (Stats) 가 같은지 확인
+ *   tier split: 전체 용량은 같고 계층 분할만 다른 구성에서 스왑 아웃 수가 같은지 확인
+ *               (계층 이동이 교체 정책 상태를 페이지와 함께 옮기면 정책이 보는 페이지 집합은 같음)
+ * geometry x 정책 조합마다 합성 워크로드 (workload.h) 를 메모리에 올려 실행. 실패가 하나라도 있으면 종료 코드 1
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h> // mkstemp, unlink
+
+#include "sim.h"
+
+#define CHECK_TRACE "gen:zipf:s=0.8:pages=1536:page=4096:n=60000:seed=3"
+
+// 용량보다 큰 footprint (스왑) 에 계층 이동 / 테이블 회수 / PWC / prefetch 를 섞은 조합
+static const char *geometries[] = {
+    "x86-64,mem=1M",
+    "x86-64,mem=512K,slow_mem=1M,tier_epoch=2000,tier_batch=16",
+    "x86-64,mem=512K,slow_mem=512K,tier_epoch=1000,pt_reclaim=1,pwc=16",
+    "x86-64,mem=1M,slow_mem=1M,tier_epoch=3000,prefetch=stride,reclaim_batch=4",
+    "12bit,mem=512,slow_mem=256,tier_epoch=500", // PTE 에 Dirty 비트 없음 (프레임별 Dirty)
+};
+#define NUM_GEOMETRIES (sizeof(geometries) / sizeof(geometries[0]))
+
+// { 단일 계층, 같은 전체 용량의 2계층 }. RR / CLOCK 은 hand 가 프레임 위치를 돌므로 제외
+static const char *split_geometries[][2] = {
+    { "x86-64,mem=1M", "x86-64,mem=512K,slow_mem=512K,tier_epoch=1000,tier_hot=1" },
+    { "12bit,mem=768", "12bit,mem=512,slow_mem=256,tier_epoch=16,tier_hot=1" },
+};
+#define NUM_SPLITS (sizeof(split_geometries) / sizeof(split_geometries[0]))
+
+static int failures = 0;
+
+#define FAIL(...) do { \
+    fprintf(stderr, "  FAIL: " __VA_ARGS__); \
+    failures++; \
+} while (0)
+
+// 접근 i 가 쓰기인지 (트레이스에 쓰기 정보가 없으므로 i 에서 정함, 약 1/4)
+static bool is_write(uint64_t i) {
+    return ((i * 0x9E3779B97F4A7C15ULL) >> 61) < 2;
+}
+
+typedef struct {
+    Geometry geo;
+    Policy policy;
+    const Trace *trace;
+    const uint32_t *next_use; // OPT 일 때만
+} RunSpec;
+
+static SimContext* new_ctx(const RunSpec *r) {
+    SimContext *ctx = sim_create(&r->geo, r->policy);
+    if (!ctx) {
+        perror("sim_create");
+        exit(EXIT_FAILURE);
+    }
+    if (r->next_use) sim_set_future(ctx, r->next_use, r->trace->count);
+    return ctx;
+}
+
+// 접근 [from, to) 를 하나씩 실행하고 pa 에 기록. shadow 가 있으면 내용 / 소유자 확인
+// 반환값: 실패 없이 끝났으면 true
+static bool run_range(SimContext *ctx, const RunSpec *r, uint64_t from, uint64_t to,
+                      uint64_t *pa, uint8_t *shadow, uint8_t *written) {
+    const Geometry *geo = &ctx->geo;
+    uint64_t page_mask = (1ULL << geo->offset_bits) - 1;
+    for (uint64_t i = from; i < to; i++) {
+        uint64_t va = trace_get(r->trace, i) & geo->va_mask;
+        bool w = is_write(i);
+        if (sim_access_rw(ctx, va, w, &pa[i]) != 0) {
+            FAIL("access %llu failed\n", (unsigned long long)i);
+            return false;
+        }
+        if (!shadow) continue;
+
+        int pfn = (int)(pa[i] >> geo->offset_bits);
+        // 기존 동작: 테이블 할당이 방금 적재한 페이지의 프레임을 가져간 접근 (sim.c 도 내용을 쓰지 않음)
+        if (!is_frame_swappable(ctx, pfn)) continue;
+        uint64_t key = ctx->proc.key_base | GET_FULL_VPN(geo, va);
+        if (get_frame_owner(ctx, pfn) != key) {
+            FAIL("access %llu: frame %d owned by key 0x%llx, expected 0x%llx\n", (unsigned long long)i, pfn,
+                 (unsigned long long)get_frame_owner(ctx, pfn), (unsigned long long)key);
+            return false;
+        }
+        uint8_t got = get_frame_ptr(ctx, pfn)[pa[i] & page_mask];
+        if (w) {
+            shadow[va] = (uint8_t)ctx->time; // 시뮬레이터가 쓰는 값: 접근 시각의 하위 바이트
+            written[va] = 1;
+        }
+        uint8_t want = written[va] ? shadow[va] : 0;
+        if (got != want) {
+            FAIL("access %llu (va 0x%llx, %s): frame %d holds 0x%02x, expected 0x%02x\n", (unsigned long long)i,
+                 (unsigned long long)va, w ? "write" : "read", pfn, got, want);
+            return false;
+        }
+    }
+    return true;
+}
+
+static void check_one(const RunSpec *r, uint64_t span) {
+    uint64_t n = r->trace->count;
+    uint64_t *pa_full = malloc(sizeof(uint64_t) * n);
+    uint64_t *pa_split = malloc(sizeof(uint64_t) * n);
+    uint8_t *shadow = calloc(span, 1);
+    uint8_t *written = calloc(span, 1);
+    if (!pa_full || !pa_split || !shadow || !written) {
+        perror("malloc");
+        exit(EXIT_FAILURE);
+    }
+
+    // 1. 한 번에 끝까지 (shadow 검사)
+    SimContext *full = new_ctx(r);
+    bool ok = run_range(full, r, 0, n, pa_full, shadow, written);
+
+    // 2. 절반에서 체크포인트 -> 새 인스턴스에서 복원해 나머지
+    char path[] = "/tmp/check_sim_XXXXXX";
+    int fd = mkstemp(path);
+    if (fd < 0) {
+        perror("mkstemp");
+        exit(EXIT_FAILURE);
+    }
+    close(fd);
+
+    uint64_t half = n / 2, pos = 0;
+    SimContext *first = new_ctx(r);
+    SimContext *second = new_ctx(r);
+    if (ok && run_range(first, r, 0, half, pa_split, NULL, NULL)) {
+        if (sim_save_checkpoint(first, path, half) != 0 || sim_load_checkpoint(second, path, &pos) != 0) {
+            FAIL("checkpoint save / load failed\n");
+        } else if (pos != half) {
+            FAIL("checkpoint position %llu, expected %llu\n", (unsigned long long)pos, (unsigned long long)half);
+        } else if (run_range(second, r, half, n, pa_split, NULL, NULL)) {
+            for (uint64_t i = 0; i < n; i++) {
+                if (pa_full[i] != pa_split[i]) {
+                    FAIL("access %llu: resumed run translated to 0x%llx, full run 0x%llx\n", (unsigned long long)i,
+                         (unsigned long long)pa_split[i], (unsigned long long)pa_full[i]);
+                    break;
+                }
+            }
+            // Stats 는 uint64_t 만 있어 바이트 비교로 충분
+            if (memcmp(&full->stats, &second->stats, sizeof(Stats)) != 0) {
+                FAIL("resumed run counters differ from the full run\n");
+            }
+        }
+    }
+
+    unlink(path);
+    sim_free(full);
+    sim_free(first);
+    sim_free(second);
+    free(pa_full);
+    free(pa_split);
+    free(shadow);
+    free(written);
+}
+
+// 정책마다 두 구성을 끝까지 돌려 swap_outs 비교 (분할 쪽에서 계층 이동이 일어났는지도 확인)
+static void check_tier_split(const Trace *trace, const char *const geo_spec[2]) {
+    RunSpec r[2];
+    for (int k = 0; k < 2; k++) {
+        r[k] = (RunSpec){ .trace = trace, .next_use = NULL };
+        if (geometry_parse(&r[k].geo, geo_spec[k]) != 0) exit(EXIT_FAILURE);
+    }
+    uint64_t *pa = malloc(sizeof(uint64_t) * trace->count);
+    if (!pa) {
+        perror("malloc");
+        exit(EXIT_FAILURE);
+    }
+    uint32_t *next_use = NULL;
+    for (int p = 0; p < POLICY_COUNT; p++) {
+        if (p == POLICY_RR || p == POLICY_CLOCK) continue;
+        int before = failures;
+        uint64_t swap_outs[2] = { 0, 0 }, promotions = 0;
+        for (int k = 0; k < 2; k++) {
+            r[k].policy = (Policy)p;
+            r[k].next_use = NULL;
+            if (sim_uses_opt(&r[k].geo, r[k].policy)) {
+                if (!next_use) next_use = build_next_use(&r[k].geo, trace);
+                if (!next_use) exit(EXIT_FAILURE);
+                r[k].next_use = next_use;
+            }
+            SimContext *ctx = new_ctx(&r[k]);
+            if (run_range(ctx, &r[k], 0, trace->count, pa, NULL, NULL)) {
+                swap_outs[k] = ctx->stats.swap_outs;
+                if (k == 1) promotions = ctx->stats.tier_promotions;
+            }
+            sim_free(ctx);
+        }
+        if (failures == before && !promotions) FAIL("no tier migration happened\n");
+        if (failures == before && swap_outs[0] != swap_outs[1]) {
+            FAIL("%llu swap-outs with one tier, %llu when split\n", (unsigned long long)swap_outs[0],
+                 (unsigned long long)swap_outs[1]);
+        }
+        printf("%-4s %-68s %s\n", failures == before ? "ok" : "FAIL", geo_spec[1], policy_name((Policy)p));
+    }
+    free(next_use);
+    free(pa);
+}
+
+int main(void) {
+    Trace trace;
+    if (trace_load(&trace, CHECK_TRACE) != 0) return EXIT_FAILURE;
+    uint64_t span = 0;
+    for (uint64_t i = 0; i < trace.count; i++) {
+        if (trace_get(&trace, i) >= span) span = trace_get(&trace, i) + 1;
+    }
+
+    for (size_t g = 0; g < NUM_GEOMETRIES; g++) {
+        RunSpec r = { .trace = &trace, .next_use = NULL };
+        if (geometry_parse(&r.geo, geometries[g]) != 0) return EXIT_FAILURE;
+        uint32_t *next_use = NULL;
+        for (int p = 0; p < POLICY_COUNT; p++) {
+            r.policy = (Policy)p;
+            r.next_use = NULL;
+            if (sim_uses_opt(&r.geo, r.policy)) {
+                if (!next_use) next_use = build_next_use(&r.geo, &trace);
+                if (!next_use) return EXIT_FAILURE;
+                r.next_use = next_use;
+            }
+            int before = failures;
+            check_one(&r, span);
+            printf("%-4s %-68s %s\n", failures == before ? "ok" : "FAIL", geometries[g], policy_name(r.policy));
+        }
+        free(next_use);
+    }
+    for (size_t s = 0; s < NUM_SPLITS; s++) check_tier_split(&trace, split_geometries[s]);
+
+    trace_close(&trace);
+    if (failures) {
+        printf("%d check(s) failed\n", failures);
+        return EXIT_FAILURE;
+    }
+    printf("all checks passed\n");
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,155 @@
+/* tools/trace_convert.c
+ * 기존 hex 텍스트 트레이스(input_*)를 바이너리 트레이스 포맷으로 변환
+ * -t 옵션을 주면 반대로 바이너리 -> 텍스트 변환 (검증용)
+ * 다중 프로세스 트레이스의 pid 는 양방향 모두 유지 (텍스트: "@pid" 표시, 바이너리: pid 배열)
+ * 쓰기 접근도 유지 (텍스트: "W:" 접두어, 바이너리: 쓰기 비트맵)
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h> // getopt
+
+#include "trace.h"
+
+static void print_usage(const char *prog_name) {
+    fprintf(stderr, "Usage: %s [-w <addr_bytes>] [-t] <input> <output>\n", prog_name);
+    fprintf(stderr, "  -w: record width in bytes (1, 2, 4, 8). default: smallest that fits\n");
+    fprintf(stderr, "  -t: write text format instead of binary\n");
+}
+
+static uint8_t width_for(uint64_t max_va) {
+    if (max_va <= 0xFF) return 1;
+    if (max_va <= 0xFFFF) return 2;
+    if (max_va <= 0xFFFFFFFFULL) return 4;
+    return 8;
+}
+
+int main(int argc, char *argv[]) {
+    int opt;
+    int forced_width = 0;
+    bool to_text = false;
+
+    while ((opt = getopt(argc, argv, "w:t")) != -1) {
+        switch (opt) {
+            case 'w':
+                forced_width = atoi(optarg);
+                break;
+            case 't':
+                to_text = true;
+                break;
+            default:
+                print_usage(argv[0]);
+                exit(EXIT_FAILURE);
+        }
+    }
+    if (optind + 2 != argc ||
+        !(forced_width == 0 || forced_width == 1 || forced_width == 2 ||
+          forced_width == 4 || forced_width == 8)) {
+        print_usage(argv[0]);
+        exit(EXIT_FAILURE);
+    }
+    const char *in_path = argv[optind];
+    const char *out_path = argv[optind + 1];
+
+    // 1. 입력 전체 읽기 (주소 폭을 정하려면 최댓값이 필요함)
+    Trace t;
+    if (trace_open(&t, in_path) != 0) exit(EXIT_FAILURE);
+
+    uint64_t cap = t.count > 0 ? t.count : 1024;
+    uint64_t n = 0, max_va = 0;
+    uint64_t *vas = malloc(cap * sizeof(uint64_t));
+    uint16_t *pids = malloc(cap * sizeof(uint16_t));
+    uint8_t *writes = calloc((cap + 7) / 8, 1);
+    bool multi = false, any_write = false;
+    uint64_t va;
+    while (vas && pids && writes && trace_next(&t, &va)) {
+        if (n == cap) {
+            size_t old_bytes = (cap + 7) / 8;
+            cap *= 2;
+            vas = realloc(vas, cap * sizeof(uint64_t));
+            pids = realloc(pids, cap * sizeof(uint16_t));
+            writes = realloc(writes, (cap + 7) / 8);
+            if (!vas || !pids || !writes) break;
+            memset(writes + old_bytes, 0, (cap + 7) / 8 - old_bytes);
+        }
+        pids[n] = t.pid;
+        if (t.write) writes[n / 8] |= (uint8_t)(1u << (n % 8));
+        vas[n++] = va;
+        if (va > max_va) max_va = va;
+        multi |= t.pid != 0;
+        any_write |= t.write;
+    }
+    trace_close(&t);
+    if (!vas || !pids || !writes) {
+        fprintf(stderr, "Out of memory.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    // 2. 출력
+    FILE *out = fopen(out_path, to_text ? "w" : "wb");
+    if (!out) {
+        perror("Failed to open output file");
+        free(vas);
+        free(pids);
+        free(writes);
+        exit(EXIT_FAILURE);
+    }
+
+    uint8_t w = forced_width ? (uint8_t)forced_width : width_for(max_va);
+    if (!to_text && width_for(max_va) > w) {
+        fprintf(stderr, "Address 0x%llx does not fit in %u bytes.\n",
+                (unsigned long long)max_va, w);
+        fclose(out);
+        free(vas);
+        free(pids);
+        free(writes);
+        exit(EXIT_FAILURE);
+    }
+
+    if (to_text) {
+        fprintf(out, "%llu\n", (unsigned long long)n);
+        for (uint64_t i = 0; i < n; i++) {
+            if (i == 0 ? pids[i] != 0 : pids[i] != pids[i - 1]) {
+                fprintf(out, "@%u\n", pids[i]);
+            }
+            bool write = (writes[i / 8] >> (i % 8)) & 1;
+            fprintf(out, "%s0x%03llx\n", write ? "W:" : "", (unsigned long long)vas[i]);
+        }
+    } else {
+        TraceHeader hdr;
+        memset(&hdr, 0, sizeof(hdr));
+        memcpy(hdr.magic, TRACE_MAGIC, sizeof(hdr.magic));
+        hdr.version = TRACE_VERSION;
+        hdr.addr_bytes = w;
+        hdr.flags = (multi ? TRACE_FLAG_PID : 0) | (any_write ? TRACE_FLAG_WRITE : 0);
+        hdr.count = n;
+        fwrite(&hdr, sizeof(hdr), 1, out);
+
+        // little-endian 호스트 가정: 하위 w 바이트를 그대로 기록
+        for (uint64_t i = 0; i < n; i++) {
+            fwrite(&vas[i], w, 1, out);
+        }
+        // pid 배열은 2-byte 정렬 위치부터
+        if ((multi || any_write) && (n * w) % 2) fputc(0, out);
+        if (multi) fwrite(pids, sizeof(uint16_t), n, out);
+        // 쓰기 비트맵은 pid 배열 뒤 (없으면 레코드 영역 뒤)
+        if (any_write) fwrite(writes, 1, (n + 7) / 8, out);
+    }
+
+    if (ferror(out)) {
+        fprintf(stderr, "File write error occurred before fclose\n");
+    }
+    fclose(out);
+    free(vas);
+    free(pids);
+    free(writes);
+
+    if (to_text) {
+        fprintf(stderr, "Converted %llu accesses: %s -> %s (text)\n",
+                (unsigned long long)n, in_path, out_path);
+    } else {
+        fprintf(stderr, "Converted %llu accesses: %s -> %s (binary, %u-byte records)\n",
+                (unsigned long long)n, in_path, out_path, w);
+    }
+    return 0;
+}